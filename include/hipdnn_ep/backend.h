@@ -0,0 +1,71 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ep_context.h"
+#include "ep_utils.h"
+#include "op.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace hipdnn_ep {
+
+/// @brief Executes the ops of compiled kernels on one kind of device.
+///
+/// Kernel does the device-independent work (matching fusion groups, building OpInfos, planning
+/// intermediates, EP context (de)serialization); a backend turns each OpInfo into an Op it can run and
+/// owns the resources those ops share. One backend serves all kernels of an EP, concurrently.
+class Backend {
+ public:
+  virtual ~Backend() = default;
+
+  /// @brief Short name recorded in EP contexts; a context only loads on the backend that wrote it
+  virtual const char* Name() const = 0;
+
+  /// @brief Identifies the device and library versions compiled state is valid for
+  virtual std::string Fingerprint() const = 0;
+
+  /// @brief Whether the backend's ops run on tensors of `type`
+  virtual bool SupportsDataType(ONNXTensorElementDataType type) const = 0;
+
+  /// @brief Channels per block of the backend's blocked layout, NC[D]HWc, which intermediates passed between
+  /// ops that support it are kept in; 0 if the backend has none and every tensor stays plain NC[D]HW
+  virtual int64_t BlockedLayoutChannels() const { return 0; }
+
+  /// @brief Whether Conv ops take constant weights and bias into their info (ConvOpInfo::constant_weights), so
+  /// they are reordered for the backend's kernels once at compile time rather than on every run
+  virtual bool OwnsConstantWeights() const { return false; }
+
+  /// @brief Compile a Conv or ConvTranspose with its fused epilogue
+  virtual OrtStatus* CompileConv(std::unique_ptr<ConvOpInfo> info, std::unique_ptr<Op>& op) = 0;
+
+  /// @brief Restore a Conv serialized by an op of this backend. `same_fingerprint` tells whether the
+  /// context was written for this device, so device-specific choices in it can be trusted.
+  virtual OrtStatus* LoadConv(std::unique_ptr<ConvOpInfo> info, ContextReader& reader, bool same_fingerprint,
+                              std::unique_ptr<Op>& op) = 0;
+
+  /// @brief Compile a MatMul or Gemm with its fused epilogue
+  virtual OrtStatus* CompileMatMul(std::unique_ptr<MatMulOpInfo> info, std::unique_ptr<Op>& op) = 0;
+
+  /// @brief Compile a pooling node
+  virtual OrtStatus* CompilePool(std::unique_ptr<PoolOpInfo> info, std::unique_ptr<Op>& op) = 0;
+
+  /// @brief Compile an elementwise node
+  virtual OrtStatus* CompilePointwise(std::unique_ptr<PointwiseOpInfo> info, std::unique_ptr<Op>& op) = 0;
+
+  /// @brief Note the scratch size a compiled kernel will ask Run for, so it can be set aside up front
+  virtual void ReserveScratch(size_t size) = 0;
+
+  /// @brief Runs the ops of one call with the execution context and the scratch memory (intermediates and
+  /// op workspace) it leased
+  using RunFn = std::function<OrtStatus*(ExecutionContext& ctx, void* scratch)>;
+
+  /// @brief Lease the per-call resources for a kernel invocation and pass them to `run`. Re-entrant:
+  /// concurrent calls get distinct resources.
+  virtual OrtStatus* Run(Ort::KernelContext& context, size_t scratch_size, const RunFn& run) = 0;
+};
+
+}  // namespace hipdnn_ep
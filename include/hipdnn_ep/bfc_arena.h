@@ -0,0 +1,148 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "ep_utils.h"
+#include <hip/hip_runtime.h>
+
+namespace hipdnn_ep {
+
+// Allocator statistics
+struct AllocatorStats {
+  int64_t num_allocs{0};
+  int64_t num_reserves{0};
+  int64_t num_arena_extensions{0};
+  int64_t bytes_in_use{0};
+  int64_t total_allocated_bytes{0};
+  int64_t max_bytes_in_use{0};
+  int64_t max_alloc_size{0};
+};
+
+/// @brief Arena tuning, read from the allocator options ORT passes to CreateAllocator.
+///
+/// Keys match ORT's OrtArenaCfg names so existing arena settings carry over:
+/// arena.extend_strategy (0 = next power of two, 1 = same as requested), arena.initial_chunk_size_bytes,
+/// arena.max_mem, arena.max_dead_bytes_per_chunk and arena.max_power_of_two_extend_bytes.
+struct ArenaConfig {
+  enum class ExtendStrategy {
+    kNextPowerOfTwo,
+    kSameAsRequested,
+  };
+
+  ExtendStrategy extend_strategy{ExtendStrategy::kNextPowerOfTwo};
+  size_t initial_chunk_size_bytes{size_t{1} << 20};
+  size_t max_mem{SIZE_MAX};
+  size_t max_dead_bytes_per_chunk{size_t{128} << 20};
+  size_t max_power_of_two_extend_bytes{size_t{1} << 30};
+
+  static OrtStatus* FromKeyValuePairs(const OrtApi& ort_api, const OrtKeyValuePairs* kvps, ArenaConfig& config);
+};
+
+/// @brief Best-fit-with-coalescing arena on top of a raw device allocator.
+///
+/// Memory is requested from the driver in large regions that are split into chunks. Freed chunks are
+/// merged with free neighbours and kept in size-class bins, so once the arena has grown to the peak
+/// working set, Alloc and Free never reach the driver again.
+///
+/// Blocks allocated on a stream are stream ordered: when such a block is freed, an event is recorded on
+/// its stream, and the block is handed out again right away only to the same stream. Other streams (and
+/// allocations without a stream) take it only once the event has completed, so reuse never needs a sync.
+class BfcArena {
+ public:
+  using RawAlloc = std::function<void*(size_t)>;
+  using RawFree = std::function<void(void*)>;
+
+  BfcArena(const ArenaConfig& config, RawAlloc raw_alloc, RawFree raw_free);
+  ~BfcArena();
+
+  BfcArena(const BfcArena&) = delete;
+  BfcArena& operator=(const BfcArena&) = delete;
+
+  /// @brief Returns a block of at least `size` bytes, or nullptr if the arena can't grow.
+  void* Alloc(size_t size);
+
+  /// @brief Like Alloc, for a block only used by work enqueued on `stream`.
+  void* AllocOnStream(size_t size, hipStream_t stream);
+
+  /// @brief Allocates an exact-size block outside the bins, for buffers that live as long as the session
+  /// (initializers). Keeps one-off large allocations from inflating the regions used for activations.
+  void* Reserve(size_t size);
+
+  void Free(void* p);
+
+  AllocatorStats GetStats() const;
+
+ private:
+  static constexpr size_t kMinAllocationBits = 8;
+  static constexpr size_t kMinAllocationSize = size_t{1} << kMinAllocationBits;
+  static constexpr size_t kNumBins = 21;
+
+  // Marks the point on `stream` after which a freed chunk is no longer touched by the GPU
+  struct Fence {
+    hipStream_t stream{nullptr};
+    hipEvent_t event{nullptr};
+    uint64_t sequence{0};  // Recording order; of two fences on one stream, the higher completes last
+  };
+
+  struct Chunk {
+    char* ptr{nullptr};
+    size_t size{0};
+    bool in_use{false};
+    bool on_stream{false};  // Allocated with AllocOnStream
+    hipStream_t stream{nullptr};
+    std::shared_ptr<Fence> fence;  // Set on free chunks with pending stream work; shared after splits
+    Chunk* prev{nullptr};  // Neighbours within the same region
+    Chunk* next{nullptr};
+  };
+
+  struct ChunkLess {
+    bool operator()(const Chunk* a, const Chunk* b) const {
+      return a->size != b->size ? a->size < b->size : a->ptr < b->ptr;
+    }
+  };
+
+  using Bin = std::set<Chunk*, ChunkLess>;
+
+  static size_t RoundedBytes(size_t size);
+  static size_t BinIndex(size_t size);
+
+  void* AllocInternal(size_t size, const hipStream_t* stream);
+  Chunk* FindChunk(size_t rounded_size, const hipStream_t* stream);
+  bool IsUsable(Chunk* chunk, const hipStream_t* stream);
+  bool IsRetired(Chunk* chunk);
+  std::shared_ptr<Fence> RecordFence(hipStream_t stream);
+  bool Extend(size_t rounded_size);
+  void SplitChunk(Chunk* chunk, size_t size);
+  void InsertFree(Chunk* chunk);
+  void RemoveFree(Chunk* chunk);
+  bool CanMerge(Chunk* chunk, Chunk* neighbour);
+  static std::shared_ptr<Fence> LaterFence(const std::shared_ptr<Fence>& a, const std::shared_ptr<Fence>& b);
+  Chunk* Merge(Chunk* chunk, Chunk* next, std::shared_ptr<Fence> fence);
+  void DeleteChunk(Chunk* chunk);
+
+  const ArenaConfig config_;
+  RawAlloc raw_alloc_;
+  RawFree raw_free_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::pair<void*, size_t>> regions_;
+  std::unordered_map<const void*, Chunk*> chunks_;  // By chunk start address
+  std::unordered_map<const void*, size_t> reserved_;
+  std::array<Bin, kNumBins> bins_;
+  std::vector<hipEvent_t> free_events_;  // Recycled fence events
+  uint64_t next_fence_sequence_{0};
+  size_t next_region_size_;
+  AllocatorStats stats_;
+};
+
+}  // namespace hipdnn_ep
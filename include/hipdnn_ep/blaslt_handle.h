@@ -0,0 +1,50 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ep_utils.h"
+
+#include <mutex>
+
+#include <hipblaslt/hipblaslt.h>
+
+// Helper to return an OrtStatus if a hipBLASLt call fails
+#define HIPBLASLT_RETURN_IF_ERROR(ort_api, call)                              \
+  do {                                                                        \
+    hipblasStatus_t _blaslt_status = (call);                                  \
+    if (_blaslt_status != HIPBLAS_STATUS_SUCCESS) {                           \
+      RETURN_ERROR(ort_api, ORT_EP_FAIL, "hipBLASLt error: " << _blaslt_status \
+                                             << " in " << #call);             \
+    }                                                                         \
+  } while (0)
+
+namespace hipdnn_ep {
+
+// Convert ONNX data type to the HIP data type hipBLASLt describes matrices with
+inline hipDataType ToHipDataType(ONNXTensorElementDataType onnx_dtype) {
+  return onnx_dtype == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16 ? HIP_R_16F : HIP_R_32F;
+}
+
+/// @brief hipBLASLt handle shared by all kernels of an EP.
+///
+/// Unlike a MIOpen handle it holds no stream or per-call state (the stream is passed to every
+/// hipblasLtMatmul), so one handle serves concurrent runs. It is created on first use, so models
+/// without MatMul/Gemm never load the library's kernels.
+class BlasLtHandle {
+ public:
+  BlasLtHandle() = default;
+  ~BlasLtHandle();
+
+  BlasLtHandle(const BlasLtHandle&) = delete;
+  BlasLtHandle& operator=(const BlasLtHandle&) = delete;
+
+  /// @brief Returns the handle, creating it on the first call.
+  hipblasStatus_t Get(hipblasLtHandle_t& handle);
+
+ private:
+  std::mutex mutex_;
+  hipblasLtHandle_t handle_{nullptr};
+};
+
+}  // namespace hipdnn_ep
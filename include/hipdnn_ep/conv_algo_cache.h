@@ -0,0 +1,65 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <miopen/miopen.h>
+
+namespace hipdnn_ep {
+
+/// @brief Shape-keyed cache of the convolution solutions picked by MIOpen Find.
+///
+/// Entries are kept in memory and, when a path is given, appended to a text file
+/// so that later processes can skip miopenFindConvolutionForwardAlgorithm entirely.
+class ConvAlgoCache {
+ public:
+  struct Entry {
+    uint64_t solution_id{0};
+    size_t workspace_size{0};
+  };
+
+  /// @param path File backing the cache. Empty disables persistence.
+  /// @param device_arch GPU architecture name (e.g. gfx942) that entries are valid for.
+  ConvAlgoCache(std::string path, std::string device_arch);
+
+  /// @brief Read entries from the backing file. Returns false if the file exists but can't be parsed.
+  bool Load();
+
+  /// @brief Builds the lookup key for a convolution problem. `transposed` selects MIOpen's transpose mode.
+  std::string MakeKey(miopenDataType_t data_type,
+                      const std::vector<int64_t>& x_shape,
+                      const std::vector<int64_t>& w_shape,
+                      const std::vector<int64_t>& y_shape,
+                      const std::vector<int64_t>& pads,
+                      const std::vector<int64_t>& strides,
+                      const std::vector<int64_t>& dilations,
+                      int64_t group,
+                      bool transposed) const;
+
+  /// @brief GPU architecture and MIOpen version that solution ids found here are valid for.
+  std::string Fingerprint() const;
+
+  bool Lookup(const std::string& key, Entry& entry) const;
+
+  /// @brief Adds or replaces an entry. Returns false if it could not be written to the backing file.
+  bool Insert(const std::string& key, const Entry& entry);
+
+  const std::string& Path() const { return path_; }
+  size_t Size() const;
+
+ private:
+  const std::string path_;
+  const std::string device_arch_;
+  std::string miopen_version_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,102 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "op.h"
+#include "conv_algo_cache.h"
+#include "pad_kernel.h"
+
+namespace hipdnn_ep {
+
+/// @brief MIOpen convolution with an optional bias + activation epilogue.
+///
+/// The epilogue runs inside the convolution through a MIOpen fusion plan when MIOpen has a fused
+/// kernel for the problem, and as separate bias/activation calls on the output otherwise. Pads that differ
+/// between the two ends of a dimension are split: MIOpen applies the symmetric part, and the excess is
+/// padded into a copy of X at the front of the workspace.
+class ConvOp : public Op {
+ public:
+  ConvOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<ConvOpInfo> info);
+  ~ConvOp() override;
+
+  /// @brief Create descriptors and compile the fused plan or the convolution solution
+  OrtStatus* Compile(miopenHandle_t miopen_handle, ConvAlgoCache& algo_cache);
+
+  /// @brief Restore the state written by Serialize without running Find. Solutions are trusted only when
+  /// `solutions_valid` (same GPU architecture and MIOpen build); otherwise they are selected again.
+  OrtStatus* Load(miopenHandle_t miopen_handle, ContextReader& reader, ConvAlgoCache& algo_cache,
+                  bool solutions_valid);
+
+  void Serialize(ContextWriter& writer) const override;
+
+  size_t WorkspaceSize() const override { return PrePadSize() + workspace_size_; }
+
+  OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                     const std::vector<void*>& outputs) const override;
+
+  /// @brief Whether the epilogue is executed by a MIOpen fusion plan
+  bool IsFused() const { return fusion_plan_ != nullptr; }
+
+ private:
+  const ConvOpInfo& ConvInfo() const { return static_cast<const ConvOpInfo&>(Info()); }
+
+  /// @brief Workspace bytes taken by the padded copy of X, aligned for the MIOpen workspace after it
+  size_t PrePadSize() const;
+
+  /// @brief Create the tensor, convolution and activation descriptors from the op info
+  OrtStatus* CreateDescriptors();
+
+  /// @brief Copy folded weights and bias (if any) to device memory owned by the op
+  OrtStatus* UploadFoldedConstants();
+
+  /// @brief Try to compile conv + bias + activation as one fusion plan; leaves fusion_plan_ null on failure
+  void CompileFusionPlan(miopenHandle_t miopen_handle);
+
+  /// @brief Select (from the cache or by Find) and compile the immediate mode solution
+  OrtStatus* CompileConvSolution(miopenHandle_t miopen_handle, ConvAlgoCache& algo_cache);
+
+  /// @brief Run MIOpen Find for the current descriptors and return the best solution
+  OrtStatus* FindConvSolution(miopenHandle_t miopen_handle, ConvAlgoCache::Entry& entry);
+
+  OrtStatus* ExecuteFused(const ExecutionContext& ctx, const void* x, const void* w, const void* b, void* y) const;
+  OrtStatus* ExecuteUnfused(const ExecutionContext& ctx, const void* x, const void* w, const void* b, void* y) const;
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+
+  miopenDataType_t data_type_{miopenFloat};
+
+  // Convolution descriptors
+  miopenTensorDescriptor_t x_desc_{nullptr};  // Input
+  miopenTensorDescriptor_t w_desc_{nullptr};  // Weights
+  miopenTensorDescriptor_t y_desc_{nullptr};  // Output
+  miopenTensorDescriptor_t b_desc_{nullptr};  // Bias (optional)
+  miopenConvolutionDescriptor_t conv_desc_{nullptr};
+
+  // Padding of X beyond the symmetric pads of conv_desc_ (count 0 when the pads are symmetric)
+  PadParams pre_pad_{};
+
+  // Activation epilogue (optional)
+  miopenActivationDescriptor_t activation_desc_{nullptr};
+  miopenActivationMode_t activation_mode_{miopenActivationPASTHRU};
+  double activation_alpha_{0.0};
+  double activation_beta_{0.0};
+  double activation_gamma_{0.0};
+
+  // Fusion plan; the op descriptors are owned by the plan
+  miopenFusionPlanDescriptor_t fusion_plan_{nullptr};
+  miopenFusionOpDescriptor_t conv_fusion_op_{nullptr};
+  miopenFusionOpDescriptor_t bias_fusion_op_{nullptr};
+  miopenFusionOpDescriptor_t activation_fusion_op_{nullptr};
+
+  // Folded weights and bias in the op's data type (optional), used in place of the W and B inputs
+  void* folded_w_{nullptr};
+  void* folded_b_{nullptr};
+
+  // Convolution solution (immediate mode) and the workspace it borrows from the arena
+  uint64_t solution_id_{0};
+  size_t workspace_size_{0};
+};
+
+}  // namespace hipdnn_ep
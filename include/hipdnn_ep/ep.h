@@ -8,18 +8,26 @@
 #include <unordered_map>
 
 #include "ep_utils.h"
+#include "backend.h"
 
 namespace hipdnn_ep {
 
 class HipDNNEpFactory;
+class SessionStream;
 struct Kernel;
 
-/// @brief MIOpen-based Execution Provider implementation
+/// @brief MIOpen-based Execution Provider implementation. Kernels run on a GPU backend, or on a host backend
+/// when the EP is created for the CPU device registered in the absence of a GPU.
 class HipDNNEp : public OrtEp, public ApiPtrs {
  public:
   struct Config {
     bool enable_ep_context{false};
-    // Additional configuration options
+    // File used to persist convolution algorithm choices across sessions (empty = in-memory only)
+    std::string conv_algo_cache_path;
+    // Run kernels on the host CPU instead of the GPU
+    bool host_backend{false};
+    // Threads of the host backend, including the calling thread (0 = one per hardware thread)
+    size_t host_threads{0};
   };
 
   HipDNNEp(HipDNNEpFactory& factory, const Config& config, const OrtLogger& logger);
@@ -70,7 +78,13 @@ class HipDNNEp : public OrtEp, public ApiPtrs {
   Config config_;
   const OrtLogger& logger_;
 
-  // Compiled kernels (each Kernel manages its own MIOpen handle)
+  // Stream the GPU backend compiles on, lent to the first stream ORT creates for the session (GPU only)
+  std::shared_ptr<SessionStream> session_stream_;
+
+  // Device the kernels of this EP compile for and run on, with the resources they share
+  std::unique_ptr<Backend> backend_;
+
+  // Compiled kernels
   std::unordered_map<std::string, std::unique_ptr<Kernel>> kernels_;
 };
 
@@ -3,22 +3,13 @@
 
 #pragma once
 
+#include "bfc_arena.h"
 #include "ep_utils.h"
 #include <hip/hip_runtime.h>
-#include <mutex>
-#include <unordered_map>
+#include <memory>
 
 namespace hipdnn_ep {
 
-// Allocator statistics
-struct AllocatorStats {
-  int64_t num_allocs{0};
-  int64_t bytes_in_use{0};
-  int64_t total_allocated_bytes{0};
-  int64_t max_bytes_in_use{0};
-  int64_t max_alloc_size{0};
-};
-
 // Base allocator with virtual destructor for proper cleanup
 struct BaseAllocator : OrtAllocator {
   virtual ~BaseAllocator() = default;
@@ -26,11 +17,15 @@ struct BaseAllocator : OrtAllocator {
 
 using AllocatorUniquePtr = std::unique_ptr<BaseAllocator>;
 
-// HIP device memory allocator
+// HIP device memory allocator. Allocations are served from a BfcArena so steady-state inference
+// never calls hipMalloc/hipFree, which implicitly synchronize the device.
 struct HipDeviceAllocator : BaseAllocator {
-  HipDeviceAllocator(const OrtMemoryInfo* mem_info, const ApiPtrs& api_ptrs, int device_id);
+  HipDeviceAllocator(const OrtMemoryInfo* mem_info, const ApiPtrs& api_ptrs, const OrtLogger& logger, int device_id,
+                     const ArenaConfig& arena_config);
 
   static void* ORT_API_CALL AllocImpl(struct OrtAllocator* this_, size_t size);
+  static void* ORT_API_CALL ReserveImpl(struct OrtAllocator* this_, size_t size);
+  static void* ORT_API_CALL AllocOnStreamImpl(struct OrtAllocator* this_, size_t size, OrtSyncStream* stream);
   static void ORT_API_CALL FreeImpl(struct OrtAllocator* this_, void* p);
   static const struct OrtMemoryInfo* ORT_API_CALL InfoImpl(const struct OrtAllocator* this_);
   static OrtStatus* ORT_API_CALL GetStatsImpl(const struct OrtAllocator* this_, OrtKeyValuePairs** out) noexcept;
@@ -38,10 +33,9 @@ struct HipDeviceAllocator : BaseAllocator {
  private:
   const OrtMemoryInfo* memory_info_;
   const ApiPtrs api_ptrs_;
+  const OrtLogger& logger_;
   int device_id_;
-  mutable std::mutex mutex_;
-  std::unordered_map<void*, size_t> allocation_sizes_;
-  AllocatorStats stats_;
+  std::unique_ptr<BfcArena> arena_;
 };
 
 }  // namespace hipdnn_ep
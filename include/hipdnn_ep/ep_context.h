@@ -0,0 +1,60 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ep_utils.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace hipdnn_ep {
+
+// Op type and domain of the nodes that carry a pre-compiled partition in an EP context model
+constexpr const char* kEpContextOpType = "EPContext";
+constexpr const char* kEpContextDomain = "com.microsoft";
+
+/// @brief Writes compiled kernel state as a stream of space-separated tokens.
+/// Strings are length-prefixed so names may contain any character.
+class ContextWriter {
+ public:
+  ContextWriter& Write(int64_t value);
+  ContextWriter& Write(uint64_t value);
+  ContextWriter& Write(float value);  // Bit pattern, so the value round-trips exactly
+  ContextWriter& Write(const std::string& value);
+  ContextWriter& Write(const std::vector<int64_t>& values);
+  ContextWriter& Write(const std::vector<float>& values);
+
+  std::string Str() const { return oss_.str(); }
+
+ private:
+  std::ostringstream oss_;
+};
+
+/// @brief Reads what ContextWriter wrote. Every Read returns false once the data is exhausted or malformed.
+class ContextReader {
+ public:
+  explicit ContextReader(const std::string& data) : iss_(data) {}
+
+  bool Read(int64_t& value);
+  bool Read(uint64_t& value);
+  bool Read(float& value);
+  bool Read(std::string& value);
+  bool Read(std::vector<int64_t>& values);
+  bool Read(std::vector<float>& values);
+
+ private:
+  std::istringstream iss_;
+};
+
+/// @brief Whether `node` is an EPContext node produced by the EP named `ep_name`
+bool IsEpContextNode(Ort::ConstNode node, const std::string& ep_name);
+
+/// @brief Create the EPContext node replacing `fused_node` in an exported model. `context` is embedded
+/// in the node's ep_cache_context attribute.
+OrtStatus* CreateEpContextNode(const ApiPtrs& apis, Ort::ConstNode fused_node, const std::string& ep_name,
+                               const std::string& context, OrtNode** ep_context_node);
+
+}  // namespace hipdnn_ep
@@ -4,13 +4,16 @@
 #pragma once
 
 #include "ep_utils.h"
+#include "pinned_buffer_pool.h"
 #include <hip/hip_runtime.h>
 
+#include <vector>
+
 namespace hipdnn_ep {
 
 // Data transfer implementation for CPU <-> HIP device copies
 struct HipDataTransfer : OrtDataTransferImpl, ApiPtrs {
-  HipDataTransfer(ApiPtrs api_ptrs, const OrtMemoryDevice* device_mem_info, int device_id);
+  HipDataTransfer(ApiPtrs api_ptrs, const OrtLogger& logger, const OrtMemoryDevice* device_mem_info, int device_id);
 
   static bool ORT_API_CALL CanCopyImpl(const OrtDataTransferImpl* this_ptr,
                                        const OrtMemoryDevice* src_memory_device,
@@ -25,8 +28,22 @@ struct HipDataTransfer : OrtDataTransferImpl, ApiPtrs {
   static void ORT_API_CALL ReleaseImpl(OrtDataTransferImpl* this_ptr) noexcept;
 
  private:
+  // Device-to-host copy staged through a pinned buffer; `dst` is filled once its stream is synchronized
+  struct PendingHostCopy {
+    void* dst;
+    PinnedBufferPool::Buffer staging;
+    size_t byte_size;
+    hipStream_t stream;
+  };
+
+  // Enqueue one tensor copy on `stream` (the null stream if there is none)
+  OrtStatus* EnqueueCopy(const OrtValue* src_value, OrtValue* dst_value, hipStream_t stream,
+                         std::vector<PendingHostCopy>& pending_host_copies);
+
+  const OrtLogger& logger_;
   const OrtMemoryDevice* device_mem_info_;
   int device_id_;
+  PinnedBufferPool staging_pool_;  // Bounce buffers for pageable host memory
 };
 
 }  // namespace hipdnn_ep
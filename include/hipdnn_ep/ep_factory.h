@@ -14,6 +14,7 @@
 namespace hipdnn_ep {
 
 class HipDNNEp;  // Forward declaration
+class SessionStream;
 
 /// @brief Factory for creating hipDNN Execution Provider instances
 class HipDNNEpFactory : public OrtEpFactory, public ApiPtrs {
@@ -24,8 +25,15 @@ class HipDNNEpFactory : public OrtEpFactory, public ApiPtrs {
   // Accessors
   HipDataTransfer* GetDataTransfer() const { return data_transfer_impl_.get(); }
   int GetDeviceId() const { return device_id_; }
+  const OrtLogger& GetLogger() const { return default_logger_; }
+  const std::string& GetDeviceArch() const { return device_arch_; }
   OrtKernelRegistry* GetKernelRegistry() const { return kernel_registry_; }
 
+  /// @brief Create a HipSyncStream for `memory_device` (nullptr if it is not this factory's GPU). It borrows
+  /// `session_stream` when given and not held by another HipSyncStream, and gets a stream of its own otherwise.
+  OrtStatus* CreateSyncStream(const OrtMemoryDevice* memory_device, OrtSyncStreamImpl** stream,
+                              const std::shared_ptr<SessionStream>& session_stream = nullptr);
+
  private:
   // OrtEpFactory interface implementations
   static const char* ORT_API_CALL GetNameImpl(const OrtEpFactory* this_ptr) noexcept;
@@ -80,6 +88,7 @@ class HipDNNEpFactory : public OrtEpFactory, public ApiPtrs {
   const std::string ep_version_{"0.1.0"};
 
   int device_id_{0};
+  std::string device_arch_;  // e.g. gfx942, empty when no GPU is present
 
   // Memory info for device memory
   Ort::MemoryInfo default_memory_info_;
@@ -0,0 +1,89 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ep_utils.h"
+#include <hip/hip_runtime.h>
+
+#include <atomic>
+#include <memory>
+
+namespace hipdnn_ep {
+
+/// @brief Non-blocking stream an EP keeps for its whole session.
+///
+/// Kernels are compiled on it, and it backs the first HipSyncStream ORT asks the EP for, so runs on that
+/// stream lease the same MIOpen handle that compilation prepared. Only one HipSyncStream holds it at a time.
+class SessionStream {
+ public:
+  /// @brief Create a stream on `device_id`
+  static OrtStatus* Create(const OrtApi& ort_api, int device_id, std::shared_ptr<SessionStream>& stream);
+
+  ~SessionStream();
+
+  SessionStream(const SessionStream&) = delete;
+  SessionStream& operator=(const SessionStream&) = delete;
+
+  hipStream_t Get() const { return stream_; }
+
+  /// @brief Claims the stream for one HipSyncStream; false while another one holds it
+  bool TryLend() { return !lent_.exchange(true); }
+  void Return() { lent_ = false; }
+
+ private:
+  explicit SessionStream(hipStream_t stream) : stream_(stream) {}
+
+  hipStream_t stream_;
+  std::atomic<bool> lent_{false};
+};
+
+/// @brief ORT stream wrapping a non-blocking hipStream_t.
+///
+/// Kernels, memcpy nodes and data transfers are issued onto this stream so ORT can keep scheduling
+/// on the host while the GPU works; cross-stream dependencies are expressed with HipSyncNotification.
+struct HipSyncStream : OrtSyncStreamImpl, ApiPtrs {
+  /// @brief Create a stream on `device_id`
+  static OrtStatus* Create(ApiPtrs api_ptrs, int device_id, OrtSyncStreamImpl** stream);
+
+  /// @brief Wrap `session_stream`, which the caller has claimed with TryLend; it is returned on release
+  static OrtSyncStreamImpl* Borrow(ApiPtrs api_ptrs, std::shared_ptr<SessionStream> session_stream);
+
+  ~HipSyncStream();
+
+  hipStream_t GetStream() const { return stream_; }
+
+ private:
+  HipSyncStream(ApiPtrs api_ptrs, hipStream_t stream, std::shared_ptr<SessionStream> session_stream = nullptr);
+
+  static void ORT_API_CALL ReleaseImpl(OrtSyncStreamImpl* this_ptr) noexcept;
+  static void* ORT_API_CALL GetHandleImpl(OrtSyncStreamImpl* this_ptr) noexcept;
+  static OrtStatus* ORT_API_CALL CreateNotificationImpl(OrtSyncStreamImpl* this_ptr,
+                                                        OrtSyncNotificationImpl** notification) noexcept;
+  static OrtStatus* ORT_API_CALL FlushImpl(OrtSyncStreamImpl* this_ptr) noexcept;
+  static OrtStatus* ORT_API_CALL OnSessionRunEndImpl(OrtSyncStreamImpl* this_ptr) noexcept;
+
+  hipStream_t stream_;
+  std::shared_ptr<SessionStream> session_stream_;  // Set when stream_ is borrowed rather than owned
+};
+
+/// @brief Event recorded on a HipSyncStream that other streams or the host can wait on
+struct HipSyncNotification : OrtSyncNotificationImpl, ApiPtrs {
+  HipSyncNotification(ApiPtrs api_ptrs, hipStream_t stream, hipEvent_t event);
+  ~HipSyncNotification();
+
+ private:
+  static void ORT_API_CALL ReleaseImpl(OrtSyncNotificationImpl* this_ptr) noexcept;
+  static OrtStatus* ORT_API_CALL ActivateImpl(OrtSyncNotificationImpl* this_ptr) noexcept;
+  static OrtStatus* ORT_API_CALL WaitOnDeviceImpl(OrtSyncNotificationImpl* this_ptr,
+                                                  OrtSyncStream* consumer_stream) noexcept;
+  static OrtStatus* ORT_API_CALL WaitOnHostImpl(OrtSyncNotificationImpl* this_ptr) noexcept;
+
+  hipStream_t stream_;  // Producer stream the event is recorded on
+  hipEvent_t event_;
+};
+
+/// @brief Returns the hipStream_t behind an ORT stream, or the null stream if there is none
+hipStream_t GetHipStream(const OrtApi& ort_api, OrtSyncStream* stream);
+
+}  // namespace hipdnn_ep
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <optional>
 #include <sstream>
@@ -66,15 +67,45 @@ struct ApiPtrs {
   const OrtModelEditorApi& model_editor_api;
 };
 
+// Lowest severity any logger handed to the EP emits. Messages below it are skipped before they are
+// formatted, so a disabled LOG costs a single branch. ORT still filters per logger. Starts at ORT's default
+// severity so warnings and errors logged before a logger is known are not lost.
+inline std::atomic<int> g_min_log_severity{ORT_LOGGING_LEVEL_WARNING};
+
+// Lowers g_min_log_severity to the severity of `logger`
+inline void UpdateMinLogSeverity(const OrtApi& api, const OrtLogger& logger) {
+  OrtLoggingLevel level = ORT_LOGGING_LEVEL_VERBOSE;
+  Ort::Status status{api.Logger_GetLoggingSeverityLevel(&logger, &level)};
+  if (!status.IsOK()) {
+    level = ORT_LOGGING_LEVEL_VERBOSE;
+  }
+
+  int current = g_min_log_severity.load(std::memory_order_relaxed);
+  while (level < current && !g_min_log_severity.compare_exchange_weak(current, level, std::memory_order_relaxed)) {
+  }
+}
+
 // Logging macro (requires 'api_' and 'logger_' in scope)
-#define LOG(api, logger, level, ...)                                                              \
-  do {                                                                                            \
-    std::ostringstream ss;                                                                        \
-    ss << __VA_ARGS__;                                                                            \
-    IGNORE_ORTSTATUS((api).Logger_LogMessage(&(logger), ORT_LOGGING_LEVEL_##level,                \
-                                             ss.str().c_str(), EP_FILE, __LINE__, __FUNCTION__)); \
+#define LOG(api, logger, level, ...)                                                                  \
+  do {                                                                                                \
+    if (ORT_LOGGING_LEVEL_##level >= ::hipdnn_ep::g_min_log_severity.load(std::memory_order_relaxed)) { \
+      std::ostringstream ss;                                                                          \
+      ss << __VA_ARGS__;                                                                              \
+      IGNORE_ORTSTATUS((api).Logger_LogMessage(&(logger), ORT_LOGGING_LEVEL_##level,                  \
+                                               ss.str().c_str(), EP_FILE, __LINE__, __FUNCTION__));   \
+    }                                                                                                 \
   } while (false)
 
+// Per-call logging on hot paths (copies, allocations, kernel launches). Logged at VERBOSE, and compiled
+// out entirely when HIPDNN_EP_STRIP_TRACE_LOGGING is defined.
+#ifdef HIPDNN_EP_STRIP_TRACE_LOGGING
+#define TRACE(api, logger, ...) \
+  do {                          \
+  } while (false)
+#else
+#define TRACE(api, logger, ...) LOG(api, logger, VERBOSE, __VA_ARGS__)
+#endif
+
 #define RETURN_ERROR(api, code, ...)                   \
   do {                                                 \
     std::ostringstream ss;                             \
@@ -149,4 +180,15 @@ int64_t GetIntAttrOrDefault(Ort::ConstNode node, const char* name, int64_t defau
 std::vector<int64_t> GetIntsAttrOrDefault(Ort::ConstNode node, const char* name,
                                           const std::vector<int64_t>& default_val);
 
+// Helper to get a float attribute with a default value
+float GetFloatAttrOrDefault(Ort::ConstNode node, const char* name, float default_val);
+
+// Reads a single-element float or float16 constant initializer. Returns false if `value_info`
+// is not a constant initializer of that kind.
+bool GetScalarInitializerValue(Ort::ConstValueInfo value_info, float& value);
+
+// Reads a float or float16 constant initializer as floats, in row-major order. Returns false if
+// `value_info` is not a constant initializer of that kind.
+bool GetInitializerValues(Ort::ConstValueInfo value_info, std::vector<float>& values);
+
 }  // namespace hipdnn_ep
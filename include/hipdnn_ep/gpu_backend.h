@@ -0,0 +1,61 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "backend.h"
+#include "blaslt_handle.h"
+#include "conv_algo_cache.h"
+#include "miopen_handle_pool.h"
+#include "workspace_arena.h"
+
+#include <memory>
+#include <string>
+
+namespace hipdnn_ep {
+
+/// @brief Runs kernels on the GPU through MIOpen, hipBLASLt and the HIP pointwise kernel
+class GpuBackend : public Backend {
+ public:
+  /// @brief `conv_algo_cache_path` persists convolution solutions across sessions (empty = in-memory only).
+  /// Ops are compiled with a MIOpen handle bound to `compile_stream`, the session's stream, so runs on that
+  /// stream reuse the handle that already holds the compiled solutions.
+  GpuBackend(const OrtApi& ort_api, const OrtLogger& logger, const std::string& conv_algo_cache_path,
+             const std::string& device_arch, hipStream_t compile_stream);
+
+  const char* Name() const override { return "gpu"; }
+  std::string Fingerprint() const override;
+  bool SupportsDataType(ONNXTensorElementDataType type) const override;
+
+  OrtStatus* CompileConv(std::unique_ptr<ConvOpInfo> info, std::unique_ptr<Op>& op) override;
+  OrtStatus* LoadConv(std::unique_ptr<ConvOpInfo> info, ContextReader& reader, bool same_fingerprint,
+                      std::unique_ptr<Op>& op) override;
+  OrtStatus* CompileMatMul(std::unique_ptr<MatMulOpInfo> info, std::unique_ptr<Op>& op) override;
+  OrtStatus* CompilePool(std::unique_ptr<PoolOpInfo> info, std::unique_ptr<Op>& op) override;
+  OrtStatus* CompilePointwise(std::unique_ptr<PointwiseOpInfo> info, std::unique_ptr<Op>& op) override;
+
+  void ReserveScratch(size_t size) override { workspace_arena_.Reserve(size); }
+
+  /// @brief Work is enqueued on ORT's stream for the node, with a MIOpen handle and arena scratch
+  /// memory leased for that stream
+  OrtStatus* Run(Ort::KernelContext& context, size_t scratch_size, const RunFn& run) override;
+
+ private:
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+  hipStream_t compile_stream_;
+
+  // Convolution solutions found so far, shared by all kernels of the EP
+  std::unique_ptr<ConvAlgoCache> conv_algo_cache_;
+
+  // Scratch memory borrowed by kernels during execution, one buffer per stream
+  WorkspaceArena workspace_arena_;
+
+  // MIOpen handles borrowed by kernels, one per concurrently executing stream/thread
+  MIOpenHandlePool handle_pool_;
+
+  // hipBLASLt handle used by every MatMul/Gemm op
+  BlasLtHandle blaslt_handle_;
+};
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,74 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "backend.h"
+#include "thread_pool.h"
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace hipdnn_ep {
+
+/// @brief Runs kernels on the host CPU, for the CPU device the EP registers when no GPU is present.
+///
+/// Executes the same compiled partitions as the GPU backend (same fusion groups and memory plan) with
+/// multi-threaded float implementations of each op, so the EP can be exercised and benchmarked on machines
+/// without a GPU. Tensors live in host memory and every call runs synchronously. Intermediates between ops that
+/// support it are kept channel-blocked, so a chain of convolutions, pooling and pointwise ops converts from and
+/// to NC[D]HW only at the partition's boundaries, inside its first and last ops.
+class HostBackend : public Backend {
+ public:
+  /// @brief `num_threads` counts the calling thread; 0 uses one thread per hardware thread
+  HostBackend(const OrtApi& ort_api, const OrtLogger& logger, size_t num_threads);
+
+  const char* Name() const override { return "host"; }
+  std::string Fingerprint() const override { return "host"; }
+  bool SupportsDataType(ONNXTensorElementDataType type) const override;
+
+  /// @brief NC[D]HW16c (kHostBlockChannels) whatever the ISA
+  int64_t BlockedLayoutChannels() const override;
+  bool OwnsConstantWeights() const override { return true; }
+
+  OrtStatus* CompileConv(std::unique_ptr<ConvOpInfo> info, std::unique_ptr<Op>& op) override;
+  OrtStatus* LoadConv(std::unique_ptr<ConvOpInfo> info, ContextReader& reader, bool same_fingerprint,
+                      std::unique_ptr<Op>& op) override;
+  OrtStatus* CompileMatMul(std::unique_ptr<MatMulOpInfo> info, std::unique_ptr<Op>& op) override;
+  OrtStatus* CompilePool(std::unique_ptr<PoolOpInfo> info, std::unique_ptr<Op>& op) override;
+  OrtStatus* CompilePointwise(std::unique_ptr<PointwiseOpInfo> info, std::unique_ptr<Op>& op) override;
+
+  void ReserveScratch(size_t size) override;
+
+  /// @brief Runs with a scratch buffer from the backend's free list; ops ignore the handle and stream
+  OrtStatus* Run(Ort::KernelContext& context, size_t scratch_size, const RunFn& run) override;
+
+ private:
+  struct AlignedDelete {
+    void operator()(char* ptr) const;
+  };
+  using ScratchPtr = std::unique_ptr<char, AlignedDelete>;
+
+  struct ScratchBuffer {
+    ScratchPtr data;
+    size_t size{0};
+  };
+
+  /// @brief Take a free buffer of at least `size` bytes, or allocate one
+  ScratchBuffer AcquireScratch(size_t size);
+  void ReleaseScratch(ScratchBuffer buffer);
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+
+  ThreadPool thread_pool_;
+
+  // Scratch buffers not leased by a running call; as many as calls have overlapped
+  std::mutex scratch_mutex_;
+  std::vector<ScratchBuffer> free_scratch_;
+  size_t reserved_size_{0};
+};
+
+}  // namespace hipdnn_ep
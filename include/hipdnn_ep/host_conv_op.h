@@ -0,0 +1,160 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "host_depthwise.h"
+#include "host_gemm.h"
+#include "host_layout.h"
+#include "op.h"
+#include "thread_pool.h"
+
+#include <array>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace hipdnn_ep {
+
+/// @brief How a HostConvOp computes its convolution
+enum class HostConvAlgo {
+  kDirect,
+  kGemm,
+  kWinograd,
+  kDepthwise,
+};
+
+/// @brief Choices that replace the ones HostConvOp::Compile makes, for tests and benchmarks
+struct HostConvOverrides {
+  std::optional<HostConvAlgo> algo;  // Must apply to the problem, or Compile fails
+  const GemmMicroKernel* gemm{nullptr};
+  const DepthwiseKernel* depthwise{nullptr};
+};
+
+/// @brief Conv and ConvTranspose on the host, with the bias and activation epilogue applied while the
+/// outputs are still in cache. Float NC[D]HW only; 1D and 2D problems run as 3D with unit dims.
+///
+/// A Conv with more than one channel per group runs as a GEMM per image and group, W [C_out, C_in * k] times
+/// the im2col matrix [C_in * k, spatial], on the widest micro-kernel the CPU supports. The im2col matrix is
+/// never materialized: each tile of output positions is packed straight from the input into micro-kernel
+/// panels. A 2D 3x3 stride-1 Conv runs as Winograd F(4x4, 3x3) instead when the cost model favors it: 36
+/// GEMMs of [C_out, C_in] by [C_in, 4x4 tiles] on the same micro-kernels, a quarter of the multiplies.
+///
+/// A 1D or 2D depthwise Conv (group == C_in == C_out) runs on a channel-blocked (NCHWc) stencil kernel, a
+/// block of channels per SIMD register: each task packs the input rows of a strip of outputs into blocks, runs
+/// the kernel row by row with bias and activation, and unpacks the outputs. 3D depthwise convolutions and
+/// ConvTranspose use direct loops.
+///
+/// Except on direct loops, X and Y may each be in the blocked layout (NC[D]HW16c): the GEMM and Winograd paths
+/// gather and scatter through it, and the depthwise path copies blocked input rows as they are and writes
+/// blocked outputs in place instead of unpacking them.
+class HostConvOp : public Op {
+ public:
+  HostConvOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<ConvOpInfo> info,
+             ThreadPool& thread_pool);
+
+  /// @brief Resolve the 3D geometry and, for every kernel tap, the range of positions it contributes to, and
+  /// pick the algorithm. Constant weights of a GEMM, Winograd or depthwise convolution are packed here.
+  OrtStatus* Compile(const HostConvOverrides& overrides = {});
+
+  /// @brief The algorithm picked by Compile
+  HostConvAlgo GetAlgo() const { return algo_; }
+
+  /// @brief Packed weights, for a GEMM, Winograd or depthwise convolution whose weights are only known at run
+  /// time
+  size_t WorkspaceSize() const override;
+
+  /// @brief X and Y independently, except on direct loops
+  BlockedLayoutSupport SupportsBlockedLayout() const override;
+  void UseBlockedLayout(bool input, bool output) override;
+
+  OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                     const std::vector<void*>& outputs) const override;
+
+ private:
+  using Algo = HostConvAlgo;
+
+  const ConvOpInfo& ConvInfo() const { return static_cast<const ConvOpInfo&>(Info()); }
+
+  /// @brief Whether `algo` can compute this convolution: direct loops always, the others only forward.
+  /// Winograd needs a 2D 3x3 stride-1 undilated kernel, and depthwise a 1D or 2D depthwise convolution.
+  bool AlgoApplies(Algo algo) const;
+
+  /// @brief Depthwise for 1D and 2D depthwise convolutions, and direct for the rest of them and ConvTranspose.
+  /// Otherwise Winograd for qualifying shapes when it needs fewer multiply-adds than the GEMM, counting the
+  /// transforms and the padding of partial micro-kernel panels, and GEMM when it does not.
+  Algo SelectAlgo() const;
+
+  /// @brief Computes output plane `plane` (n * C_out + c) of a Conv
+  void RunForwardPlane(int64_t plane, const float* x, const float* w, const float* bias, float* y) const;
+
+  /// @brief Computes output plane `plane` of a ConvTranspose by scattering the input planes into it
+  void RunTransposedPlane(int64_t plane, const float* x, const float* w, const float* bias, float* y) const;
+
+  /// @brief Packs W into micro-kernel panels, group by group. For Winograd each 3x3 filter is transformed to
+  /// 6x6 first, and each of the 36 transformed positions gets its own [C_out, C_in] panels. For depthwise, W
+  /// and the bias (zeros without one) are packed per channel block as [kernel taps + 1][kHostBlockChannels].
+  void PackWeights(const float* w, const float* bias, float* packed) const;
+
+  /// @brief Packs rows [k0, k0 + kc) and columns [col0, col0 + cols) of the im2col matrix of the group
+  /// starting at channel `c0` of `x_image` (one image) into `nr`-wide panels, zero padding the last one
+  void PackInputTile(const float* x_image, int64_t c0, int64_t k0, int64_t kc, int64_t col0, int64_t cols,
+                     float* packed) const;
+
+  /// @brief Computes GEMM task `task`: one tile of output positions for a range of output channels
+  void RunGemmTask(int64_t task, const float* x, const float* packed_w, const float* bias, float* y) const;
+
+  /// @brief Computes Winograd task `task`: a block of 4x4 output tiles for a range of output channels
+  void RunWinogradTask(int64_t task, const float* x, const float* packed_w, const float* bias, float* y) const;
+
+  /// @brief Computes depthwise task `task`: a strip of output rows of one image and channel block
+  void RunDepthwiseTask(int64_t task, const float* x, const float* packed_w, float* y) const;
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+  ThreadPool& thread_pool_;
+
+  int64_t c_in_{0};
+  int64_t c_out_{0};
+  std::array<int64_t, 3> x_dims_{};
+  std::array<int64_t, 3> y_dims_{};
+  std::array<int64_t, 3> k_dims_{};
+  std::array<int64_t, 3> strides_{};
+  std::array<int64_t, 3> dilations_{};
+  std::array<int64_t, 3> pads_{};  // Begin pads; the end pads are implied by y_dims_
+  HostImageLayout x_layout_;
+  HostImageLayout y_layout_;
+
+  // Per spatial dim and kernel tap: [begin, end) of the positions the tap reads from inside the input. These
+  // are output positions for a Conv and input positions for a ConvTranspose.
+  std::array<std::vector<std::pair<int64_t, int64_t>>, 3> tap_ranges_;
+
+  Algo algo_{Algo::kDirect};
+  int64_t tasks_{0};        // ParallelFor tasks of a GEMM, Winograd or depthwise run
+  int64_t packed_size_{0};  // Floats of packed weights, 0 for direct loops
+  std::vector<float> packed_weights_;  // Constant weights, packed (and transformed) at compile time
+
+  // GEMM and Winograd. Each task covers block_cols_ columns (output positions for GEMM, 4x4 output tiles for
+  // Winograd; a multiple of the micro-kernel's nr) of one image and group, for one of m_splits_ ranges of its
+  // output channels. Splitting the channels gives small problems enough tasks for the pool, and bounds the
+  // Winograd accumulators.
+  const GemmMicroKernel* gemm_{nullptr};
+  int64_t gemm_k_{0};  // C_in / group * kernel size for GEMM, C_in / group for Winograd
+  int64_t gemm_kc_{0};
+  int64_t packed_group_size_{0};
+  int64_t block_cols_{0};
+  int64_t blocks_{0};
+  int64_t m_splits_{1};
+  int64_t winograd_tiles_w_{0};
+  int64_t winograd_tiles_{0};
+
+  // Depthwise. Each task covers depthwise_rows_ output rows of one image and block of kHostBlockChannels
+  // channels, from packed input rows depthwise_x_cols_ positions wide.
+  const DepthwiseKernel* depthwise_{nullptr};
+  int64_t channel_blocks_{0};
+  int64_t depthwise_x_cols_{0};
+  int64_t depthwise_rows_{0};
+  int64_t depthwise_strips_{0};
+};
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,59 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace hipdnn_ep {
+
+/// @brief One output row of a depthwise convolution on channel-blocked (NCHWc) data: `lanes` channels, one per
+/// SIMD lane, with the values of a position contiguous. Positions are `position_stride` floats apart in x, the
+/// weights and y, so a kernel covers a wider block of channels in several calls.
+struct DepthwiseRowArgs {
+  /// Input window of the row: `kh` rows `dilation_h * x_row_stride` floats apart, each starting at the first
+  /// column output 0 reads. Padding is materialized, so every column a tap reads is inside the row.
+  const float* x;
+  int64_t x_row_stride;
+  /// Weights [kh][kw][position_stride] and bias [lanes]
+  const float* w;
+  const float* bias;
+  /// Output [width][position_stride]
+  float* y;
+  int64_t position_stride;
+  int64_t width;
+  int64_t kh;
+  int64_t kw;
+  int64_t stride_w;
+  int64_t dilation_h;
+  int64_t dilation_w;
+  /// Outputs are clamped to [lower, upper], which fuses Relu and Clip; +-infinity for no clamp
+  float lower;
+  float upper;
+};
+
+/// @brief A depthwise-convolution row kernel of the host backend. The output is bias plus the weighted taps,
+/// clamped; the caller applies any other activation.
+struct DepthwiseKernel {
+  using Fn = void (*)(const DepthwiseRowArgs& args);
+
+  const char* isa;
+  int64_t lanes;
+  Fn fn;
+};
+
+/// @brief Every depthwise kernel the CPU supports, widest first and ending with the portable one; found on first
+/// use. Their lanes divide kHostBlockChannels.
+const std::vector<DepthwiseKernel>& GetDepthwiseKernels();
+
+/// @brief The widest depthwise kernel the CPU supports, the first of GetDepthwiseKernels()
+const DepthwiseKernel& GetDepthwiseKernel();
+
+#if defined(HIPDNN_EP_HOST_X86)
+// ISA-specific kernels, built with their own target flags and only called when the CPU supports them
+void DepthwiseRowAvx2(const DepthwiseRowArgs& args);
+void DepthwiseRowAvx512(const DepthwiseRowArgs& args);
+#endif
+
+}  // namespace hipdnn_ep
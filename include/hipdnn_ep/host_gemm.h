@@ -0,0 +1,50 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hipdnn_ep {
+
+/// @brief A register-blocked GEMM micro-kernel of the host backend.
+///
+/// Computes one `mr` x `nr` block of C from packed panels: A as `kc` steps of `mr` row values, B as `kc`
+/// steps of `nr` column values, both zero padded to the full panel width. With `accumulate` the product is
+/// added to C, otherwise it overwrites it. The whole block is always read and written.
+struct GemmMicroKernel {
+  using Fn = void (*)(int64_t kc, const float* a, const float* b, float* c, int64_t ldc, bool accumulate);
+
+  const char* isa;
+  int64_t mr;
+  int64_t nr;
+  Fn fn;
+};
+
+/// @brief Largest mr and nr of any micro-kernel, for stack buffers holding one block
+constexpr int64_t kGemmMaxMr = 12;
+constexpr int64_t kGemmMaxNr = 32;
+
+/// @brief Every micro-kernel the CPU supports, widest first and ending with the portable one; found on first use
+const std::vector<GemmMicroKernel>& GetGemmMicroKernels();
+
+/// @brief The widest micro-kernel the CPU supports, the first of GetGemmMicroKernels()
+const GemmMicroKernel& GetGemmMicroKernel();
+
+/// @brief Floats taken by `m` x `k` row-major A packed into zero-padded panels of `kernel.mr` rows
+size_t PackedGemmASize(const GemmMicroKernel& kernel, int64_t m, int64_t k);
+
+/// @brief Packs row-major A (leading dimension `lda`) into panels: panel p is `k` steps of `mr` values
+/// from rows [p * mr, (p + 1) * mr). A `kc` block starting at step k0 of a panel is at `k0 * mr` within it.
+void PackGemmAPanels(const GemmMicroKernel& kernel, int64_t m, int64_t k, const float* a, int64_t lda,
+                     float* packed);
+
+#if defined(HIPDNN_EP_HOST_X86)
+// ISA-specific micro-kernels, built with their own target flags and only called when the CPU supports them
+void GemmMicroKernelAvx2(int64_t kc, const float* a, const float* b, float* c, int64_t ldc, bool accumulate);
+void GemmMicroKernelAvx512(int64_t kc, const float* a, const float* b, float* c, int64_t ldc, bool accumulate);
+#endif
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,38 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace hipdnn_ep {
+
+/// @brief Channels per block of the host backend's blocked layout, NC[D]HW16c: an image is ceil(C / 16) blocks,
+/// each [D, H, W, 16] with the 16 channels of a position contiguous. Lanes past the last channel are padding
+/// that no op reads into a real channel, so producers may leave them undefined. The same on every ISA, so
+/// compiled partitions do not depend on the CPU; kernels narrower than a block cover it in several passes.
+constexpr int64_t kHostBlockChannels = 16;
+
+/// @brief Addressing of one image of a float NC[D]HW tensor in the plain or the blocked layout
+struct HostImageLayout {
+  bool blocked{false};
+  int64_t channels{0};
+  int64_t plane_size{0};  // Positions per channel, D * H * W
+
+  /// @brief Floats per image, counting the padding channels of a blocked image
+  int64_t ImageSize() const {
+    return blocked ? (channels + kHostBlockChannels - 1) / kHostBlockChannels * kHostBlockChannels * plane_size
+                   : channels * plane_size;
+  }
+
+  /// @brief Offset of channel `c` at position 0 from the start of the image
+  int64_t ChannelOffset(int64_t c) const {
+    return blocked ? c / kHostBlockChannels * kHostBlockChannels * plane_size + c % kHostBlockChannels
+                   : c * plane_size;
+  }
+
+  /// @brief Floats between consecutive positions of a channel
+  int64_t PositionStride() const { return blocked ? kHostBlockChannels : 1; }
+};
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,35 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "op.h"
+#include "thread_pool.h"
+
+namespace hipdnn_ep {
+
+/// @brief MatMul and Gemm on the host, split by output row, with the addend and activation applied to each
+/// row as it is finished. Float only.
+class HostMatMulOp : public Op {
+ public:
+  HostMatMulOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<MatMulOpInfo> info,
+               ThreadPool& thread_pool);
+
+  /// @brief Validate the problem from the op info
+  OrtStatus* Compile();
+
+  OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                     const std::vector<void*>& outputs) const override;
+
+ private:
+  const MatMulOpInfo& MatMulInfo() const { return static_cast<const MatMulOpInfo&>(Info()); }
+
+  /// @brief Computes row `row` (batch * M + i) of Y
+  void RunRow(int64_t row, const float* a, const float* b, const float* c, float* y) const;
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+  ThreadPool& thread_pool_;
+};
+
+}  // namespace hipdnn_ep
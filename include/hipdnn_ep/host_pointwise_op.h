@@ -0,0 +1,44 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "op.h"
+#include "pointwise_kernel.h"
+#include "thread_pool.h"
+
+namespace hipdnn_ep {
+
+/// @brief y = func(y) over `count` contiguous floats: the fused activation epilogue of the host ops
+void ApplyPointwiseInPlace(PointwiseFunc func, float alpha, float beta, float* y, int64_t count);
+
+/// @brief Elementwise activations and broadcasting binary arithmetic on the host, with the same functors
+/// and launch shape as the GPU's generic pointwise kernel. Float only. An op whose inputs all have the output's
+/// shape runs the same over the blocked layout (NC[D]HW16c), padding channels included.
+class HostPointwiseOp : public Op {
+ public:
+  HostPointwiseOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<PointwiseOpInfo> info,
+                  ThreadPool& thread_pool);
+
+  /// @brief Resolve the broadcast strides, merging dims that are laid out alike in every input
+  OrtStatus* Compile();
+
+  /// @brief All tensors alike, when no input is broadcast and the output has channels
+  BlockedLayoutSupport SupportsBlockedLayout() const override;
+  void UseBlockedLayout(bool input, bool output) override;
+
+  OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                     const std::vector<void*>& outputs) const override;
+
+ private:
+  const PointwiseOpInfo& PointwiseInfo() const { return static_cast<const PointwiseOpInfo&>(Info()); }
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+  ThreadPool& thread_pool_;
+
+  PointwiseParams params_;
+  int64_t count_{0};  // Floats per tensor of an op without broadcasting, padding channels included
+};
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,60 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "host_layout.h"
+#include "op.h"
+#include "thread_pool.h"
+
+#include <array>
+
+namespace hipdnn_ep {
+
+/// @brief MaxPool, AveragePool and their Global variants on the host, one N*C plane per task.
+/// Float NC[D]HW only; 1D and 2D windows run as 3D with unit dims. X and Y may each be in the blocked layout
+/// (NC[D]HW16c); a blocked X is pooled a block of channels per task, with the channels in SIMD lanes.
+class HostPoolOp : public Op {
+ public:
+  HostPoolOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<PoolOpInfo> info,
+             ThreadPool& thread_pool);
+
+  /// @brief Resolve the 3D window geometry from the op info
+  OrtStatus* Compile();
+
+  BlockedLayoutSupport SupportsBlockedLayout() const override { return BlockedLayoutSupport::kIndependent; }
+  void UseBlockedLayout(bool input, bool output) override;
+
+  OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                     const std::vector<void*>& outputs) const override;
+
+ private:
+  const PoolOpInfo& PoolInfo() const { return static_cast<const PoolOpInfo&>(Info()); }
+
+  /// @brief Window of output `o` along dim `d`, clipped to the input. `padded` is the window size counting the
+  /// padding it overlaps (but not the part that ceil_mode pushes past the end padding), the include_pad divisor.
+  void Window(size_t d, int64_t o, int64_t& begin, int64_t& end, int64_t& padded) const;
+
+  /// @brief Pools one plain input plane into one output plane, positions `y_stride` floats apart
+  void RunPlane(const float* x, float* y, int64_t y_stride) const;
+
+  /// @brief Pools one block of a blocked input into `channels` channels of the output, starting at the block's
+  /// first channel
+  void RunBlock(const float* x, float* y, int64_t channels) const;
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+  ThreadPool& thread_pool_;
+
+  int64_t planes_{0};
+  std::array<int64_t, 3> x_dims_{};
+  std::array<int64_t, 3> y_dims_{};
+  std::array<int64_t, 3> k_dims_{};
+  std::array<int64_t, 3> strides_{};
+  std::array<int64_t, 3> pads_begin_{};
+  std::array<int64_t, 3> pads_end_{};
+  HostImageLayout x_layout_;
+  HostImageLayout y_layout_;
+};
+
+}  // namespace hipdnn_ep
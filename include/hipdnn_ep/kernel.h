@@ -4,63 +4,82 @@
 #pragma once
 
 #include "ep_utils.h"
+#include "backend.h"
+#include "op.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
-// MIOpen includes
-#include <miopen/miopen.h>
-#include <hip/hip_runtime.h>
-
 namespace hipdnn_ep {
 
-/// @brief Generic kernel that builds and executes operations using MIOpen
+/// @brief Generic kernel that builds a fused partition into ops and executes them on the EP's backend
 struct Kernel {
-  Kernel(const OrtApi& ort_api, const OrtLogger& logger);
+  Kernel(const OrtApi& ort_api, const OrtLogger& logger, Backend& backend);
   ~Kernel();
 
   /// @brief Build and compile from an ORT graph
   OrtStatus* BuildAndCompile(Ort::ConstGraph graph);
 
-  /// @brief Execute the compiled operations
-  OrtStatus* Execute(OrtKernelContext* kernel_ctx);
+  /// @brief Save the compiled state (ops, chosen solutions, memory plan) for an EPContext node
+  OrtStatus* Serialize(std::string& context) const;
+
+  /// @brief Rebuild from Serialize output. Skips graph analysis, value planning and MIOpen Find.
+  /// Fails for a context written by a different backend.
+  OrtStatus* LoadFromContext(const std::string& context);
+
+  /// @brief Execute the compiled operations. Re-entrant: concurrent Session::Run calls share the kernel,
+  /// and each call leases its own execution resources and scratch memory from the backend.
+  OrtStatus* Execute(OrtKernelContext* kernel_ctx) const;
 
  private:
+  /// @brief Where a value lives while the kernel executes
+  struct ValueLocation {
+    enum class Kind {
+      kNone,     // Omitted optional input
+      kInput,    // Kernel context input `index`
+      kOutput,   // Kernel context output `index`
+      kScratch,  // Intermediate at byte offset `index` of the scratch buffer
+    };
+    Kind kind{Kind::kNone};
+    size_t index{0};
+    bool blocked{false};  // Intermediate in the backend's blocked layout
+  };
+
+  /// @brief Append a compiled op to the op list
+  void AddOp(std::unique_ptr<Op> op);
+
+  /// @brief Pick the intermediates kept in the backend's blocked layout: those whose producer and every consumer
+  /// support it. The kernel's own inputs and outputs stay plain, so the layout changes only at its boundaries,
+  /// inside the ops that read or write them.
+  std::unordered_set<std::string> AssignLayouts() const;
+
+  /// @brief Bind every op input/output to a location, placing intermediates in scratch memory
+  OrtStatus* PlanValues(const std::unordered_map<std::string, Ort::ConstValueInfo>& node_outputs,
+                        const std::unordered_set<std::string>& blocked_values);
+
+  /// @brief Tell each op which of its tensors are blocked. Fails if an op doesn't support its locations' layouts.
+  OrtStatus* ApplyLayouts();
+
   const OrtApi& ort_api_;
   const OrtLogger& logger_;
+  Backend& backend_;
 
-  // MIOpen handle
-  miopenHandle_t miopen_handle_{nullptr};
+  // Compiled operations in topological order, with the locations of their inputs/outputs
+  std::vector<std::unique_ptr<Op>> ops_;
+  std::vector<std::vector<ValueLocation>> op_inputs_;
+  std::vector<std::vector<ValueLocation>> op_outputs_;
 
-  // Convolution descriptors
-  miopenTensorDescriptor_t x_desc_{nullptr};  // Input
-  miopenTensorDescriptor_t w_desc_{nullptr};  // Weights
-  miopenTensorDescriptor_t y_desc_{nullptr};  // Output
-  miopenTensorDescriptor_t b_desc_{nullptr};  // Bias (optional)
-  miopenConvolutionDescriptor_t conv_desc_{nullptr};
-
-  // Convolution algorithm and workspace
-  miopenConvFwdAlgorithm_t conv_algo_{miopenConvolutionFwdAlgoGEMM};
+  // Scratch memory borrowed from the backend at execution time: intermediates first,
+  // then the largest workspace needed by any op
+  size_t intermediates_size_{0};
   size_t workspace_size_{0};
-  void* workspace_{nullptr};
-
-  // Tensor shapes
-  std::vector<int64_t> x_shape_;
-  std::vector<int64_t> w_shape_;
-  std::vector<int64_t> y_shape_;
-  std::vector<int64_t> b_shape_;
 
-  // Graph I/O info
-  size_t num_inputs_{0};
-  size_t num_outputs_{0};
+  // Graph I/O info: value name -> index in the kernel context
+  std::unordered_map<std::string, size_t> input_indices_;
+  std::unordered_map<std::string, size_t> output_indices_;
   std::vector<std::vector<int64_t>> output_shapes_;
-
-  // Bias support
-  bool has_bias_{false};
-
-  // Data type
-  miopenDataType_t data_type_{miopenFloat};
 };
 
 }  // namespace hipdnn_ep
@@ -0,0 +1,56 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "op.h"
+
+#include <hipblaslt/hipblaslt.h>
+
+namespace hipdnn_ep {
+
+/// @brief hipBLASLt GEMM for MatMul and Gemm with an optional bias + activation epilogue.
+///
+/// Bias and Relu run in hipBLASLt's epilogue; other activations have no hipBLASLt epilogue and run
+/// as a MIOpen activation on the output afterwards.
+class MatMulOp : public Op {
+ public:
+  MatMulOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<MatMulOpInfo> info);
+  ~MatMulOp() override;
+
+  /// @brief Create the matrix layouts and select the GEMM algorithm by hipBLASLt's heuristic.
+  /// The heuristic is cheap, so EP context models run it again on load rather than storing its choice.
+  OrtStatus* Compile(hipblasLtHandle_t blaslt_handle);
+
+  size_t WorkspaceSize() const override { return workspace_size_; }
+
+  OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                     const std::vector<void*>& outputs) const override;
+
+ private:
+  const MatMulOpInfo& MatMulInfo() const { return static_cast<const MatMulOpInfo&>(Info()); }
+
+  /// @brief Create a matmul descriptor with the op's transposes and epilogue
+  OrtStatus* CreateMatmulDesc(hipblasLtMatmulDesc_t& desc) const;
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+
+  hipblasLtHandle_t blaslt_handle_{nullptr};  // Owned by the EP
+  hipblasLtEpilogue_t epilogue_{HIPBLASLT_EPILOGUE_DEFAULT};
+
+  // hipBLASLt is column-major, so the row-major Y = A * B is computed as Y^T = B^T * A^T:
+  // B is hipBLASLt's first operand, A its second, and Y is an N x M column-major matrix
+  hipblasLtMatmulDesc_t matmul_desc_{nullptr};  // Without a bias pointer; calls with a bias use their own
+  hipblasLtMatrixLayout_t b_layout_{nullptr};
+  hipblasLtMatrixLayout_t a_layout_{nullptr};
+  hipblasLtMatrixLayout_t y_layout_{nullptr};  // Also describes Gemm's C
+  hipblasLtMatmulAlgo_t algo_{};
+  size_t workspace_size_{0};
+
+  // Activation hipBLASLt has no epilogue for (optional), applied in place on Y
+  miopenTensorDescriptor_t y_desc_{nullptr};
+  miopenActivationDescriptor_t activation_desc_{nullptr};
+};
+
+}  // namespace hipdnn_ep
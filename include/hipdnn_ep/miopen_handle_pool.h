@@ -0,0 +1,64 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <miopen/miopen.h>
+#include <hip/hip_runtime.h>
+
+namespace hipdnn_ep {
+
+/// @brief Pool of MIOpen handles shared by all kernels of an EP.
+///
+/// A handle carries its own stream, kernel cache and internal buffers, so instead of one per
+/// compiled node the pool only grows to the number of concurrently executing threads.
+class MIOpenHandlePool {
+ public:
+  /// @brief Exclusive use of a pooled handle; returns it to the pool on destruction.
+  class Lease {
+   public:
+    Lease() = default;
+    ~Lease();
+
+    Lease(Lease&& other) noexcept;
+    Lease& operator=(Lease&& other) noexcept;
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    miopenHandle_t Get() const { return handle_; }
+
+   private:
+    friend class MIOpenHandlePool;
+    Lease(MIOpenHandlePool* pool, miopenHandle_t handle) : pool_(pool), handle_(handle) {}
+
+    MIOpenHandlePool* pool_{nullptr};
+    miopenHandle_t handle_{nullptr};
+  };
+
+  MIOpenHandlePool() = default;
+  ~MIOpenHandlePool();
+
+  MIOpenHandlePool(const MIOpenHandlePool&) = delete;
+  MIOpenHandlePool& operator=(const MIOpenHandlePool&) = delete;
+
+  /// @brief Borrows a handle bound to `stream`, creating one if all pooled handles are in use.
+  miopenStatus_t Acquire(hipStream_t stream, Lease& lease);
+
+  /// @brief Number of handles created so far.
+  size_t Size() const;
+
+ private:
+  miopenStatus_t AcquireHandle(hipStream_t stream, miopenHandle_t& handle);
+  void Release(miopenHandle_t handle);
+
+  mutable std::mutex mutex_;
+  std::vector<miopenHandle_t> handles_;                        // All handles, owned by the pool
+  std::vector<miopenHandle_t> free_handles_;                   // Handles not currently leased
+  std::unordered_map<miopenHandle_t, hipStream_t> streams_;    // Stream each handle is bound to
+};
+
+}  // namespace hipdnn_ep
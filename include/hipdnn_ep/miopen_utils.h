@@ -0,0 +1,97 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ep_utils.h"
+#include "op_info.h"
+
+#include <miopen/miopen.h>
+
+// Helper to return an OrtStatus if a MIOpen call fails
+#define MIOPEN_RETURN_IF_ERROR(ort_api, call)                         \
+  do {                                                                \
+    miopenStatus_t _miopen_status = (call);                           \
+    if (_miopen_status != miopenStatusSuccess) {                      \
+      RETURN_ERROR(ort_api, ORT_EP_FAIL, "MIOpen error: " << _miopen_status \
+                                             << " in " << #call);     \
+    }                                                                 \
+  } while (0)
+
+#define HIP_RETURN_IF_ERROR(ort_api, call)                                        \
+  do {                                                                            \
+    hipError_t _hip_err = (call);                                                 \
+    if (_hip_err != hipSuccess) {                                                 \
+      RETURN_ERROR(ort_api, ORT_EP_FAIL, "HIP error: " << hipGetErrorString(_hip_err) \
+                                             << " in " << #call);                 \
+    }                                                                             \
+  } while (0)
+
+namespace hipdnn_ep {
+
+// Convert ONNX data type to MIOpen data type
+inline miopenDataType_t ToMIOpenDataType(ONNXTensorElementDataType onnx_dtype) {
+  switch (onnx_dtype) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      return miopenFloat;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+      return miopenHalf;
+    default:
+      return miopenFloat;
+  }
+}
+
+// Size in bytes of one element of a MIOpen data type
+inline size_t MIOpenDataTypeSize(miopenDataType_t data_type) {
+  return data_type == miopenHalf ? 2 : sizeof(float);
+}
+
+// Sets a fully packed tensor descriptor with the given dims (outermost first)
+inline miopenStatus_t SetPackedTensorDescriptor(miopenTensorDescriptor_t desc, miopenDataType_t data_type,
+                                                const std::vector<int64_t>& shape) {
+  std::vector<int> dims(shape.begin(), shape.end());
+  std::vector<int> strides(dims.size(), 1);
+  for (int i = static_cast<int>(dims.size()) - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * dims[i + 1];
+  }
+  return miopenSetTensorDescriptor(desc, data_type, static_cast<int>(dims.size()), dims.data(), strides.data());
+}
+
+// Map an ONNX activation onto MIOpen's activation modes. MIOpen computes
+//   LEAKYRELU:   x > 0 ? x : alpha * x
+//   CLIPPEDRELU: min(alpha, max(0, x))
+//   CLAMP:       max(alpha, min(beta, x))
+inline void ToMIOpenActivation(const Activation& activation, miopenActivationMode_t& mode,
+                               double& alpha, double& beta, double& gamma) {
+  alpha = 0.0;
+  beta = 0.0;
+  gamma = 0.0;
+  switch (activation.kind) {
+    case Activation::Kind::kRelu:
+      mode = miopenActivationRELU;
+      break;
+    case Activation::Kind::kLeakyRelu:
+      mode = miopenActivationLEAKYRELU;
+      alpha = activation.alpha;
+      break;
+    case Activation::Kind::kSigmoid:
+      mode = miopenActivationLOGISTIC;
+      break;
+    case Activation::Kind::kClip:
+      // Relu6-style clips have a fused kernel; general bounds need CLAMP
+      if (activation.alpha == 0.0f) {
+        mode = miopenActivationCLIPPEDRELU;
+        alpha = activation.beta;
+      } else {
+        mode = miopenActivationCLAMP;
+        alpha = activation.alpha;
+        beta = activation.beta;
+      }
+      break;
+    case Activation::Kind::kNone:
+      mode = miopenActivationPASTHRU;
+      break;
+  }
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,66 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ep_utils.h"
+#include "op_info.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <miopen/miopen.h>
+#include <hip/hip_runtime.h>
+
+namespace hipdnn_ep {
+
+/// @brief Per-call resources an Op executes with
+struct ExecutionContext {
+  miopenHandle_t miopen_handle{nullptr};
+  hipStream_t stream{nullptr};
+  void* workspace{nullptr};  // At least WorkspaceSize() bytes, ordered on `stream`
+};
+
+/// @brief Which tensors of an op may be in its backend's blocked layout (Backend::BlockedLayoutChannels)
+/// instead of plain NC[D]HW
+enum class BlockedLayoutSupport {
+  kNone,         // Plain tensors only
+  kIndependent,  // Input 0 and output 0 may each be blocked; any other inputs are plain
+  kUniform,      // Every input and the output are blocked, or none are
+};
+
+/// @brief A compiled operation inside a Kernel
+class Op {
+ public:
+  explicit Op(std::unique_ptr<OpInfo> info) : info_(std::move(info)) {}
+  virtual ~Op() = default;
+
+  Op(const Op&) = delete;
+  Op& operator=(const Op&) = delete;
+
+  const OpInfo& Info() const { return *info_; }
+
+  /// @brief Scratch memory needed by Execute
+  virtual size_t WorkspaceSize() const { return 0; }
+
+  /// @brief Which of its tensors the op can take in the blocked layout
+  virtual BlockedLayoutSupport SupportsBlockedLayout() const { return BlockedLayoutSupport::kNone; }
+
+  /// @brief Set by the Kernel before the first Execute: whether input 0 (all inputs for kUniform) and output 0
+  /// are in the blocked layout. Only called with layouts SupportsBlockedLayout allows.
+  virtual void UseBlockedLayout(bool /*input*/, bool /*output*/) {}
+
+  /// @brief Save the info and compiled state for an EP context model
+  virtual void Serialize(ContextWriter& writer) const { info_->Serialize(writer); }
+
+  /// @brief Enqueue the operation. `inputs`/`outputs` are device pointers ordered as in Info().
+  /// Called concurrently by overlapping runs of a session, so all per-call state lives in `ctx`.
+  virtual OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                             const std::vector<void*>& outputs) const = 0;
+
+ private:
+  std::unique_ptr<OpInfo> info_;
+};
+
+}  // namespace hipdnn_ep
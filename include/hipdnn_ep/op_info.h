@@ -0,0 +1,250 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ep_context.h"
+#include "ep_utils.h"
+#include "pointwise_kernel.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hipdnn_ep {
+
+/// @brief Elementwise activation applied as a fused epilogue
+struct Activation {
+  enum class Kind {
+    kNone,
+    kRelu,
+    kLeakyRelu,
+    kSigmoid,
+    kClip,
+  };
+
+  Kind kind{Kind::kNone};
+  float alpha{0.0f};  // LeakyRelu slope, Clip min
+  float beta{0.0f};   // Clip max
+};
+
+/// @brief Parses a Relu/LeakyRelu/Sigmoid/Clip node. Returns false for any other node
+/// or when its parameters are not compile-time constants.
+bool ParseActivation(Ort::ConstNode node, Activation& activation);
+
+/// @brief Base class for operation info - op-agnostic
+struct OpInfo {
+  std::string op_type;
+  std::string node_name;
+  std::vector<std::string> inputs;   // Value names, empty for omitted optional inputs
+  std::vector<std::string> outputs;  // Value names
+
+  virtual ~OpInfo() = default;
+
+  /// @brief Save/restore for EP context models. Derived infos append their own fields.
+  virtual void Serialize(ContextWriter& writer) const;
+  virtual bool Deserialize(ContextReader& reader);
+};
+
+/// @brief Conv or ConvTranspose with an optional fused bias and activation epilogue.
+/// inputs = {X, W[, B]}, outputs = {Y} where Y is the output of the last fused node.
+/// With constant weights (a folded BatchNormalization, or a backend that owns constant weights), inputs = {X}
+/// and the op owns the weights and bias.
+struct ConvOpInfo : OpInfo {
+  bool transposed{false};  // ConvTranspose: W is [C_in, C_out / group, k...]
+  std::vector<int64_t> pads;  // {begin..., end...}
+  std::vector<int64_t> strides;
+  std::vector<int64_t> dilations;
+  std::vector<int64_t> output_padding;  // ConvTranspose only: extra outputs at the end of each spatial dim
+  int64_t group{1};
+
+  std::vector<int64_t> x_shape;
+  std::vector<int64_t> w_shape;
+  std::vector<int64_t> y_shape;
+  ONNXTensorElementDataType dtype{ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT};
+
+  bool has_bias{false};
+  Activation activation;
+
+  // Weights and bias the op owns, as float whatever the dtype: with a BatchNormalization folded in, or the
+  // constant W and B (zeros without one) for a backend that owns constant weights. Empty otherwise.
+  std::vector<float> constant_weights;
+  std::vector<float> constant_bias;
+
+  bool HasConstantWeights() const { return !constant_weights.empty(); }
+
+  void Serialize(ContextWriter& writer) const override;
+  bool Deserialize(ContextReader& reader) override;
+};
+
+/// @brief MatMul or Gemm with an optional fused bias and activation epilogue, run as one strided batched GEMM:
+/// Y[b] = alpha * op(A[b]) * op(B[b]) (+ beta * C | + bias) for each of the batch_count batches.
+/// inputs = {A, B[, C]}, outputs = {Y} where Y is the output of the last fused node.
+struct MatMulOpInfo : OpInfo {
+  /// @brief How the third input enters the result
+  enum class Addend {
+    kNone,
+    kBias,    // [N] row vector added to every row, through the GEMM's bias epilogue
+    kMatrix,  // Gemm's [M, N] C, scaled by beta
+  };
+
+  int64_t m{0};
+  int64_t n{0};
+  int64_t k{0};
+  int64_t batch_count{1};
+  bool a_batched{false};  // false: one A is shared by every batch
+  bool b_batched{false};  // false: one B is shared by every batch
+  bool trans_a{false};    // Gemm only
+  bool trans_b{false};    // Gemm only
+  float alpha{1.0f};
+  float beta{0.0f};
+  Addend addend{Addend::kNone};
+
+  std::vector<int64_t> y_shape;
+  ONNXTensorElementDataType dtype{ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT};
+
+  Activation activation;
+
+  void Serialize(ContextWriter& writer) const override;
+  bool Deserialize(ContextReader& reader) override;
+};
+
+/// @brief GEMM problem a MatMul or Gemm node maps to
+struct MatMulShape {
+  int64_t m{0};
+  int64_t n{0};
+  int64_t k{0};
+  int64_t batch_count{1};
+  bool a_batched{false};
+  bool b_batched{false};
+};
+
+/// @brief Resolves a MatMul's GEMM problem from its static input shapes, with numpy-style promotion of
+/// 1-D operands. Batch dims may only broadcast as a whole: each operand is either batched like the output
+/// or has no batch (or all-1 batch dims) and is shared. A batch of A against a shared B is folded into M.
+/// Returns false for mismatched or partially broadcast shapes.
+bool ResolveMatMulShape(const std::vector<int64_t>& a_shape, const std::vector<int64_t>& b_shape,
+                        MatMulShape& shape);
+
+/// @brief Resolves a Gemm's GEMM problem and how its optional C input is applied. C must be a row bias
+/// ([N] or [1, N], only with beta == 1) or a full [M, N] matrix; returns false for other broadcasts.
+bool ResolveGemmShape(Ort::ConstNode gemm, MatMulShape& shape, MatMulOpInfo::Addend& addend);
+
+/// @brief MaxPool, AveragePool, GlobalMaxPool or GlobalAveragePool. inputs = {X}, outputs = {Y}
+struct PoolOpInfo : OpInfo {
+  enum class Mode {
+    kMax,
+    kAverage,            // Padding is not counted in the average
+    kAverageIncludePad,  // count_include_pad = 1
+  };
+
+  Mode mode{Mode::kMax};
+  std::vector<int64_t> kernel_shape;
+  std::vector<int64_t> pads;  // {begin..., end...}
+  std::vector<int64_t> strides;
+
+  // y_shape is the node's output shape, so ceil_mode is already applied to it
+  std::vector<int64_t> x_shape;
+  std::vector<int64_t> y_shape;
+  ONNXTensorElementDataType dtype{ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT};
+
+  void Serialize(ContextWriter& writer) const override;
+  bool Deserialize(ContextReader& reader) override;
+};
+
+/// @brief Elementwise activation or arithmetic op run by the generic pointwise kernel.
+/// inputs = {A[, B]}, outputs = {Y}. Binary ops broadcast A and B to y_shape numpy-style.
+struct PointwiseOpInfo : OpInfo {
+  PointwiseFunc func{PointwiseFunc::kRelu};
+  float alpha{0.0f};  // LeakyRelu slope, Clip min
+  float beta{0.0f};   // Clip max
+
+  std::vector<int64_t> a_shape;
+  std::vector<int64_t> b_shape;  // Empty for unary ops
+  std::vector<int64_t> y_shape;
+  ONNXTensorElementDataType dtype{ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT};
+
+  void Serialize(ContextWriter& writer) const override;
+  bool Deserialize(ContextReader& reader) override;
+};
+
+/// @brief Looks `op_type` up in the pointwise op table. `arity` is the number of tensor inputs the kernel
+/// reads (Clip's min/max are folded into the op's parameters). Returns false for other op types.
+bool LookupPointwiseOp(const std::string& op_type, PointwiseFunc& func, size_t& arity);
+
+/// @brief Parses a pointwise node's function and parameters. Returns false for nodes outside the pointwise
+/// op table or when their parameters are not compile-time constants.
+bool ParsePointwiseOp(Ort::ConstNode node, PointwiseFunc& func, float& alpha, float& beta);
+
+/// @brief Resolves the launch shape of a pointwise op: the broadcast strides of A and B against y_shape, with
+/// size-1 dims dropped and each dim merged into the previous one where every input steps over both as one.
+/// Inputs shaped like the output resolve to rank 0. Returns false if an input doesn't broadcast to the
+/// output or more than PointwiseParams::kMaxRank dims remain.
+bool ResolvePointwiseParams(const PointwiseOpInfo& info, PointwiseParams& params);
+
+/// @brief The PointwiseFunc computing a fused epilogue activation. `kind` must not be kNone.
+PointwiseFunc ToPointwiseFunc(Activation::Kind kind);
+
+/// @brief Resolves a Conv node's explicit pads ({begin..., end...}), computing them from `auto_pad`
+/// (SAME_UPPER, SAME_LOWER, VALID) and the static input/weight shapes when it is set.
+/// Returns false for an unknown auto_pad value.
+bool ResolveConvPads(Ort::ConstNode conv, const std::vector<int64_t>& x_shape, const std::vector<int64_t>& w_shape,
+                     std::vector<int64_t>& pads);
+
+/// @brief Resolves a MaxPool or AveragePool node's explicit pads ({begin..., end...}), computing them from
+/// `auto_pad` and the static input shape when it is set. Returns false for an unknown auto_pad value.
+bool ResolvePoolPads(Ort::ConstNode pool, const std::vector<int64_t>& x_shape, std::vector<int64_t>& pads);
+
+/// @brief Resolves a ConvTranspose node's pads ({begin..., end...}) and output_padding, computing the pads
+/// from `output_shape` or `auto_pad` when either is set. Returns false for an unknown auto_pad value or
+/// an output_shape that would need negative padding.
+bool ResolveConvTransposePads(Ort::ConstNode conv_transpose, const std::vector<int64_t>& x_shape,
+                              const std::vector<int64_t>& w_shape, std::vector<int64_t>& pads,
+                              std::vector<int64_t>& output_padding);
+
+/// @brief Nodes matched as Conv|ConvTranspose -> [BatchNormalization] -> [Add(per-channel constant)]
+/// -> [Relu|LeakyRelu|Sigmoid|Clip]. Only a Conv with constant weights and bias takes a BatchNormalization.
+struct ConvFusion {
+  Ort::ConstNode conv{nullptr};
+  Ort::ConstNode batch_norm{nullptr};
+  Ort::ConstNode bias_add{nullptr};
+  Ort::ConstNode activation{nullptr};
+
+  /// @brief All matched nodes in execution order
+  std::vector<Ort::ConstNode> Nodes() const;
+};
+
+/// @brief Extends a supported Conv or ConvTranspose with the epilogue nodes that can be fused into it.
+/// Each epilogue node must be the only consumer of the previous node's output, and that
+/// output must not be needed outside the group.
+ConvFusion MatchConvFusion(Ort::ConstNode conv);
+
+/// @brief Builds the ConvOpInfo for a matched fusion group. A BatchNormalization in the group is folded
+/// into the Conv's weights and bias here, together with the bias Add that follows it. With
+/// `own_constant_weights`, weights and bias that are all constant initializers are copied into the info too.
+std::unique_ptr<ConvOpInfo> CreateConvOpInfo(const ConvFusion& fusion, bool own_constant_weights);
+
+/// @brief Builds the PoolOpInfo for a supported pooling node.
+std::unique_ptr<PoolOpInfo> CreatePoolOpInfo(Ort::ConstNode pool);
+
+/// @brief Builds the PointwiseOpInfo for a supported pointwise node.
+std::unique_ptr<PointwiseOpInfo> CreatePointwiseOpInfo(Ort::ConstNode node);
+
+/// @brief Nodes matched as MatMul|Gemm -> [Add(row bias constant)] -> [Relu|LeakyRelu|Sigmoid|Clip]
+struct MatMulFusion {
+  Ort::ConstNode matmul{nullptr};
+  Ort::ConstNode bias_add{nullptr};
+  Ort::ConstNode activation{nullptr};
+
+  /// @brief All matched nodes in execution order
+  std::vector<Ort::ConstNode> Nodes() const;
+};
+
+/// @brief Extends a supported MatMul or Gemm with the epilogue nodes that can be fused into it, under the
+/// same single-consumer rules as MatchConvFusion. The bias must broadcast along the last axis ([N], [1, N]...).
+MatMulFusion MatchMatMulFusion(Ort::ConstNode matmul);
+
+/// @brief Builds the MatMulOpInfo for a matched fusion group.
+std::unique_ptr<MatMulOpInfo> CreateMatMulOpInfo(const MatMulFusion& fusion);
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,31 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <hip/hip_runtime.h>
+
+// Host interface of the zero padding kernel (pad_kernel.hip). Kept free of ORT and MIOpen headers so the
+// device compiler only sees HIP.
+
+namespace hipdnn_ep {
+
+/// @brief Shapes of one zero padding launch. X sits at `pads_begin` inside the larger Y; both are packed.
+struct PadParams {
+  static constexpr int kMaxRank = 5;
+
+  int64_t count{0};  // Number of output elements; 0 when there is nothing to pad
+  int rank{0};
+  int64_t y_dims[kMaxRank]{};
+  int64_t x_dims[kMaxRank]{};
+  int64_t pads_begin[kMaxRank]{};
+};
+
+/// @brief Enqueue the copy of X into the zero padded Y on `stream`. Elements are copied as raw bits of
+/// `element_size` (2 or 4) bytes, whose all-zero pattern is 0 for fp16 and float alike.
+hipError_t LaunchPad(const PadParams& params, size_t element_size, const void* x, void* y, hipStream_t stream);
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,54 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <hip/hip_runtime.h>
+
+namespace hipdnn_ep {
+
+/// @brief Pool of pinned host buffers used to stage copies from/to pageable host memory.
+///
+/// DMA from pageable memory cannot run asynchronously, so host data is first copied into a pinned
+/// buffer. A released buffer is reused only after the stream work recorded on it has completed.
+class PinnedBufferPool {
+ public:
+  struct Buffer {
+    void* ptr{nullptr};
+    size_t size{0};
+    hipEvent_t event{nullptr};  // Recorded on release; the buffer is busy until it completes
+  };
+
+  PinnedBufferPool() = default;
+  ~PinnedBufferPool();
+
+  PinnedBufferPool(const PinnedBufferPool&) = delete;
+  PinnedBufferPool& operator=(const PinnedBufferPool&) = delete;
+
+  /// @brief Borrow an idle buffer of at least `size` bytes, allocating one if none is free.
+  hipError_t Acquire(size_t size, Buffer& buffer);
+
+  /// @brief Return a buffer once the work already enqueued on `stream` stops using it.
+  hipError_t Release(Buffer buffer, hipStream_t stream);
+
+  /// @brief Total pinned memory owned by the pool.
+  size_t AllocatedBytes() const;
+
+ private:
+  // Buffers are rounded up so slightly different tensor sizes share them
+  static constexpr size_t kGranularity = size_t{1} << 20;
+  // Idle buffers beyond this are freed instead of cached
+  static constexpr size_t kMaxCachedBytes = size_t{256} << 20;
+
+  mutable std::mutex mutex_;
+  std::vector<Buffer> free_buffers_;
+  size_t allocated_bytes_{0};
+};
+
+/// @brief Whether `ptr` is host memory registered with (or allocated by) HIP.
+bool IsPinnedHostMemory(const void* ptr);
+
+}  // namespace hipdnn_ep
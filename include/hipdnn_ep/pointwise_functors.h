@@ -0,0 +1,90 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "pointwise_kernel.h"
+
+#include <cmath>
+
+// Scalar definitions of the PointwiseFuncs, shared by the device kernel (pointwise_kernel.hip) and the
+// host backend's ops so both compute exactly the same function.
+
+namespace hipdnn_ep {
+
+/// @brief One functor per PointwiseFunc. All math is done in float whatever the storage type;
+/// unary functors ignore `b`.
+template <PointwiseFunc F>
+struct PointwiseFunctor;
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kRelu> {
+  __host__ __device__ static float Apply(float a, float, float, float) { return fmaxf(a, 0.0f); }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kLeakyRelu> {
+  __host__ __device__ static float Apply(float a, float, float alpha, float) { return a >= 0.0f ? a : alpha * a; }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kSigmoid> {
+  __host__ __device__ static float Apply(float a, float, float, float) { return 1.0f / (1.0f + expf(-a)); }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kTanh> {
+  __host__ __device__ static float Apply(float a, float, float, float) { return tanhf(a); }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kClip> {
+  __host__ __device__ static float Apply(float a, float, float alpha, float beta) {
+    return fminf(fmaxf(a, alpha), beta);
+  }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kHardSwish> {
+  // x * HardSigmoid(x) with ONNX's fixed alpha = 1/6, beta = 0.5
+  __host__ __device__ static float Apply(float a, float, float, float) {
+    return a * fminf(fmaxf(a * (1.0f / 6.0f) + 0.5f, 0.0f), 1.0f);
+  }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kGelu> {
+  __host__ __device__ static float Apply(float a, float, float, float) {
+    return 0.5f * a * (1.0f + erff(a * 0.70710678f));
+  }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kGeluTanh> {
+  // 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+  __host__ __device__ static float Apply(float a, float, float, float) {
+    return 0.5f * a * (1.0f + tanhf(0.7978845608f * (a + 0.044715f * a * a * a)));
+  }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kAdd> {
+  __host__ __device__ static float Apply(float a, float b, float, float) { return a + b; }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kSub> {
+  __host__ __device__ static float Apply(float a, float b, float, float) { return a - b; }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kMul> {
+  __host__ __device__ static float Apply(float a, float b, float, float) { return a * b; }
+};
+
+template <>
+struct PointwiseFunctor<PointwiseFunc::kDiv> {
+  __host__ __device__ static float Apply(float a, float b, float, float) { return a / b; }
+};
+
+}  // namespace hipdnn_ep
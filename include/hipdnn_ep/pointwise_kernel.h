@@ -0,0 +1,54 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <hip/hip_runtime.h>
+
+// Host interface of the generic pointwise kernel (pointwise_kernel.hip). Kept free of ORT and MIOpen
+// headers so the device compiler only sees HIP.
+
+namespace hipdnn_ep {
+
+/// @brief Elementwise function evaluated by the pointwise kernel. Indexes the kernels' functor tables,
+/// so new entries go at the end and need a functor in pointwise_functors.h.
+enum class PointwiseFunc {
+  kRelu,
+  kLeakyRelu,  // alpha: slope
+  kSigmoid,
+  kTanh,
+  kClip,  // alpha: min, beta: max
+  kHardSwish,
+  kGelu,      // Exact, with erf
+  kGeluTanh,  // approximate = "tanh"
+  kAdd,
+  kSub,
+  kMul,
+  kDiv,
+  kCount,
+};
+
+/// @brief Shapes of one pointwise launch, after broadcasting and merging of dims.
+/// A stride of 0 broadcasts that input along the dim.
+struct PointwiseParams {
+  static constexpr int kMaxRank = 8;
+
+  PointwiseFunc func{PointwiseFunc::kRelu};
+  float alpha{0.0f};
+  float beta{0.0f};
+
+  int64_t count{0};  // Number of output elements
+  int rank{0};       // 0: every input is either contiguous like the output or absent
+  int64_t y_dims[kMaxRank]{};
+  int64_t a_strides[kMaxRank]{};
+  int64_t b_strides[kMaxRank]{};
+};
+
+/// @brief Enqueue Y = func(A[, B]) on `stream`. Data is fp16 when `fp16` is set and float otherwise;
+/// `b` is ignored by unary functions.
+hipError_t LaunchPointwise(const PointwiseParams& params, bool fp16, const void* a, const void* b, void* y,
+                           hipStream_t stream);
+
+}  // namespace hipdnn_ep
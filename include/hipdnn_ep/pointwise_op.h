@@ -0,0 +1,32 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "op.h"
+#include "pointwise_kernel.h"
+
+namespace hipdnn_ep {
+
+/// @brief Elementwise activations and broadcasting binary arithmetic, all run by the generic pointwise kernel.
+class PointwiseOp : public Op {
+ public:
+  PointwiseOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<PointwiseOpInfo> info);
+
+  /// @brief Resolve the broadcast strides and merge dims that are laid out alike in every input,
+  /// so inputs shaped like the output run without any index arithmetic.
+  OrtStatus* Compile();
+
+  OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                     const std::vector<void*>& outputs) const override;
+
+ private:
+  const PointwiseOpInfo& PointwiseInfo() const { return static_cast<const PointwiseOpInfo&>(Info()); }
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+
+  PointwiseParams params_;
+};
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,33 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "op.h"
+
+namespace hipdnn_ep {
+
+/// @brief MIOpen pooling forward for MaxPool, AveragePool and their Global variants.
+class PoolOp : public Op {
+ public:
+  PoolOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<PoolOpInfo> info);
+  ~PoolOp() override;
+
+  /// @brief Create the tensor and pooling descriptors from the op info
+  OrtStatus* Compile();
+
+  OrtStatus* Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                     const std::vector<void*>& outputs) const override;
+
+ private:
+  const PoolOpInfo& PoolInfo() const { return static_cast<const PoolOpInfo&>(Info()); }
+
+  const OrtApi& ort_api_;
+  const OrtLogger& logger_;
+
+  miopenTensorDescriptor_t x_desc_{nullptr};
+  miopenTensorDescriptor_t y_desc_{nullptr};
+  miopenPoolingDescriptor_t pool_desc_{nullptr};
+};
+
+}  // namespace hipdnn_ep
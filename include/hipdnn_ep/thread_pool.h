@@ -0,0 +1,67 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hipdnn_ep {
+
+/// @brief Persistent worker threads that the host backend's ops split their loops over.
+///
+/// ParallelFor may be called from several threads at once (overlapping Session::Run calls): each call
+/// queues its own job, the workers serve the queued jobs in order, and the caller works on its own job
+/// too, so a call always makes progress even when every worker is busy elsewhere.
+class ThreadPool {
+ public:
+  /// @brief `num_threads` counts the calling thread; 0 uses one thread per hardware thread.
+  explicit ThreadPool(size_t num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @brief Number of threads a ParallelFor runs on, including the caller
+  size_t NumThreads() const { return workers_.size() + 1; }
+
+  /// @brief Calls fn(begin, end) over disjoint ranges covering [0, n) and returns once all have run.
+  /// Ranges hold at least `grain` iterations (except the last), so cheap iterations are batched.
+  /// If fn throws, the ranges not yet started are skipped and the first exception is rethrown here once
+  /// every running range has returned.
+  void ParallelFor(int64_t n, int64_t grain, const std::function<void(int64_t, int64_t)>& fn);
+
+ private:
+  struct Job {
+    const std::function<void(int64_t, int64_t)>* fn{nullptr};
+    int64_t n{0};
+    int64_t chunk_size{0};
+    int64_t num_chunks{0};
+    std::atomic<int64_t> next_chunk{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;  // Set by the thread that set `failed`
+    int active_workers{0};  // Guarded by mutex_
+  };
+
+  // Runs chunks of `job` until none are left
+  static void RunChunks(Job& job);
+
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_;  // Signalled when a job is queued or the pool stops
+  std::condition_variable done_cv_;  // Signalled when a worker leaves a job
+  std::deque<Job*> jobs_;
+  bool stop_{false};
+};
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,88 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace hipdnn_ep {
+
+/// @brief Device scratch memory shared by all kernels of an EP.
+///
+/// Each executing kernel leases a buffer for the duration of its call. A returned buffer is handed
+/// out again for later work on the same stream, which stream ordering makes safe without a sync, so
+/// the arena only grows to the number of kernels running concurrently on a stream.
+class WorkspaceArena {
+ public:
+  /// @brief Exclusive use of a scratch buffer; returns it to the arena on destruction.
+  class Lease {
+   public:
+    Lease() = default;
+    ~Lease();
+
+    Lease(Lease&& other) noexcept;
+    Lease& operator=(Lease&& other) noexcept;
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    void* Get() const { return ptr_; }
+
+   private:
+    friend class WorkspaceArena;
+    Lease(WorkspaceArena* arena, hipStream_t stream, void* ptr, size_t size)
+        : arena_(arena), stream_(stream), ptr_(ptr), size_(size) {}
+
+    void Reset();
+
+    WorkspaceArena* arena_{nullptr};
+    hipStream_t stream_{nullptr};
+    void* ptr_{nullptr};
+    size_t size_{0};
+  };
+
+  WorkspaceArena() = default;
+  ~WorkspaceArena();
+
+  WorkspaceArena(const WorkspaceArena&) = delete;
+  WorkspaceArena& operator=(const WorkspaceArena&) = delete;
+
+  /// @brief Records a kernel's workspace requirement so the first allocation is big enough.
+  void Reserve(size_t size);
+
+  /// @brief Leases a buffer of at least `size` bytes for work enqueued on `stream`.
+  /// No other caller gets the buffer until the lease is dropped.
+  hipError_t Acquire(hipStream_t stream, size_t size, Lease& lease);
+
+  /// @brief Total device memory currently held by the arena, leased or not, including replaced buffers
+  /// that are freed once the work using them completes.
+  size_t AllocatedBytes() const;
+
+ private:
+  struct Buffer {
+    void* ptr{nullptr};
+    size_t size{0};
+  };
+
+  // Buffer replaced by a larger one, freed once the fence recorded behind its last use completes
+  struct RetiredBuffer {
+    Buffer buffer;
+    hipEvent_t fence{nullptr};
+  };
+
+  hipError_t AcquireBuffer(hipStream_t stream, size_t size, Buffer& buffer);
+  void Release(hipStream_t stream, Buffer buffer);
+  // Both require mutex_ to be held
+  hipError_t Retire(hipStream_t stream, const Buffer& buffer);
+  void FreeCompletedRetired();
+
+  mutable std::mutex mutex_;
+  size_t reserved_size_{0};
+  size_t allocated_bytes_{0};
+  std::unordered_map<hipStream_t, std::vector<Buffer>> free_buffers_;  // Buffers not currently leased
+  std::vector<RetiredBuffer> retired_buffers_;
+};
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,375 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/bfc_arena.h"
+
+#include <algorithm>
+#include <string>
+
+namespace hipdnn_ep {
+
+/*static*/
+OrtStatus* ArenaConfig::FromKeyValuePairs(const OrtApi& ort_api, const OrtKeyValuePairs* kvps,
+                                          ArenaConfig& config) {
+  config = ArenaConfig{};
+  if (kvps == nullptr) {
+    return nullptr;
+  }
+
+  auto read = [&](const char* key, size_t& value) -> OrtStatus* {
+    const char* str = ort_api.GetKeyValue(kvps, key);
+    if (str == nullptr || *str == '\0') {
+      return nullptr;
+    }
+    try {
+      value = static_cast<size_t>(std::stoull(str));
+    } catch (const std::exception&) {
+      RETURN_ERROR(ort_api, ORT_INVALID_ARGUMENT, "Invalid value for " << key << ": " << str);
+    }
+    return nullptr;
+  };
+
+  size_t extend_strategy = 0;
+  RETURN_IF_ERROR(read("arena.extend_strategy", extend_strategy));
+  if (extend_strategy > 1) {
+    RETURN_ERROR(ort_api, ORT_INVALID_ARGUMENT, "arena.extend_strategy must be 0 or 1");
+  }
+  config.extend_strategy = extend_strategy == 0 ? ExtendStrategy::kNextPowerOfTwo : ExtendStrategy::kSameAsRequested;
+
+  RETURN_IF_ERROR(read("arena.initial_chunk_size_bytes", config.initial_chunk_size_bytes));
+  RETURN_IF_ERROR(read("arena.max_mem", config.max_mem));
+  RETURN_IF_ERROR(read("arena.max_dead_bytes_per_chunk", config.max_dead_bytes_per_chunk));
+  RETURN_IF_ERROR(read("arena.max_power_of_two_extend_bytes", config.max_power_of_two_extend_bytes));
+
+  if (config.max_mem == 0) {
+    config.max_mem = SIZE_MAX;
+  }
+  return nullptr;
+}
+
+BfcArena::BfcArena(const ArenaConfig& config, RawAlloc raw_alloc, RawFree raw_free)
+    : config_(config),
+      raw_alloc_(std::move(raw_alloc)),
+      raw_free_(std::move(raw_free)),
+      next_region_size_(RoundedBytes(config.initial_chunk_size_bytes)) {
+}
+
+BfcArena::~BfcArena() {
+  // Chunks first: dropping their fences returns the events to free_events_
+  for (auto& [ptr, chunk] : chunks_) {
+    delete chunk;
+  }
+  for (hipEvent_t event : free_events_) {
+    hipEventDestroy(event);
+  }
+  for (auto& [ptr, size] : regions_) {
+    raw_free_(ptr);
+  }
+  for (auto& [ptr, size] : reserved_) {
+    raw_free_(const_cast<void*>(ptr));
+  }
+}
+
+/*static*/
+size_t BfcArena::RoundedBytes(size_t size) {
+  size = std::max<size_t>(size, 1);
+  return (size + kMinAllocationSize - 1) & ~(kMinAllocationSize - 1);
+}
+
+/*static*/
+size_t BfcArena::BinIndex(size_t size) {
+  // Bin i holds chunks in [256 << i, 256 << (i + 1)); the last bin is unbounded
+  size_t index = 0;
+  for (size_t units = size >> kMinAllocationBits; units > 1 && index < kNumBins - 1; units >>= 1) {
+    ++index;
+  }
+  return index;
+}
+
+void* BfcArena::Alloc(size_t size) {
+  return AllocInternal(size, nullptr);
+}
+
+void* BfcArena::AllocOnStream(size_t size, hipStream_t stream) {
+  return AllocInternal(size, &stream);
+}
+
+void* BfcArena::AllocInternal(size_t size, const hipStream_t* stream) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  size_t rounded_size = RoundedBytes(size);
+  Chunk* chunk = FindChunk(rounded_size, stream);
+  if (chunk == nullptr) {
+    if (!Extend(rounded_size)) {
+      return nullptr;
+    }
+    chunk = FindChunk(rounded_size, stream);
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+  }
+
+  chunk->in_use = true;
+  chunk->on_stream = stream != nullptr;
+  chunk->stream = stream != nullptr ? *stream : nullptr;
+  chunk->fence.reset();
+  stats_.num_allocs++;
+  stats_.bytes_in_use += static_cast<int64_t>(chunk->size);
+  stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+  return chunk->ptr;
+}
+
+void* BfcArena::Reserve(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (static_cast<size_t>(stats_.total_allocated_bytes) + size > config_.max_mem) {
+    return nullptr;
+  }
+
+  void* ptr = raw_alloc_(size);
+  if (ptr == nullptr) {
+    return nullptr;
+  }
+
+  reserved_[ptr] = size;
+  stats_.num_reserves++;
+  stats_.bytes_in_use += static_cast<int64_t>(size);
+  stats_.total_allocated_bytes += static_cast<int64_t>(size);
+  stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+  return ptr;
+}
+
+void BfcArena::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto reserved_it = reserved_.find(p);
+  if (reserved_it != reserved_.end()) {
+    raw_free_(p);
+    stats_.bytes_in_use -= static_cast<int64_t>(reserved_it->second);
+    stats_.total_allocated_bytes -= static_cast<int64_t>(reserved_it->second);
+    reserved_.erase(reserved_it);
+    return;
+  }
+
+  auto it = chunks_.find(p);
+  if (it == chunks_.end() || !it->second->in_use) {
+    return;
+  }
+
+  Chunk* chunk = it->second;
+  chunk->in_use = false;
+  stats_.bytes_in_use -= static_cast<int64_t>(chunk->size);
+
+  // Work already enqueued on the chunk's stream may still use it
+  if (chunk->on_stream) {
+    chunk->fence = RecordFence(chunk->stream);
+    chunk->on_stream = false;
+  }
+
+  // Coalesce with free neighbours so the freed space can serve larger requests. The merged chunk keeps
+  // the later fence, which is only valid when both halves are ordered on the same stream.
+  Chunk* next = chunk->next;
+  if (next != nullptr && !next->in_use && CanMerge(chunk, next)) {
+    RemoveFree(next);
+    chunk = Merge(chunk, next, LaterFence(chunk->fence, next->fence));
+  }
+  Chunk* prev = chunk->prev;
+  if (prev != nullptr && !prev->in_use && CanMerge(chunk, prev)) {
+    RemoveFree(prev);
+    chunk = Merge(prev, chunk, LaterFence(chunk->fence, prev->fence));
+  }
+  InsertFree(chunk);
+}
+
+AllocatorStats BfcArena::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+BfcArena::Chunk* BfcArena::FindChunk(size_t rounded_size, const hipStream_t* stream) {
+  Chunk key;
+  key.size = rounded_size;
+
+  for (size_t bin = BinIndex(rounded_size); bin < kNumBins; ++bin) {
+    // Bins are ordered by size, so the first usable chunk that fits is the best fit in this bin
+    for (auto it = bins_[bin].lower_bound(&key); it != bins_[bin].end(); ++it) {
+      Chunk* chunk = *it;
+      if (!IsUsable(chunk, stream)) {
+        continue;
+      }
+
+      bins_[bin].erase(it);
+
+      // Split off the tail unless there is none, or it is small enough to leave as internal waste
+      if (chunk->size > rounded_size && (chunk->size >= rounded_size * 2 ||
+                                         chunk->size - rounded_size >= config_.max_dead_bytes_per_chunk)) {
+        SplitChunk(chunk, rounded_size);
+      }
+      return chunk;
+    }
+  }
+
+  return nullptr;
+}
+
+bool BfcArena::IsUsable(Chunk* chunk, const hipStream_t* stream) {
+  // Stream order already serializes the new work after the old on the same stream
+  if (chunk->fence && stream != nullptr && chunk->fence->stream == *stream) {
+    return true;
+  }
+  return IsRetired(chunk);
+}
+
+bool BfcArena::IsRetired(Chunk* chunk) {
+  if (!chunk->fence) {
+    return true;
+  }
+  if (hipEventQuery(chunk->fence->event) == hipSuccess) {
+    chunk->fence.reset();
+    return true;
+  }
+  return false;
+}
+
+std::shared_ptr<BfcArena::Fence> BfcArena::RecordFence(hipStream_t stream) {
+  hipEvent_t event = nullptr;
+  if (!free_events_.empty()) {
+    event = free_events_.back();
+    free_events_.pop_back();
+  } else if (hipEventCreateWithFlags(&event, hipEventDisableTiming) != hipSuccess) {
+    // No event to guard the chunk with; wait for the stream so it is immediately reusable
+    hipStreamSynchronize(stream);
+    return nullptr;
+  }
+
+  if (hipEventRecord(event, stream) != hipSuccess) {
+    free_events_.push_back(event);
+    hipStreamSynchronize(stream);
+    return nullptr;
+  }
+
+  // Chunks split from this one share the fence; the event is recycled once none of them needs it
+  auto* fence = new Fence{stream, event, next_fence_sequence_++};
+  return std::shared_ptr<Fence>(fence, [this](Fence* f) {
+    free_events_.push_back(f->event);
+    delete f;
+  });
+}
+
+bool BfcArena::Extend(size_t rounded_size) {
+  size_t available = config_.max_mem - std::min(config_.max_mem, static_cast<size_t>(stats_.total_allocated_bytes));
+  if (rounded_size > available) {
+    return false;
+  }
+
+  size_t region_size = rounded_size;
+  if (config_.extend_strategy == ArenaConfig::ExtendStrategy::kNextPowerOfTwo) {
+    region_size = next_region_size_;
+    while (region_size < rounded_size) {
+      region_size *= 2;
+    }
+  } else if (regions_.empty()) {
+    region_size = std::max(rounded_size, next_region_size_);
+  }
+  region_size = std::min(region_size, available);
+
+  void* ptr = raw_alloc_(region_size);
+  if (ptr == nullptr && region_size > rounded_size) {
+    // The device may still fit the request itself
+    region_size = rounded_size;
+    ptr = raw_alloc_(region_size);
+  }
+  if (ptr == nullptr) {
+    return false;
+  }
+
+  if (config_.extend_strategy == ArenaConfig::ExtendStrategy::kNextPowerOfTwo) {
+    next_region_size_ = std::max(next_region_size_, std::min(region_size * 2, config_.max_power_of_two_extend_bytes));
+  }
+
+  regions_.emplace_back(ptr, region_size);
+  stats_.num_arena_extensions++;
+  stats_.total_allocated_bytes += static_cast<int64_t>(region_size);
+
+  auto* chunk = new Chunk;
+  chunk->ptr = static_cast<char*>(ptr);
+  chunk->size = region_size;
+  chunks_[chunk->ptr] = chunk;
+  InsertFree(chunk);
+  return true;
+}
+
+void BfcArena::SplitChunk(Chunk* chunk, size_t size) {
+  auto* remainder = new Chunk;
+  remainder->ptr = chunk->ptr + size;
+  remainder->size = chunk->size - size;
+  remainder->fence = chunk->fence;
+  remainder->prev = chunk;
+  remainder->next = chunk->next;
+  if (chunk->next != nullptr) {
+    chunk->next->prev = remainder;
+  }
+
+  chunk->size = size;
+  chunk->next = remainder;
+
+  chunks_[remainder->ptr] = remainder;
+  InsertFree(remainder);
+}
+
+void BfcArena::InsertFree(Chunk* chunk) {
+  bins_[BinIndex(chunk->size)].insert(chunk);
+}
+
+void BfcArena::RemoveFree(Chunk* chunk) {
+  bins_[BinIndex(chunk->size)].erase(chunk);
+}
+
+bool BfcArena::CanMerge(Chunk* chunk, Chunk* neighbour) {
+  if (!chunk->fence || IsRetired(neighbour)) {
+    return true;
+  }
+  return neighbour->fence->stream == chunk->fence->stream;
+}
+
+/*static*/
+std::shared_ptr<BfcArena::Fence> BfcArena::LaterFence(const std::shared_ptr<Fence>& a,
+                                                      const std::shared_ptr<Fence>& b) {
+  // CanMerge only pairs fences on the same stream, where the later recorded one completes last
+  if (!a || !b) {
+    return a ? a : b;
+  }
+  return a->sequence > b->sequence ? a : b;
+}
+
+BfcArena::Chunk* BfcArena::Merge(Chunk* chunk, Chunk* next, std::shared_ptr<Fence> fence) {
+  chunk->fence = std::move(fence);
+  chunk->size += next->size;
+  chunk->next = next->next;
+  if (next->next != nullptr) {
+    next->next->prev = chunk;
+  }
+  DeleteChunk(next);
+  return chunk;
+}
+
+void BfcArena::DeleteChunk(Chunk* chunk) {
+  chunks_.erase(chunk->ptr);
+  delete chunk;
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,27 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/blaslt_handle.h"
+
+namespace hipdnn_ep {
+
+BlasLtHandle::~BlasLtHandle() {
+  if (handle_ != nullptr) {
+    hipblasLtDestroy(handle_);
+  }
+}
+
+hipblasStatus_t BlasLtHandle::Get(hipblasLtHandle_t& handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (handle_ == nullptr) {
+    hipblasStatus_t status = hipblasLtCreate(&handle_);
+    if (status != HIPBLAS_STATUS_SUCCESS) {
+      handle_ = nullptr;
+      return status;
+    }
+  }
+  handle = handle_;
+  return HIPBLAS_STATUS_SUCCESS;
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,137 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/conv_algo_cache.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace hipdnn_ep {
+
+namespace {
+
+constexpr const char* kCacheFileHeader = "# hipdnn_ep conv algo cache v1";
+
+void AppendDims(std::ostringstream& oss, const char* name, const std::vector<int64_t>& dims) {
+  oss << ';' << name << '=';
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (i > 0) {
+      oss << 'x';
+    }
+    oss << dims[i];
+  }
+}
+
+}  // namespace
+
+ConvAlgoCache::ConvAlgoCache(std::string path, std::string device_arch)
+    : path_(std::move(path)), device_arch_(std::move(device_arch)) {
+  // Solution ids are only meaningful for the MIOpen build that produced them.
+  size_t major = 0, minor = 0, patch = 0;
+  if (miopenGetVersion(&major, &minor, &patch) == miopenStatusSuccess) {
+    miopen_version_ = std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch);
+  }
+}
+
+bool ConvAlgoCache::Load() {
+  if (path_.empty()) {
+    return true;
+  }
+
+  std::ifstream file(path_);
+  if (!file.is_open()) {
+    return true;  // Nothing cached yet
+  }
+
+  std::unordered_map<std::string, Entry> loaded;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream iss(line);
+    std::string key;
+    Entry entry;
+    if (!(iss >> key >> entry.solution_id >> entry.workspace_size)) {
+      return false;
+    }
+
+    // Later lines win so that re-tuned entries appended to the file replace older ones.
+    loaded[key] = entry;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [key, entry] : loaded) {
+    entries_[key] = entry;
+  }
+
+  return true;
+}
+
+std::string ConvAlgoCache::MakeKey(miopenDataType_t data_type,
+                                   const std::vector<int64_t>& x_shape,
+                                   const std::vector<int64_t>& w_shape,
+                                   const std::vector<int64_t>& y_shape,
+                                   const std::vector<int64_t>& pads,
+                                   const std::vector<int64_t>& strides,
+                                   const std::vector<int64_t>& dilations,
+                                   int64_t group,
+                                   bool transposed) const {
+  std::ostringstream oss;
+  oss << Fingerprint() << ";dtype=" << static_cast<int>(data_type);
+  AppendDims(oss, "x", x_shape);
+  AppendDims(oss, "w", w_shape);
+  AppendDims(oss, "y", y_shape);
+  AppendDims(oss, "pads", pads);
+  AppendDims(oss, "strides", strides);
+  AppendDims(oss, "dilations", dilations);
+  oss << ";group=" << group;
+  if (transposed) {
+    oss << ";transposed";  // Appended only here so forward keys written by earlier versions still match
+  }
+  return oss.str();
+}
+
+std::string ConvAlgoCache::Fingerprint() const {
+  return "arch=" + device_arch_ + ";miopen=" + miopen_version_;
+}
+
+bool ConvAlgoCache::Lookup(const std::string& key, Entry& entry) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  entry = it->second;
+  return true;
+}
+
+bool ConvAlgoCache::Insert(const std::string& key, const Entry& entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_[key] = entry;
+
+  if (path_.empty()) {
+    return true;
+  }
+
+  // Append rather than rewrite so concurrent sessions never truncate each other's results.
+  bool write_header = !std::ifstream(path_).good();
+  std::ofstream file(path_, std::ios::app);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  if (write_header) {
+    file << kCacheFileHeader << '\n';
+  }
+  file << key << ' ' << entry.solution_id << ' ' << entry.workspace_size << '\n';
+  return file.good();
+}
+
+size_t ConvAlgoCache::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,517 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/conv_op.h"
+#include "hipdnn_ep/miopen_utils.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <sstream>
+
+namespace hipdnn_ep {
+
+namespace {
+
+// The MIOpen workspace after a padded copy of X starts at this alignment
+constexpr size_t kWorkspaceAlignment = 256;
+
+size_t ElementCount(const std::vector<int64_t>& shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t{1},
+                         [](size_t acc, int64_t dim) { return acc * static_cast<size_t>(dim); });
+}
+
+std::string FormatShape(const std::vector<int64_t>& shape) {
+  std::ostringstream oss;
+  oss << "[";
+  for (size_t i = 0; i < shape.size(); ++i) {
+    oss << (i > 0 ? ", " : "") << shape[i];
+  }
+  oss << "]";
+  return oss.str();
+}
+
+}  // namespace
+
+ConvOp::ConvOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<ConvOpInfo> info)
+    : Op(std::move(info)), ort_api_(ort_api), logger_(logger) {
+}
+
+ConvOp::~ConvOp() {
+  // Destroying the plan also releases its op descriptors
+  if (fusion_plan_) miopenDestroyFusionPlan(fusion_plan_);
+  if (activation_desc_) miopenDestroyActivationDescriptor(activation_desc_);
+  if (x_desc_) miopenDestroyTensorDescriptor(x_desc_);
+  if (w_desc_) miopenDestroyTensorDescriptor(w_desc_);
+  if (y_desc_) miopenDestroyTensorDescriptor(y_desc_);
+  if (b_desc_) miopenDestroyTensorDescriptor(b_desc_);
+  if (conv_desc_) miopenDestroyConvolutionDescriptor(conv_desc_);
+  if (folded_w_) hipFree(folded_w_);
+  if (folded_b_) hipFree(folded_b_);
+}
+
+OrtStatus* ConvOp::Compile(miopenHandle_t miopen_handle, ConvAlgoCache& algo_cache) {
+  const ConvOpInfo& info = ConvInfo();
+
+  RETURN_IF_ERROR(CreateDescriptors());
+  RETURN_IF_ERROR(UploadFoldedConstants());
+
+  // MIOpen's fusion plans only have forward convolution kernels
+  if (!info.transposed && (info.has_bias || activation_desc_ != nullptr)) {
+    CompileFusionPlan(miopen_handle);
+    if (IsFused()) {
+      return nullptr;
+    }
+  }
+
+  return CompileConvSolution(miopen_handle, algo_cache);
+}
+
+OrtStatus* ConvOp::Load(miopenHandle_t miopen_handle, ContextReader& reader, ConvAlgoCache& algo_cache,
+                        bool solutions_valid) {
+  const ConvOpInfo& info = ConvInfo();
+
+  int64_t fused = 0;
+  uint64_t solution_id = 0;
+  uint64_t workspace_size = 0;
+  if (!reader.Read(fused) || !reader.Read(solution_id) || !reader.Read(workspace_size)) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context for Conv " << info.node_name);
+  }
+
+  RETURN_IF_ERROR(CreateDescriptors());
+  RETURN_IF_ERROR(UploadFoldedConstants());
+
+  if (fused != 0) {
+    CompileFusionPlan(miopen_handle);
+    if (IsFused()) {
+      return nullptr;
+    }
+  } else if (solutions_valid) {
+    miopenStatus_t status = miopenConvolutionForwardCompileSolution(
+        miopen_handle, w_desc_, x_desc_, conv_desc_, y_desc_, solution_id);
+    if (status == miopenStatusSuccess) {
+      solution_id_ = solution_id;
+      workspace_size_ = static_cast<size_t>(workspace_size);
+      return nullptr;
+    }
+  }
+
+  // The saved choice doesn't apply to this device or MIOpen build
+  LOG(ort_api_, logger_, WARNING, "Conv " << info.node_name << ": EP context state is stale, selecting again");
+  return CompileConvSolution(miopen_handle, algo_cache);
+}
+
+void ConvOp::Serialize(ContextWriter& writer) const {
+  Op::Serialize(writer);
+  writer.Write(static_cast<int64_t>(IsFused()))
+      .Write(static_cast<uint64_t>(solution_id_))
+      .Write(static_cast<uint64_t>(workspace_size_));
+}
+
+OrtStatus* ConvOp::CreateDescriptors() {
+  const ConvOpInfo& info = ConvInfo();
+
+  const size_t rank = info.x_shape.size();
+  if (rank < 3 || rank > 5 || info.w_shape.size() != rank || info.y_shape.size() != rank ||
+      info.output_padding.size() != rank - 2) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Only 1D, 2D and 3D convolution are supported, node: " << info.node_name);
+  }
+
+  data_type_ = ToMIOpenDataType(info.dtype);
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << ": x=" << FormatShape(info.x_shape)
+                   << ", w=" << FormatShape(info.w_shape) << ", bias: " << info.has_bias << ", group: " << info.group
+              << ", activation: " << static_cast<int>(info.activation.kind));
+
+  std::vector<int64_t> x_shape = info.x_shape;
+  std::vector<int64_t> w_shape = info.w_shape;
+  std::vector<int64_t> y_shape = info.y_shape;
+  std::vector<int64_t> pads = info.pads;
+  std::vector<int64_t> strides = info.strides;
+  std::vector<int64_t> dilations = info.dilations;
+  std::vector<int64_t> output_padding = info.output_padding;
+  size_t spatial_dims = rank - 2;
+
+  if (spatial_dims == 1) {
+    // MIOpen has no 1D convolution: run it as 2D over an [N, C, 1, W] view of the same memory
+    x_shape.insert(x_shape.begin() + 2, 1);
+    w_shape.insert(w_shape.begin() + 2, 1);
+    y_shape.insert(y_shape.begin() + 2, 1);
+    pads = {0, info.pads[0], 0, info.pads[1]};
+    strides.insert(strides.begin(), 1);
+    dilations.insert(dilations.begin(), 1);
+    output_padding.insert(output_padding.begin(), 0);
+    spatial_dims = 2;
+  }
+
+  // MIOpen pads both ends of a dimension equally. Where SAME auto_pad (or explicit pads) put more at one
+  // end, conv_desc_ gets the smaller pad and Execute pads the difference into a copy of X.
+  pre_pad_ = PadParams{};
+  if (!info.transposed) {
+    std::vector<int64_t> padded_x_shape = x_shape;
+    for (size_t i = 0; i < spatial_dims; ++i) {
+      const int64_t begin = pads[i];
+      const int64_t end = pads[i + spatial_dims];
+      if (begin != end) {
+        pre_pad_.pads_begin[2 + i] = std::max<int64_t>(begin - end, 0);
+        padded_x_shape[2 + i] += std::abs(begin - end);
+        pads[i] = pads[i + spatial_dims] = std::min(begin, end);
+      }
+    }
+    if (padded_x_shape != x_shape) {
+      pre_pad_.rank = static_cast<int>(x_shape.size());
+      pre_pad_.count = static_cast<int64_t>(ElementCount(padded_x_shape));
+      std::copy(x_shape.begin(), x_shape.end(), pre_pad_.x_dims);
+      std::copy(padded_x_shape.begin(), padded_x_shape.end(), pre_pad_.y_dims);
+      x_shape = padded_x_shape;
+      LOG(ort_api_, logger_, VERBOSE,
+          info.op_type << " " << info.node_name << ": asymmetric pads, padding X to " << FormatShape(x_shape));
+    }
+  }
+
+  // Create tensor descriptors (NC[D]HW format)
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&x_desc_));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&w_desc_));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&y_desc_));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, SetPackedTensorDescriptor(x_desc_, data_type_, x_shape));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, SetPackedTensorDescriptor(w_desc_, data_type_, w_shape));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, SetPackedTensorDescriptor(y_desc_, data_type_, y_shape));
+
+  if (info.has_bias) {
+    // Bias is [C] (or a broadcastable per-channel constant), described as [1, C, 1, ...]
+    std::vector<int64_t> b_shape(x_shape.size(), 1);
+    b_shape[1] = y_shape[1];
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&b_desc_));
+    MIOPEN_RETURN_IF_ERROR(ort_api_, SetPackedTensorDescriptor(b_desc_, data_type_, b_shape));
+  }
+
+  // Create convolution descriptor. The pads are symmetric by now, so only the begin pads are used.
+  // For ConvTranspose MIOpen's transpose mode takes the ONNX weight layout as is.
+  std::vector<int> conv_pads(pads.begin(), pads.begin() + spatial_dims);
+  std::vector<int> conv_strides(strides.begin(), strides.end());
+  std::vector<int> conv_dilations(dilations.begin(), dilations.end());
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateConvolutionDescriptor(&conv_desc_));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenInitConvolutionNdDescriptor(
+      conv_desc_, static_cast<int>(spatial_dims), conv_pads.data(), conv_strides.data(), conv_dilations.data(),
+      info.transposed ? miopenTranspose : miopenConvolution));
+  if (info.transposed) {
+    std::vector<int> adjustments(output_padding.begin(), output_padding.end());
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetTransposeConvNdOutputPadding(
+        conv_desc_, static_cast<int>(spatial_dims), adjustments.data()));
+  }
+  if (info.group > 1) {
+    // MIOpen picks its depthwise kernels itself when group == C
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetConvolutionGroupCount(conv_desc_, static_cast<int>(info.group)));
+  }
+
+  if (info.activation.kind != Activation::Kind::kNone) {
+    ToMIOpenActivation(info.activation, activation_mode_, activation_alpha_, activation_beta_, activation_gamma_);
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateActivationDescriptor(&activation_desc_));
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetActivationDescriptor(
+        activation_desc_, activation_mode_, activation_alpha_, activation_beta_, activation_gamma_));
+  }
+
+  return nullptr;
+}
+
+OrtStatus* ConvOp::UploadFoldedConstants() {
+  const ConvOpInfo& info = ConvInfo();
+  if (!info.HasConstantWeights()) {
+    return nullptr;
+  }
+
+  auto upload = [&](const std::vector<float>& values, void*& buffer) -> OrtStatus* {
+    size_t size = values.size() * MIOpenDataTypeSize(data_type_);
+    HIP_RETURN_IF_ERROR(ort_api_, hipMalloc(&buffer, size));
+    if (data_type_ == miopenHalf) {
+      std::vector<Ort::Float16_t> halves(values.begin(), values.end());
+      HIP_RETURN_IF_ERROR(ort_api_, hipMemcpy(buffer, halves.data(), size, hipMemcpyHostToDevice));
+    } else {
+      HIP_RETURN_IF_ERROR(ort_api_, hipMemcpy(buffer, values.data(), size, hipMemcpyHostToDevice));
+    }
+    return nullptr;
+  };
+  RETURN_IF_ERROR(upload(info.constant_weights, folded_w_));
+  RETURN_IF_ERROR(upload(info.constant_bias, folded_b_));
+
+  LOG(ort_api_, logger_, VERBOSE, "Conv " << info.node_name << ": BatchNormalization folded into weights and bias");
+  return nullptr;
+}
+
+void ConvOp::CompileFusionPlan(miopenHandle_t miopen_handle) {
+  const ConvOpInfo& info = ConvInfo();
+
+  // Only combinations MIOpen has fused kernels for compile; everything else falls back
+  miopenStatus_t status = miopenCreateFusionPlan(&fusion_plan_, miopenVerticalFusion, x_desc_);
+  if (status == miopenStatusSuccess) {
+    status = miopenCreateOpConvForward(fusion_plan_, &conv_fusion_op_, conv_desc_, w_desc_);
+  }
+  if (status == miopenStatusSuccess && info.has_bias) {
+    status = miopenCreateOpBiasForward(fusion_plan_, &bias_fusion_op_, b_desc_);
+  }
+  if (status == miopenStatusSuccess && activation_desc_ != nullptr) {
+    status = miopenCreateOpActivationForward(fusion_plan_, &activation_fusion_op_, activation_mode_);
+  }
+  if (status == miopenStatusSuccess) {
+    status = miopenCompileFusionPlan(miopen_handle, fusion_plan_);
+  }
+
+  if (status != miopenStatusSuccess) {
+    LOG(ort_api_, logger_, VERBOSE,
+        "Conv " << info.node_name << ": no fused MIOpen kernel (status " << status
+                << "), running the epilogue separately");
+    if (fusion_plan_) miopenDestroyFusionPlan(fusion_plan_);
+    fusion_plan_ = nullptr;
+    conv_fusion_op_ = nullptr;
+    bias_fusion_op_ = nullptr;
+    activation_fusion_op_ = nullptr;
+    return;
+  }
+
+  LOG(ort_api_, logger_, VERBOSE, "Conv " << info.node_name << ": compiled MIOpen fusion plan");
+}
+
+OrtStatus* ConvOp::CompileConvSolution(miopenHandle_t miopen_handle, ConvAlgoCache& algo_cache) {
+  const ConvOpInfo& info = ConvInfo();
+
+  // Reuse a previously found solution for this problem so that repeated shapes and
+  // later sessions don't pay for another miopenFindConvolutionForwardAlgorithm.
+  std::string cache_key = algo_cache.MakeKey(data_type_, info.x_shape, info.w_shape, info.y_shape,
+                                             info.pads, info.strides, info.dilations, info.group, info.transposed);
+
+  ConvAlgoCache::Entry entry;
+  bool cached = algo_cache.Lookup(cache_key, entry);
+  if (cached) {
+    // A stale entry (e.g. written by a different MIOpen build) fails to compile; search again.
+    cached = miopenConvolutionForwardCompileSolution(
+                 miopen_handle, w_desc_, x_desc_, conv_desc_, y_desc_, entry.solution_id) == miopenStatusSuccess;
+    if (!cached) {
+      LOG(ort_api_, logger_, WARNING, "Cached conv solution " << entry.solution_id << " is invalid, re-running Find");
+    }
+  }
+
+  if (!cached) {
+    RETURN_IF_ERROR(FindConvSolution(miopen_handle, entry));
+
+    if (!algo_cache.Insert(cache_key, entry)) {
+      LOG(ort_api_, logger_, WARNING, "Failed to write conv algo cache: " << algo_cache.Path());
+    }
+
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenConvolutionForwardCompileSolution(
+        miopen_handle, w_desc_, x_desc_, conv_desc_, y_desc_, entry.solution_id));
+  }
+
+  solution_id_ = entry.solution_id;
+  workspace_size_ = entry.workspace_size;
+
+  LOG(ort_api_, logger_, VERBOSE,
+      "Conv solution " << solution_id_ << (cached ? " (cached)" : " (found)")
+                       << ", workspace size: " << workspace_size_);
+
+  return nullptr;
+}
+
+OrtStatus* ConvOp::FindConvSolution(miopenHandle_t miopen_handle, ConvAlgoCache::Entry& entry) {
+  const ConvOpInfo& info = ConvInfo();
+
+  // Find benchmarks every applicable solver, so it needs the worst-case workspace and real buffers.
+  size_t find_workspace_size = 0;
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenConvolutionForwardGetWorkSpaceSize(
+      miopen_handle,
+      w_desc_,
+      x_desc_,
+      conv_desc_,
+      y_desc_,
+      &find_workspace_size));
+
+  // Allocate temporary GPU buffers for finding algorithm
+  void* x_tmp = nullptr;
+  void* w_tmp = nullptr;
+  void* y_tmp = nullptr;
+  void* workspace_tmp = nullptr;
+
+  size_t element_size = MIOpenDataTypeSize(data_type_);
+  size_t x_size = (pre_pad_.count > 0 ? static_cast<size_t>(pre_pad_.count) : ElementCount(info.x_shape)) *
+                  element_size;
+  size_t w_size = ElementCount(info.w_shape) * element_size;
+  size_t y_size = ElementCount(info.y_shape) * element_size;
+
+  auto free_tmp = [&]() {
+    hipFree(x_tmp);
+    hipFree(w_tmp);
+    hipFree(y_tmp);
+    hipFree(workspace_tmp);
+  };
+
+  hipError_t hip_err = hipMalloc(&x_tmp, x_size);
+  if (hip_err == hipSuccess) {
+    hip_err = hipMalloc(&w_tmp, w_size);
+  }
+  if (hip_err == hipSuccess) {
+    hip_err = hipMalloc(&y_tmp, y_size);
+  }
+  if (hip_err == hipSuccess && find_workspace_size > 0) {
+    hip_err = hipMalloc(&workspace_tmp, find_workspace_size);
+  }
+  if (hip_err != hipSuccess) {
+    free_tmp();
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Failed to allocate buffers for Find: " << hipGetErrorString(hip_err));
+  }
+
+  // Find the best convolution algorithm. This also records the timings in MIOpen's find-db,
+  // which the solution query below returns in order of performance.
+  const int request_algo_count = 4;
+  int returned_algo_count = 0;
+  miopenConvAlgoPerf_t perf_results[request_algo_count];
+
+  LOG(ort_api_, logger_, INFO, "Finding convolution algorithm...");
+  miopenStatus_t find_status = miopenFindConvolutionForwardAlgorithm(
+      miopen_handle,
+      x_desc_,
+      x_tmp,
+      w_desc_,
+      w_tmp,
+      conv_desc_,
+      y_desc_,
+      y_tmp,
+      request_algo_count,
+      &returned_algo_count,
+      perf_results,
+      workspace_tmp,
+      find_workspace_size,
+      false  // exhaustiveSearch
+  );
+
+  // Free temporary buffers
+  free_tmp();
+
+  if (find_status != miopenStatusSuccess) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "miopenFindConvolutionForwardAlgorithm failed: " << find_status);
+  }
+
+  if (returned_algo_count == 0) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "No convolution algorithm found");
+  }
+
+  // Translate the winner into a solution id, which (unlike the algorithm enum) can be executed
+  // later through the immediate mode API without another Find.
+  size_t solution_count = 0;
+  miopenConvSolution_t solution;
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenConvolutionForwardGetSolution(
+      miopen_handle, w_desc_, x_desc_, conv_desc_, y_desc_, 1, &solution_count, &solution));
+
+  if (solution_count == 0) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "No convolution solution found");
+  }
+
+  entry.solution_id = solution.solution_id;
+  entry.workspace_size = solution.workspace_size;
+
+  LOG(ort_api_, logger_, INFO,
+      "Selected algorithm: " << perf_results[0].fwd_algo << ", time: " << perf_results[0].time << " ms");
+
+  return nullptr;
+}
+
+size_t ConvOp::PrePadSize() const {
+  if (pre_pad_.count == 0) {
+    return 0;
+  }
+  const size_t size = static_cast<size_t>(pre_pad_.count) * MIOpenDataTypeSize(data_type_);
+  return (size + kWorkspaceAlignment - 1) / kWorkspaceAlignment * kWorkspaceAlignment;
+}
+
+OrtStatus* ConvOp::Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                           const std::vector<void*>& outputs) const {
+  const void* x_ptr = inputs[0];
+  const void* w_ptr = folded_w_ != nullptr ? folded_w_ : inputs[1];
+  const void* b_ptr = folded_b_ != nullptr ? folded_b_ : (ConvInfo().has_bias ? inputs[2] : nullptr);
+  void* y_ptr = outputs[0];
+
+  // The padded copy of X takes the front of the workspace, and MIOpen the rest
+  ExecutionContext conv_ctx = ctx;
+  if (pre_pad_.count > 0) {
+    HIP_RETURN_IF_ERROR(ort_api_, LaunchPad(pre_pad_, MIOpenDataTypeSize(data_type_), x_ptr, ctx.workspace,
+                                            ctx.stream));
+    x_ptr = ctx.workspace;
+    conv_ctx.workspace = static_cast<char*>(ctx.workspace) + PrePadSize();
+  }
+
+  if (IsFused()) {
+    return ExecuteFused(conv_ctx, x_ptr, w_ptr, b_ptr, y_ptr);
+  }
+  return ExecuteUnfused(conv_ctx, x_ptr, w_ptr, b_ptr, y_ptr);
+}
+
+OrtStatus* ConvOp::ExecuteFused(const ExecutionContext& ctx, const void* x, const void* w, const void* b,
+                                void* y) const {
+  // Operator args hold this call's pointers, so they are per call rather than per plan
+  miopenOperatorArgs_t args = nullptr;
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateOperatorArgs(&args));
+  std::unique_ptr<miopenOperatorArgs, decltype(&miopenDestroyOperatorArgs)> args_guard(args, miopenDestroyOperatorArgs);
+
+  float alpha = 1.0f;
+  float beta = 0.0f;
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetOpArgsConvForward(args, conv_fusion_op_, &alpha, &beta, w));
+  if (bias_fusion_op_ != nullptr) {
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetOpArgsBiasForward(args, bias_fusion_op_, &alpha, &beta, b));
+  }
+  if (activation_fusion_op_ != nullptr) {
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetOpArgsActivForward(
+        args, activation_fusion_op_, &alpha, &beta, activation_alpha_, activation_beta_, activation_gamma_));
+  }
+
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenExecuteFusionPlan(
+      ctx.miopen_handle, fusion_plan_, x_desc_, x, y_desc_, y, args));
+
+  return nullptr;
+}
+
+OrtStatus* ConvOp::ExecuteUnfused(const ExecutionContext& ctx, const void* x, const void* w, const void* b,
+                                  void* y) const {
+  // Execute convolution: y = conv(x, w)
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenConvolutionForwardImmediate(
+      ctx.miopen_handle,
+      w_desc_,
+      w,
+      x_desc_,
+      x,
+      conv_desc_,
+      y_desc_,
+      y,
+      ctx.workspace,
+      workspace_size_,
+      solution_id_));
+
+  // Add bias if present: y = 1*y + 1*bias + 0*y
+  if (b != nullptr) {
+    float alpha1 = 1.0f;
+    float alpha2 = 1.0f;
+    float beta_op = 0.0f;
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenOpTensor(
+        ctx.miopen_handle,
+        miopenTensorOpAdd,
+        &alpha1,
+        y_desc_,
+        y,
+        &alpha2,
+        b_desc_,
+        b,
+        &beta_op,
+        y_desc_,
+        y));
+  }
+
+  // Activation in place: y = act(y)
+  if (activation_desc_ != nullptr) {
+    float alpha = 1.0f;
+    float beta = 0.0f;
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenActivationForward(
+        ctx.miopen_handle, activation_desc_, &alpha, y_desc_, y, &beta, y_desc_, y));
+  }
+
+  return nullptr;
+}
+
+}  // namespace hipdnn_ep
@@ -2,19 +2,29 @@
 // Licensed under the MIT License.
 
 #include "hipdnn_ep/ep.h"
+#include "hipdnn_ep/ep_context.h"
 #include "hipdnn_ep/ep_factory.h"
+#include "hipdnn_ep/ep_stream.h"
+#include "hipdnn_ep/gpu_backend.h"
+#include "hipdnn_ep/host_backend.h"
 #include "hipdnn_ep/kernel.h"
 #include "hipdnn_ep/node_compute_info.h"
+#include "hipdnn_ep/op_info.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_set>
 
 namespace hipdnn_ep {
 
 namespace {
 
-// Check if a Conv node is supported by this EP
+// Check if a Conv or ConvTranspose node is supported by this EP
 static bool IsSupportedConv(Ort::ConstNode node) {
   try {
+    const bool transposed = node.GetOperatorType() == "ConvTranspose";
     std::vector<Ort::ConstValueInfo> inputs = node.GetInputs();
     std::vector<Ort::ConstValueInfo> outputs = node.GetOutputs();
 
@@ -51,7 +61,7 @@ static bool IsSupportedConv(Ort::ConstNode node) {
       }
     }
 
-    // Check if it's a 2D convolution (4D tensors: NCHW)
+    // Check it's a 1D, 2D or 3D convolution (NCW, NCHW or NCDHW tensors)
     auto x_shape = GetTensorShape(inputs[0]);
     auto w_shape = GetTensorShape(inputs[1]);
 
@@ -59,28 +69,224 @@ static bool IsSupportedConv(Ort::ConstNode node) {
       return false;  // Dynamic shapes not supported yet
     }
 
-    if (x_shape->size() != 4 || w_shape->size() != 4) {
-      return false;  // Only 2D conv supported
+    if (x_shape->size() < 3 || x_shape->size() > 5 || w_shape->size() != x_shape->size()) {
+      return false;
     }
+    const size_t spatial_dims = x_shape->size() - 2;
 
-    // Check auto_pad - only NOTSET supported (explicit padding)
-    std::string auto_pad = GetStringAttrOrDefault(node, "auto_pad", "NOTSET");
-    if (auto_pad != "NOTSET") {
+    // Check strides and dilations - one positive value per spatial dimension
+    std::vector<int64_t> strides = GetIntsAttrOrDefault(node, "strides", std::vector<int64_t>(spatial_dims, 1));
+    std::vector<int64_t> dilations = GetIntsAttrOrDefault(node, "dilations", std::vector<int64_t>(spatial_dims, 1));
+    if (strides.size() != spatial_dims || dilations.size() != spatial_dims) {
       return false;
     }
+    for (size_t i = 0; i < spatial_dims; ++i) {
+      if (strides[i] < 1 || dilations[i] < 1) {
+        return false;
+      }
+    }
 
-    // Check group - only 1 supported (no grouped/depthwise convolutions)
+    // Check padding - the pads (explicit or resolved from auto_pad) must resolve. Conv pads may differ
+    // between the ends of a dimension: the GPU backend pads the excess into a copy of X. ConvTranspose may
+    // crop less at the end, which becomes extra output padding; that must stay below the stride or
+    // dilation as ONNX requires.
+    std::vector<int64_t> pads;
+    if (!transposed) {
+      if (!ResolveConvPads(node, *x_shape, *w_shape, pads)) {
+        return false;
+      }
+    } else {
+      std::vector<int64_t> output_padding;
+      if (!ResolveConvTransposePads(node, *x_shape, *w_shape, pads, output_padding)) {
+        return false;
+      }
+      for (size_t i = 0; i < spatial_dims; ++i) {
+        int64_t adjustment = output_padding[i] + pads[i] - pads[i + spatial_dims];
+        if (pads[i] < pads[i + spatial_dims] || adjustment < 0 ||
+            adjustment >= std::max(strides[i], dilations[i])) {
+          return false;
+        }
+      }
+    }
+
+    // Check group - channels must split evenly into groups (group == C covers depthwise convolutions).
+    // Conv weights are [C_out, C_in / group, k...], ConvTranspose weights [C_in, C_out / group, k...].
     int64_t group = GetIntAttrOrDefault(node, "group", 1);
-    if (group != 1) {
+    int64_t in_channels = (*x_shape)[1];
+    if (group < 1 || in_channels % group != 0) {
+      return false;
+    }
+    if (transposed ? (*w_shape)[0] != in_channels
+                   : ((*w_shape)[0] % group != 0 || (*w_shape)[1] * group != in_channels)) {
+      return false;
+    }
+
+    return true;
+
+  } catch (...) {
+    return false;
+  }
+}
+
+// Check if a MatMul or Gemm node is supported by this EP
+static bool IsSupportedMatMul(Ort::ConstNode node) {
+  try {
+    const bool gemm = node.GetOperatorType() == "Gemm";
+    std::vector<Ort::ConstValueInfo> inputs = node.GetInputs();
+    std::vector<Ort::ConstValueInfo> outputs = node.GetOutputs();
+
+    // MatMul takes exactly A and B, Gemm optionally C
+    if (inputs.size() < 2 || inputs.size() > (gemm ? 3u : 2u) || outputs.size() != 1) {
+      return false;
+    }
+
+    // Check data types - we support float and float16
+    ONNXTensorElementDataType a_type = GetTensorElementType(inputs[0]);
+    ONNXTensorElementDataType b_type = GetTensorElementType(inputs[1]);
+    ONNXTensorElementDataType y_type = GetTensorElementType(outputs[0]);
+    bool supported_type =
+        (a_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT ||
+         a_type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) &&
+        a_type == b_type && a_type == y_type;
+    if (!supported_type || (inputs.size() == 3 && inputs[2] && GetTensorElementType(inputs[2]) != a_type)) {
+      return false;
+    }
+
+    // Output shape must be static so intermediates can be planned
+    if (!GetTensorShape(outputs[0]).has_value()) {
+      return false;
+    }
+
+    // Check the shapes map onto one strided batched GEMM (Gemm: C must be a row bias or a full matrix)
+    MatMulShape shape;
+    if (gemm) {
+      MatMulOpInfo::Addend addend;
+      return ResolveGemmShape(node, shape, addend);
+    }
+
+    auto a_shape = GetTensorShape(inputs[0]);
+    auto b_shape = GetTensorShape(inputs[1]);
+    if (!a_shape.has_value() || !b_shape.has_value()) {
+      return false;  // Dynamic shapes not supported yet
+    }
+    return ResolveMatMulShape(*a_shape, *b_shape, shape);
+
+  } catch (...) {
+    return false;
+  }
+}
+
+// Check if a MaxPool, AveragePool, GlobalMaxPool or GlobalAveragePool node is supported by this EP
+static bool IsSupportedPool(Ort::ConstNode node) {
+  try {
+    const std::string op_type = node.GetOperatorType();
+    const bool global = op_type == "GlobalMaxPool" || op_type == "GlobalAveragePool";
+    std::vector<Ort::ConstValueInfo> inputs = node.GetInputs();
+    std::vector<Ort::ConstValueInfo> outputs = node.GetOutputs();
+
+    // MaxPool's optional Indices output is not produced
+    if (inputs.size() != 1 || outputs.empty() || !outputs[0] || (outputs.size() > 1 && outputs[1])) {
       return false;
     }
 
-    // Check dilations - only [1,1] supported (no dilated convolutions)
-    std::vector<int64_t> dilations = GetIntsAttrOrDefault(node, "dilations", {1, 1});
-    if (dilations.size() != 2 || dilations[0] != 1 || dilations[1] != 1) {
+    // Check data types - we support float and float16
+    ONNXTensorElementDataType x_type = GetTensorElementType(inputs[0]);
+    if ((x_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT && x_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) ||
+        GetTensorElementType(outputs[0]) != x_type) {
       return false;
     }
 
+    // Check it's 1D, 2D or 3D pooling with static shapes
+    auto x_shape = GetTensorShape(inputs[0]);
+    auto y_shape = GetTensorShape(outputs[0]);
+    if (!x_shape.has_value() || !y_shape.has_value()) {
+      return false;  // Dynamic shapes not supported yet
+    }
+    if (x_shape->size() < 3 || x_shape->size() > 5 || y_shape->size() != x_shape->size()) {
+      return false;
+    }
+    if (global) {
+      return true;
+    }
+    const size_t spatial_dims = x_shape->size() - 2;
+
+    // Check window, strides and dilations - MIOpen pooling has no dilation
+    std::vector<int64_t> kernel_shape = GetIntsAttrOrDefault(node, "kernel_shape", {});
+    std::vector<int64_t> strides = GetIntsAttrOrDefault(node, "strides", std::vector<int64_t>(spatial_dims, 1));
+    std::vector<int64_t> dilations = GetIntsAttrOrDefault(node, "dilations", std::vector<int64_t>(spatial_dims, 1));
+    if (kernel_shape.size() != spatial_dims || strides.size() != spatial_dims || dilations.size() != spatial_dims) {
+      return false;
+    }
+    for (size_t i = 0; i < spatial_dims; ++i) {
+      if (kernel_shape[i] < 1 || strides[i] < 1 || dilations[i] != 1) {
+        return false;
+      }
+    }
+
+    // Check padding - symmetric, as MIOpen pads both ends of a dimension equally, and smaller than the window
+    // so no window lies entirely in the padding. ceil_mode needs no check: the output is described with the
+    // node's (ceil) shape.
+    std::vector<int64_t> pads;
+    if (!ResolvePoolPads(node, *x_shape, pads)) {
+      return false;
+    }
+    for (size_t i = 0; i < spatial_dims; ++i) {
+      if (pads[i] != pads[i + spatial_dims] || pads[i] >= kernel_shape[i]) {
+        return false;
+      }
+    }
+
+    return true;
+
+  } catch (...) {
+    return false;
+  }
+}
+
+// Check if an elementwise node from the pointwise op table is supported by this EP
+static bool IsSupportedPointwise(Ort::ConstNode node) {
+  try {
+    PointwiseFunc func;
+    float alpha = 0.0f;
+    float beta = 0.0f;
+    size_t arity = 0;
+    if (!ParsePointwiseOp(node, func, alpha, beta) || !LookupPointwiseOp(node.GetOperatorType(), func, arity)) {
+      return false;
+    }
+
+    std::vector<Ort::ConstValueInfo> inputs = node.GetInputs();
+    std::vector<Ort::ConstValueInfo> outputs = node.GetOutputs();
+    if (inputs.size() < arity || outputs.size() != 1) {
+      return false;
+    }
+
+    // Check data types - we support float and float16, the same for every tensor
+    ONNXTensorElementDataType y_type = GetTensorElementType(outputs[0]);
+    if (y_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT && y_type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) {
+      return false;
+    }
+
+    // Check static shapes that broadcast numpy-style to the output
+    auto y_shape = GetTensorShape(outputs[0]);
+    if (!y_shape.has_value() || y_shape->size() > static_cast<size_t>(PointwiseParams::kMaxRank)) {
+      return false;
+    }
+    for (size_t i = 0; i < arity; ++i) {
+      if (!inputs[i] || GetTensorElementType(inputs[i]) != y_type) {
+        return false;
+      }
+      auto shape = GetTensorShape(inputs[i]);
+      if (!shape.has_value() || shape->size() > y_shape->size()) {
+        return false;
+      }
+      const size_t offset = y_shape->size() - shape->size();
+      for (size_t d = 0; d < shape->size(); ++d) {
+        if ((*shape)[d] != (*y_shape)[d + offset] && (*shape)[d] != 1) {
+          return false;
+        }
+      }
+    }
+
     return true;
 
   } catch (...) {
@@ -92,14 +298,228 @@ static bool IsSupportedConv(Ort::ConstNode node) {
 static bool IsSupportedOp(Ort::ConstNode node) {
   std::string op_type = node.GetOperatorType();
 
-  if (op_type == "Conv") {
+  if (op_type == "Conv" || op_type == "ConvTranspose") {
     return IsSupportedConv(node);
   }
+  if (op_type == "MatMul" || op_type == "Gemm") {
+    return IsSupportedMatMul(node);
+  }
+  if (op_type == "MaxPool" || op_type == "AveragePool" || op_type == "GlobalMaxPool" ||
+      op_type == "GlobalAveragePool") {
+    return IsSupportedPool(node);
+  }
+  PointwiseFunc func;
+  size_t arity = 0;
+  if (LookupPointwiseOp(op_type, func, arity)) {
+    return IsSupportedPointwise(node);
+  }
 
   // Add more operations here as we implement them
   return false;
 }
 
+// Check if the EP's backend runs the node's data type. Every supported op computes in the type of its output.
+static bool IsSupportedByBackend(const Backend& backend, Ort::ConstNode node) {
+  std::vector<Ort::ConstValueInfo> outputs = node.GetOutputs();
+  return !outputs.empty() && outputs[0] && backend.SupportsDataType(GetTensorElementType(outputs[0]));
+}
+
+// Groups the supported nodes into partitions ORT can fuse, as large as one greedy pass allows. Each
+// partition is connected, and no path leaves it and re-enters it, which would put the fused node on a
+// cycle. Independent unsupported nodes feeding a partition (e.g. a Reshape of a constant) don't split it.
+std::vector<std::vector<Ort::ConstNode>> CreateSupportedPartitions(
+    const std::vector<Ort::ConstNode>& nodes, const std::unordered_set<size_t>& supported_ids) {
+  const size_t num_nodes = nodes.size();
+
+  std::unordered_map<size_t, size_t> node_index;  // node id -> index in `nodes`
+  for (size_t i = 0; i < num_nodes; ++i) {
+    node_index[nodes[i].GetId()] = i;
+  }
+
+  // Data edges between nodes of this graph
+  std::vector<std::vector<size_t>> consumers(num_nodes);
+  std::vector<std::vector<size_t>> producers(num_nodes);
+  std::vector<size_t> in_degree(num_nodes, 0);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    for (const auto& output : nodes[i].GetOutputs()) {
+      if (!output) {
+        continue;
+      }
+      for (const auto& consumer : output.GetConsumers()) {
+        if (!consumer.node) {
+          continue;
+        }
+        auto it = node_index.find(consumer.node.GetId());
+        if (it != node_index.end()) {
+          consumers[i].push_back(it->second);
+          producers[it->second].push_back(i);
+          ++in_degree[it->second];
+        }
+      }
+    }
+  }
+
+  // Topological order, so partitions list their nodes in an order they can run in
+  std::vector<size_t> order;
+  std::deque<size_t> ready;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (in_degree[i] == 0) {
+      ready.push_back(i);
+    }
+  }
+  while (!ready.empty()) {
+    size_t i = ready.front();
+    ready.pop_front();
+    order.push_back(i);
+    for (size_t consumer : consumers[i]) {
+      if (--in_degree[consumer] == 0) {
+        ready.push_back(consumer);
+      }
+    }
+  }
+  // Merge in one greedy pass over the topological order: each supported node joins the partitions of its
+  // supported producers unless that creates a cycle, else it starts a new partition. Partition ids form a
+  // union-find set holding the ids merged into it and the producers feeding it from outside.
+  // reach[i] has a bit for every partition id with a node that reaches node i, so whether a partition
+  // reaches a node is a bitset test instead of a graph search.
+  constexpr size_t kNoPartition = SIZE_MAX;
+  std::vector<size_t> node_partition(num_nodes, kNoPartition);
+  std::vector<size_t> parent;
+  std::vector<std::vector<size_t>> merged_ids;
+  std::vector<std::vector<size_t>> entry_producers;
+  std::vector<std::vector<uint64_t>> reach(num_nodes);
+  std::function<size_t(size_t)> find_root = [&](size_t id) {
+    return parent[id] == id ? id : (parent[id] = find_root(parent[id]));
+  };
+  auto partition_of = [&](size_t i) {
+    return node_partition[i] == kNoPartition ? kNoPartition : find_root(node_partition[i]);
+  };
+  auto is_supported = [&](size_t i) { return supported_ids.count(nodes[i].GetId()) != 0; };
+  auto set_bit = [](std::vector<uint64_t>& bits, size_t id) {
+    if (bits.size() <= id / 64) {
+      bits.resize(id / 64 + 1, 0);
+    }
+    bits[id / 64] |= uint64_t{1} << (id % 64);
+  };
+  auto ids_of = [&](size_t root) {
+    std::vector<uint64_t> bits;
+    for (size_t id : merged_ids[root]) {
+      set_bit(bits, id);
+    }
+    return bits;
+  };
+  auto intersects = [](const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    for (size_t w = 0; w < std::min(a.size(), b.size()); ++w) {
+      if (a[w] & b[w]) {
+        return true;
+      }
+    }
+    return false;
+  };
+  // Whether producer `q`, outside the partition with ids `bits`, is reached from it: a path would leave
+  // the partition at `q` and re-enter it
+  auto leaves_and_reenters = [&](size_t q, size_t a, size_t b, const std::vector<uint64_t>& bits) {
+    size_t root = partition_of(q);
+    return (root == kNoPartition || (root != a && root != b)) && intersects(reach[q], bits);
+  };
+
+  for (size_t i : order) {
+    for (size_t q : producers[i]) {
+      if (reach[q].size() > reach[i].size()) {
+        reach[i].resize(reach[q].size(), 0);
+      }
+      for (size_t w = 0; w < reach[q].size(); ++w) {
+        reach[i][w] |= reach[q][w];
+      }
+      if (node_partition[q] != kNoPartition) {
+        set_bit(reach[i], node_partition[q]);
+      }
+    }
+    if (!is_supported(i)) {
+      continue;
+    }
+
+    size_t root = kNoPartition;
+    std::vector<uint64_t> root_ids;
+    for (size_t p : producers[i]) {
+      size_t candidate = partition_of(p);
+      if (candidate == kNoPartition || candidate == root) {
+        continue;
+      }
+      std::vector<uint64_t> candidate_ids = ids_of(candidate);
+      std::vector<uint64_t> merged = candidate_ids;
+      merged.resize(std::max(merged.size(), root_ids.size()), 0);
+      for (size_t w = 0; w < root_ids.size(); ++w) {
+        merged[w] |= root_ids[w];
+      }
+      // Paths into `i` from outside the merged partition, then paths between the two partitions. Nodes
+      // after `i` can't reach either, so nothing else can close a cycle.
+      bool cycle = std::any_of(producers[i].begin(), producers[i].end(),
+                               [&](size_t q) { return leaves_and_reenters(q, root, candidate, merged); });
+      if (!cycle && root != kNoPartition) {
+        cycle = std::any_of(entry_producers[root].begin(), entry_producers[root].end(),
+                            [&](size_t q) { return leaves_and_reenters(q, root, candidate, candidate_ids); }) ||
+                std::any_of(entry_producers[candidate].begin(), entry_producers[candidate].end(),
+                            [&](size_t q) { return leaves_and_reenters(q, root, candidate, root_ids); });
+      }
+      if (cycle) {
+        continue;
+      }
+
+      if (root == kNoPartition) {
+        root = candidate;
+      } else {
+        size_t a = root;
+        size_t b = candidate;
+        if (merged_ids[a].size() < merged_ids[b].size()) {
+          std::swap(a, b);
+        }
+        parent[b] = a;
+        merged_ids[a].insert(merged_ids[a].end(), merged_ids[b].begin(), merged_ids[b].end());
+        entry_producers[a].insert(entry_producers[a].end(), entry_producers[b].begin(), entry_producers[b].end());
+        merged_ids[b].clear();
+        entry_producers[b].clear();
+        root = a;
+        // Producers of one merged partition that were in the other no longer feed it from outside
+        auto& entries = entry_producers[root];
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&](size_t q) { return partition_of(q) == root; }),
+                      entries.end());
+      }
+      root_ids = std::move(merged);
+    }
+
+    if (root == kNoPartition) {
+      root = parent.size();
+      parent.push_back(root);
+      merged_ids.push_back({root});
+      entry_producers.emplace_back();
+    }
+    node_partition[i] = root;
+    for (size_t q : producers[i]) {
+      if (partition_of(q) != root) {
+        entry_producers[root].push_back(q);
+      }
+    }
+  }
+
+  // Partitions in topological order of their first node, each with its nodes in topological order
+  std::vector<std::vector<Ort::ConstNode>> partitions;
+  std::unordered_map<size_t, size_t> root_partition;  // root -> index in `partitions`
+  for (size_t i : order) {
+    if (!is_supported(i)) {
+      continue;
+    }
+    auto [it, inserted] = root_partition.emplace(partition_of(i), partitions.size());
+    if (inserted) {
+      partitions.emplace_back();
+    }
+    partitions[it->second].push_back(nodes[i]);
+  }
+
+  return partitions;
+}
+
 }  // namespace
 
 HipDNNEp::HipDNNEp(HipDNNEpFactory& factory, const Config& config, const OrtLogger& logger)
@@ -124,6 +544,19 @@ HipDNNEp::HipDNNEp(HipDNNEpFactory& factory, const Config& config, const OrtLogg
       &logger_, ORT_LOGGING_LEVEL_INFO,
       (std::string("MIOpen EP created: ") + factory_.GetName(&factory_)).c_str(),
       EP_FILE, __LINE__, __FUNCTION__));
+
+  if (config_.host_backend) {
+    backend_ = std::make_unique<HostBackend>(ort_api, logger_, config_.host_threads);
+  } else {
+    // Without a session stream kernels still work, compiling on the null stream
+    Ort::Status status{SessionStream::Create(ort_api, factory_.GetDeviceId(), session_stream_)};
+    if (!status.IsOK()) {
+      LOG(ort_api, logger_, WARNING, "HipDNN EP: No session stream: " << status.GetErrorMessage());
+    }
+    backend_ = std::make_unique<GpuBackend>(ort_api, logger_, config_.conv_algo_cache_path,
+                                            factory_.GetDeviceArch(),
+                                            session_stream_ ? session_stream_->Get() : nullptr);
+  }
 }
 
 HipDNNEp::~HipDNNEp() {
@@ -159,34 +592,67 @@ OrtStatus* ORT_API_CALL HipDNNEp::GetCapabilityImpl(
       return nullptr;
     }
 
-    std::vector<Ort::ConstNode> supported_nodes;
+    OrtNodeFusionOptions node_fusion_options = {};
+    node_fusion_options.ort_version_supported = ORT_API_VERSION;
+    node_fusion_options.drop_constant_initializers = false;  // We need weights
+
+    // EPContext nodes exported by this EP are claimed one by one; each holds a whole compiled partition
+    const std::string ep_name = ep->factory_.GetName(&ep->factory_);
+    size_t num_ep_context_nodes = 0;
+    for (const auto& node : nodes) {
+      if (IsEpContextNode(node, ep_name)) {
+        const OrtNode* node_ptr = node;
+        RETURN_IF_ERROR(ep->ep_api.EpGraphSupportInfo_AddNodesToFuse(graph_support_info, &node_ptr, 1,
+                                                                     &node_fusion_options));
+        ++num_ep_context_nodes;
+      }
+    }
+    if (num_ep_context_nodes > 0) {
+      LOG(ep->ort_api, ep->logger_, INFO, "HipDNN EP: Found " << num_ep_context_nodes << " EP context nodes");
+    }
 
+    // A BatchNormalization is only supported folded into its Conv. Bias Adds and activations also run on
+    // their own, but where they follow a Conv, MatMul or Gemm they are fused into it when compiled.
+    std::unordered_set<size_t> supported_ids;
     for (const auto& node : nodes) {
-      if (IsSupportedOp(node)) {
-        supported_nodes.push_back(node);
+      if (!IsSupportedOp(node) || !IsSupportedByBackend(*ep->backend_, node)) {
+        continue;
+      }
+      supported_ids.insert(node.GetId());
+      std::string op_type = node.GetOperatorType();
+      if (op_type == "Conv" || op_type == "ConvTranspose") {
+        for (const auto& fused_node : MatchConvFusion(node).Nodes()) {
+          supported_ids.insert(fused_node.GetId());
+        }
+      } else if (op_type == "MatMul" || op_type == "Gemm") {
+        for (const auto& fused_node : MatchMatMulFusion(node).Nodes()) {
+          supported_ids.insert(fused_node.GetId());
+        }
       }
     }
 
-    if (supported_nodes.empty()) {
+    if (supported_ids.empty()) {
       return nullptr;
     }
 
-    LOG(ep->ort_api, ep->logger_, INFO,
-        "HipDNN EP: Found " << supported_nodes.size() << " supported nodes");
+    std::vector<std::vector<Ort::ConstNode>> partitions = CreateSupportedPartitions(nodes, supported_ids);
 
-    // For now, claim nodes individually (no fusion)
-    // TODO: Add fusion support for Conv+Bias+Relu patterns
-    for (const auto& node : supported_nodes) {
-      OrtNodeFusionOptions node_fusion_options = {};
-      node_fusion_options.ort_version_supported = ORT_API_VERSION;
-      node_fusion_options.drop_constant_initializers = false;  // We need weights
+    LOG(ep->ort_api, ep->logger_, INFO,
+        "HipDNN EP: Found " << supported_ids.size() << " supported nodes in " << partitions.size()
+                            << " partitions");
+
+    // Each partition becomes one compiled Kernel, so values flowing between its nodes never
+    // leave the device or pass back through ORT.
+    for (const auto& partition : partitions) {
+      std::vector<const OrtNode*> node_ptrs;
+      for (const auto& node : partition) {
+        node_ptrs.push_back(static_cast<const OrtNode*>(node));
+      }
 
-      // ConstNode has implicit conversion to const OrtNode*
-      const OrtNode* node_ptr = static_cast<const OrtNode*>(node);
       RETURN_IF_ERROR(ep->ep_api.EpGraphSupportInfo_AddNodesToFuse(
           graph_support_info,
-          &node_ptr,
-          1,
+          node_ptrs.data(),
+          node_ptrs.size(),
           &node_fusion_options));
     }
 
@@ -208,9 +674,10 @@ OrtStatus* ORT_API_CALL HipDNNEp::CompileImpl(
     const OrtNode** fused_nodes,
     size_t count,
     OrtNodeComputeInfo** node_compute_infos,
-    OrtNode** /*ep_context_nodes*/) noexcept {
+    OrtNode** ep_context_nodes) noexcept {
   try {
     auto* ep = static_cast<HipDNNEp*>(this_ptr);
+    const std::string ep_name = ep->factory_.GetName(&ep->factory_);
 
     for (size_t i = 0; i < count; ++i) {
       Ort::ConstGraph graph{ort_graphs[i]};
@@ -221,13 +688,26 @@ OrtStatus* ORT_API_CALL HipDNNEp::CompileImpl(
         RETURN_ERROR(ep->ort_api, ORT_EP_FAIL, "Empty graph provided for compilation");
       }
 
-      // Create kernel and build/compile using MIOpen
-      auto kernel = std::make_unique<Kernel>(ep->ort_api, ep->logger_);
-      RETURN_IF_ERROR(kernel->BuildAndCompile(graph));
+      // Create kernel and build/compile it for the EP's backend, or restore it from an EP context node
+      auto kernel = std::make_unique<Kernel>(ep->ort_api, ep->logger_, *ep->backend_);
+      if (nodes.size() == 1 && IsEpContextNode(nodes[0], ep_name)) {
+        if (GetIntAttrOrDefault(nodes[0], "embed_mode", 1) != 1) {
+          RETURN_ERROR(ep->ort_api, ORT_EP_FAIL, "HipDNN EP only supports embedded EP contexts (embed_mode=1)");
+        }
+        RETURN_IF_ERROR(kernel->LoadFromContext(GetStringAttrOrDefault(nodes[0], "ep_cache_context", "")));
+      } else {
+        RETURN_IF_ERROR(kernel->BuildAndCompile(graph));
+      }
+
+      if (ep->config_.enable_ep_context && ep_context_nodes != nullptr) {
+        std::string context;
+        RETURN_IF_ERROR(kernel->Serialize(context));
+        RETURN_IF_ERROR(CreateEpContextNode(*ep, fused_node, ep_name, context, &ep_context_nodes[i]));
+      }
 
       std::string fused_node_name = fused_node.GetName();
       ep->kernels_.emplace(fused_node_name, std::move(kernel));
-      std::cerr << "HipDNNEp::CompileImpl: " << fused_node_name << std::endl;
+      LOG(ep->ort_api, ep->logger_, VERBOSE, "Compiled fused node " << fused_node_name);
 
       // Create node compute info
       auto compute_info = std::make_unique<NodeComputeInfo>(*ep);
@@ -266,12 +746,11 @@ OrtStatus* ORT_API_CALL HipDNNEp::CreateAllocatorImpl(
 
 /*static*/
 OrtStatus* ORT_API_CALL HipDNNEp::CreateSyncStreamForDeviceImpl(
-    OrtEp* /*this_ptr*/,
-    const OrtMemoryDevice* /*memory_device*/,
+    OrtEp* this_ptr,
+    const OrtMemoryDevice* memory_device,
     OrtSyncStreamImpl** stream) noexcept {
-  // TODO: Implement stream support
-  *stream = nullptr;
-  return nullptr;
+  auto* ep = static_cast<HipDNNEp*>(this_ptr);
+  return ep->factory_.CreateSyncStream(memory_device, stream, ep->session_stream_);
 }
 
 /*static*/
@@ -279,7 +758,8 @@ OrtStatus* ORT_API_CALL HipDNNEp::GetKernelRegistryImpl(
     OrtEp* this_ptr,
     const OrtKernelRegistry** kernel_registry) noexcept {
   auto* ep = static_cast<HipDNNEp*>(this_ptr);
-  *kernel_registry = ep->factory_.GetKernelRegistry();
+  // The registry holds the host <-> device copy kernels; the host backend's tensors already live on the host
+  *kernel_registry = ep->config_.host_backend ? nullptr : ep->factory_.GetKernelRegistry();
   return nullptr;
 }
 
@@ -2,105 +2,89 @@
 // Licensed under the MIT License.
 
 #include "hipdnn_ep/ep_allocator.h"
+#include "hipdnn_ep/ep_stream.h"
 #include <hip/hip_runtime.h>
 
-#include <iostream>
-
 namespace hipdnn_ep {
 
 namespace {
 
 static void StatsToKeyValuePairs(const AllocatorStats& stats, const OrtApi& api, OrtKeyValuePairs* kvps) {
-  if (stats.num_allocs > 0) {
+  if (stats.num_allocs > 0 || stats.num_reserves > 0) {
     api.AddKeyValuePair(kvps, "InUse", std::to_string(stats.bytes_in_use).c_str());
     api.AddKeyValuePair(kvps, "TotalAllocated", std::to_string(stats.total_allocated_bytes).c_str());
     api.AddKeyValuePair(kvps, "MaxInUse", std::to_string(stats.max_bytes_in_use).c_str());
     api.AddKeyValuePair(kvps, "NumAllocs", std::to_string(stats.num_allocs).c_str());
+    api.AddKeyValuePair(kvps, "NumReserves", std::to_string(stats.num_reserves).c_str());
+    api.AddKeyValuePair(kvps, "NumArenaExtensions", std::to_string(stats.num_arena_extensions).c_str());
     api.AddKeyValuePair(kvps, "MaxAllocSize", std::to_string(stats.max_alloc_size).c_str());
   }
 }
 
 }  // namespace
 
-HipDeviceAllocator::HipDeviceAllocator(const OrtMemoryInfo* mem_info, const ApiPtrs& api_ptrs, int device_id)
-    : memory_info_(mem_info), api_ptrs_(api_ptrs), device_id_(device_id) {
+HipDeviceAllocator::HipDeviceAllocator(const OrtMemoryInfo* mem_info, const ApiPtrs& api_ptrs,
+                                       const OrtLogger& logger, int device_id, const ArenaConfig& arena_config)
+    : memory_info_(mem_info), api_ptrs_(api_ptrs), logger_(logger), device_id_(device_id) {
   version = ORT_API_VERSION;
   Alloc = AllocImpl;
   Free = FreeImpl;
   Info = InfoImpl;
-  Reserve = AllocImpl;  // No special reserve logic
+  Reserve = ReserveImpl;
   GetStats = GetStatsImpl;
-  AllocOnStream = nullptr;  // TODO: Add stream-aware allocation
+  AllocOnStream = AllocOnStreamImpl;
+
+  // Only the arena talks to the driver, and only when it has to grow
+  auto raw_alloc = [device_id](size_t size) -> void* {
+    if (hipSetDevice(device_id) != hipSuccess) {
+      return nullptr;
+    }
+    void* ptr = nullptr;
+    if (hipMalloc(&ptr, size) != hipSuccess) {
+      return nullptr;
+    }
+    return ptr;
+  };
+  auto raw_free = [device_id](void* ptr) {
+    hipSetDevice(device_id);
+    hipFree(ptr);
+  };
+  arena_ = std::make_unique<BfcArena>(arena_config, raw_alloc, raw_free);
 }
 
 /*static*/
 void* ORT_API_CALL HipDeviceAllocator::AllocImpl(struct OrtAllocator* this_, size_t size) {
   auto& impl = *static_cast<HipDeviceAllocator*>(this_);
-  std::cerr << "HipDeviceAllocator::AllocImpl: " << impl.stats_.num_allocs << ", " << size << std::endl;
-
-  // TODO: Make allocator stream-aware. Currently using hipSetDevice which is
-  // ad-hoc and affects per-thread state. Should use hipMallocAsync with a
-  // device-specific stream instead.
-  hipError_t err = hipSetDevice(impl.device_id_);
-  if (err != hipSuccess) {
-    // Can't return error from Alloc, return nullptr
-    std::cerr << "hipSetDevice error" << std::endl;
-    return nullptr;
-  }
+  void* ptr = impl.arena_->Alloc(size);
+  TRACE(impl.api_ptrs_.ort_api, impl.logger_, "Alloc " << size << " bytes -> " << ptr);
+  return ptr;
+}
 
-  
-  void* ptr = nullptr;
-  err = hipMalloc(&ptr, size);
-  if (err != hipSuccess) {
-    std::cerr << "hipMalloc error" << std::endl;
-    return nullptr;
-  }
+/*static*/
+void* ORT_API_CALL HipDeviceAllocator::ReserveImpl(struct OrtAllocator* this_, size_t size) {
+  auto& impl = *static_cast<HipDeviceAllocator*>(this_);
+  void* ptr = impl.arena_->Reserve(size);
+  TRACE(impl.api_ptrs_.ort_api, impl.logger_, "Reserve " << size << " bytes -> " << ptr);
+  return ptr;
+}
 
-  // Track allocation and update stats
-  {
-    std::lock_guard<std::mutex> lock(impl.mutex_);
-    impl.allocation_sizes_[ptr] = size;
-    impl.stats_.num_allocs++;
-    impl.stats_.bytes_in_use += static_cast<int64_t>(size);
-    impl.stats_.total_allocated_bytes += static_cast<int64_t>(size);
-    impl.stats_.max_bytes_in_use = std::max(impl.stats_.max_bytes_in_use, impl.stats_.bytes_in_use);
-    impl.stats_.max_alloc_size = std::max(impl.stats_.max_alloc_size, static_cast<int64_t>(size));
-  }
+/*static*/
+void* ORT_API_CALL HipDeviceAllocator::AllocOnStreamImpl(struct OrtAllocator* this_, size_t size,
+                                                         OrtSyncStream* stream) {
+  auto& impl = *static_cast<HipDeviceAllocator*>(this_);
 
+  // Blocks freed by earlier work on the same stream are reused without waiting for the device
+  hipStream_t hip_stream = GetHipStream(impl.api_ptrs_.ort_api, stream);
+  void* ptr = hip_stream != nullptr ? impl.arena_->AllocOnStream(size, hip_stream) : impl.arena_->Alloc(size);
+  TRACE(impl.api_ptrs_.ort_api, impl.logger_, "AllocOnStream " << size << " bytes on " << hip_stream << " -> " << ptr);
   return ptr;
 }
 
 /*static*/
 void ORT_API_CALL HipDeviceAllocator::FreeImpl(struct OrtAllocator* this_, void* p) {
-  if (p == nullptr) {
-    return;
-  }
-
   auto& impl = *static_cast<HipDeviceAllocator*>(this_);
-  std::cerr << "HipDeviceAllocator::FreeImpl: " << impl.allocation_sizes_[p] << std::endl;
-
-  hipError_t err = hipSetDevice(impl.device_id_);
-  if (err != hipSuccess) {
-    // Can't proceed without setting the correct device
-    std::cerr << "hipSetDevice error" << std::endl;
-    return;
-  }
-
-  err = hipFree(p);
-  if (err != hipSuccess) {
-    // hipFree failed - still update our tracking to avoid memory leaks in stats
-    std::cerr << "hipFree error" << std::endl;
-  }
-
-  // Update tracking and stats
-  {
-    std::lock_guard<std::mutex> lock(impl.mutex_);
-    auto it = impl.allocation_sizes_.find(p);
-    if (it != impl.allocation_sizes_.end()) {
-      impl.stats_.bytes_in_use -= static_cast<int64_t>(it->second);
-      impl.allocation_sizes_.erase(it);
-    }
-  }
+  TRACE(impl.api_ptrs_.ort_api, impl.logger_, "Free " << p);
+  impl.arena_->Free(p);
 }
 
 /*static*/
@@ -117,10 +101,7 @@ OrtStatus* ORT_API_CALL HipDeviceAllocator::GetStatsImpl(const struct OrtAllocat
   OrtKeyValuePairs* kvps = nullptr;
   impl.api_ptrs_.ort_api.CreateKeyValuePairs(&kvps);
 
-  {
-    std::lock_guard<std::mutex> lock(impl.mutex_);
-    StatsToKeyValuePairs(impl.stats_, impl.api_ptrs_.ort_api, kvps);
-  }
+  StatsToKeyValuePairs(impl.arena_->GetStats(), impl.api_ptrs_.ort_api, kvps);
 
   *out = kvps;
   return nullptr;
@@ -0,0 +1,168 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/ep_context.h"
+
+#include <array>
+#include <cstring>
+
+namespace hipdnn_ep {
+
+//
+// ContextWriter
+//
+
+ContextWriter& ContextWriter::Write(int64_t value) {
+  oss_ << value << ' ';
+  return *this;
+}
+
+ContextWriter& ContextWriter::Write(uint64_t value) {
+  oss_ << value << ' ';
+  return *this;
+}
+
+ContextWriter& ContextWriter::Write(float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  oss_ << bits << ' ';
+  return *this;
+}
+
+ContextWriter& ContextWriter::Write(const std::string& value) {
+  oss_ << value.size() << ':' << value << ' ';
+  return *this;
+}
+
+ContextWriter& ContextWriter::Write(const std::vector<int64_t>& values) {
+  Write(static_cast<uint64_t>(values.size()));
+  for (int64_t value : values) {
+    Write(value);
+  }
+  return *this;
+}
+
+ContextWriter& ContextWriter::Write(const std::vector<float>& values) {
+  Write(static_cast<uint64_t>(values.size()));
+  for (float value : values) {
+    Write(value);
+  }
+  return *this;
+}
+
+//
+// ContextReader
+//
+
+bool ContextReader::Read(int64_t& value) {
+  return static_cast<bool>(iss_ >> value);
+}
+
+bool ContextReader::Read(uint64_t& value) {
+  return static_cast<bool>(iss_ >> value);
+}
+
+bool ContextReader::Read(float& value) {
+  uint32_t bits = 0;
+  if (!(iss_ >> bits)) {
+    return false;
+  }
+  std::memcpy(&value, &bits, sizeof(value));
+  return true;
+}
+
+bool ContextReader::Read(std::string& value) {
+  size_t size = 0;
+  char separator = 0;
+  if (!(iss_ >> size) || !iss_.get(separator) || separator != ':') {
+    return false;
+  }
+  value.resize(size);
+  return size == 0 || static_cast<bool>(iss_.read(&value[0], static_cast<std::streamsize>(size)));
+}
+
+bool ContextReader::Read(std::vector<int64_t>& values) {
+  uint64_t size = 0;
+  if (!Read(size)) {
+    return false;
+  }
+  values.resize(size);
+  for (auto& value : values) {
+    if (!Read(value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ContextReader::Read(std::vector<float>& values) {
+  uint64_t size = 0;
+  if (!Read(size)) {
+    return false;
+  }
+  values.resize(size);
+  for (auto& value : values) {
+    if (!Read(value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsEpContextNode(Ort::ConstNode node, const std::string& ep_name) {
+  if (node.GetOperatorType() != kEpContextOpType || node.GetDomain() != kEpContextDomain) {
+    return false;
+  }
+  return GetStringAttrOrDefault(node, "source", "") == ep_name;
+}
+
+OrtStatus* CreateEpContextNode(const ApiPtrs& apis, Ort::ConstNode fused_node, const std::string& ep_name,
+                               const std::string& context, OrtNode** ep_context_node) {
+  *ep_context_node = nullptr;
+
+  // The context node takes the fused node's place, so it keeps its inputs (including the weights,
+  // which stay initializers of the exported model) and outputs
+  std::vector<std::string> input_names;
+  std::vector<std::string> output_names;
+  for (const auto& input : fused_node.GetInputs()) {
+    input_names.push_back(input ? input.GetName() : std::string());
+  }
+  for (const auto& output : fused_node.GetOutputs()) {
+    output_names.push_back(output ? output.GetName() : std::string());
+  }
+
+  std::vector<const char*> input_ptrs;
+  std::vector<const char*> output_ptrs;
+  for (const auto& name : input_names) {
+    input_ptrs.push_back(name.c_str());
+  }
+  for (const auto& name : output_names) {
+    output_ptrs.push_back(name.c_str());
+  }
+
+  std::string node_name = fused_node.GetName();
+  int64_t main_context = 1;
+  int64_t embed_mode = 1;  // The context is always embedded in the node
+  const std::string sdk_version = "1";
+
+  // Ownership of the attributes passes to the node
+  std::array<OrtOpAttr*, 6> attributes{};
+  RETURN_IF_ERROR(apis.ort_api.CreateOpAttr("ep_cache_context", context.data(), static_cast<int>(context.size()),
+                                            ORT_OP_ATTR_STRING, &attributes[0]));
+  RETURN_IF_ERROR(apis.ort_api.CreateOpAttr("main_context", &main_context, 1, ORT_OP_ATTR_INT, &attributes[1]));
+  RETURN_IF_ERROR(apis.ort_api.CreateOpAttr("embed_mode", &embed_mode, 1, ORT_OP_ATTR_INT, &attributes[2]));
+  RETURN_IF_ERROR(apis.ort_api.CreateOpAttr("ep_sdk_version", sdk_version.data(), static_cast<int>(sdk_version.size()),
+                                            ORT_OP_ATTR_STRING, &attributes[3]));
+  RETURN_IF_ERROR(apis.ort_api.CreateOpAttr("partition_name", node_name.data(), static_cast<int>(node_name.size()),
+                                            ORT_OP_ATTR_STRING, &attributes[4]));
+  RETURN_IF_ERROR(apis.ort_api.CreateOpAttr("source", ep_name.data(), static_cast<int>(ep_name.size()),
+                                            ORT_OP_ATTR_STRING, &attributes[5]));
+
+  RETURN_IF_ERROR(apis.model_editor_api.CreateNode(kEpContextOpType, kEpContextDomain, node_name.c_str(),
+                                                   input_ptrs.data(), input_ptrs.size(),
+                                                   output_ptrs.data(), output_ptrs.size(),
+                                                   attributes.data(), attributes.size(), ep_context_node));
+  return nullptr;
+}
+
+}  // namespace hipdnn_ep
@@ -2,15 +2,17 @@
 // Licensed under the MIT License.
 
 #include "hipdnn_ep/ep_data_transfer.h"
+#include "hipdnn_ep/ep_stream.h"
 #include <hip/hip_runtime.h>
+#include <algorithm>
 #include <cstring>
-
-#include <iostream>
+#include <string>
 
 namespace hipdnn_ep {
 
-HipDataTransfer::HipDataTransfer(ApiPtrs api_ptrs, const OrtMemoryDevice* device_mem_info, int device_id)
-    : ApiPtrs(api_ptrs), device_mem_info_(device_mem_info), device_id_(device_id) {
+HipDataTransfer::HipDataTransfer(ApiPtrs api_ptrs, const OrtLogger& logger, const OrtMemoryDevice* device_mem_info,
+                                 int device_id)
+    : ApiPtrs(api_ptrs), logger_(logger), device_mem_info_(device_mem_info), device_id_(device_id) {
   CanCopy = CanCopyImpl;
   CopyTensors = CopyTensorsImpl;
   Release = ReleaseImpl;
@@ -20,15 +22,11 @@ HipDataTransfer::HipDataTransfer(ApiPtrs api_ptrs, const OrtMemoryDevice* device
 bool ORT_API_CALL HipDataTransfer::CanCopyImpl(const OrtDataTransferImpl* this_ptr,
                                                const OrtMemoryDevice* src_memory_device,
                                                const OrtMemoryDevice* dst_memory_device) noexcept {
-  static size_t cnt = 0;
-  std::cerr << "CanCopyImpl: " << cnt++ << std::endl;
-
   const auto& impl = *static_cast<const HipDataTransfer*>(this_ptr);
 
   // Get memory types
   OrtDeviceMemoryType src_type = impl.ep_api.MemoryDevice_GetMemoryType(src_memory_device);
   OrtDeviceMemoryType dst_type = impl.ep_api.MemoryDevice_GetMemoryType(dst_memory_device);
-  std::cerr << "memory type: " << src_type << " -> " << dst_type << std::endl;
 
   // We support:
   // - CPU to GPU (DEFAULT)
@@ -37,7 +35,9 @@ bool ORT_API_CALL HipDataTransfer::CanCopyImpl(const OrtDataTransferImpl* this_p
 
   OrtMemoryInfoDeviceType src_device_type = impl.ep_api.MemoryDevice_GetDeviceType(src_memory_device);
   OrtMemoryInfoDeviceType dst_device_type = impl.ep_api.MemoryDevice_GetDeviceType(dst_memory_device);
-  std::cerr << "device type: " << src_device_type << " -> " << dst_device_type << std::endl;
+  TRACE(impl.ort_api, impl.logger_,
+        "CanCopy: device type " << src_device_type << " -> " << dst_device_type << ", memory type " << src_type
+                                << " -> " << dst_type);
 
   bool src_is_cpu = (src_device_type == OrtMemoryInfoDeviceType_CPU);
   bool dst_is_cpu = (dst_device_type == OrtMemoryInfoDeviceType_CPU);
@@ -66,7 +66,7 @@ bool ORT_API_CALL HipDataTransfer::CanCopyImpl(const OrtDataTransferImpl* this_p
 OrtStatus* ORT_API_CALL HipDataTransfer::CopyTensorsImpl(OrtDataTransferImpl* this_ptr,
                                                          const OrtValue** src_tensors_ptr,
                                                          OrtValue** dst_tensors_ptr,
-                                                         OrtSyncStream** /*streams_ptr*/,
+                                                         OrtSyncStream** streams_ptr,
                                                          size_t num_tensors) noexcept {
   auto& impl = *static_cast<HipDataTransfer*>(this_ptr);
 
@@ -75,92 +75,157 @@ OrtStatus* ORT_API_CALL HipDataTransfer::CopyTensorsImpl(OrtDataTransferImpl* th
     RETURN_ERROR(impl.ort_api, ORT_EP_FAIL, "Failed to set HIP device: " << hipGetErrorString(err));
   }
 
-  for (size_t i = 0; i < num_tensors; ++i) {
-    try {
-      static size_t cnt = 0;
-      std::cerr << "CopyTensorsImpl: " << cnt++ << std::endl;
-      Ort::ConstValue src{src_tensors_ptr[i]};
-      Ort::UnownedValue dst{dst_tensors_ptr[i]};
+  // All copies of the call are enqueued first. Streams are synchronized once at the end, and only
+  // when a copy has no stream (it must be complete on return) or lands in pageable host memory
+  // (the staged data has to be copied out on the host).
+  std::vector<PendingHostCopy> pending_host_copies;
+  std::vector<hipStream_t> streams_to_sync;
+  auto sync_on_return = [&streams_to_sync](hipStream_t stream) {
+    if (std::find(streams_to_sync.begin(), streams_to_sync.end(), stream) == streams_to_sync.end()) {
+      streams_to_sync.push_back(stream);
+    }
+  };
 
-      auto src_type_shape = src.GetTensorTypeAndShapeInfo();
-      auto dst_type_shape = dst.GetTensorTypeAndShapeInfo();
+  OrtStatus* status = nullptr;
+  for (size_t i = 0; i < num_tensors && status == nullptr; ++i) {
+    hipStream_t stream = streams_ptr != nullptr ? GetHipStream(impl.ort_api, streams_ptr[i]) : nullptr;
+    if (stream == nullptr) {
+      sync_on_return(nullptr);
+    }
+    status = impl.EnqueueCopy(src_tensors_ptr[i], dst_tensors_ptr[i], stream, pending_host_copies);
+  }
 
-      size_t src_size = src_type_shape.GetElementCount();
-      size_t dst_size = dst_type_shape.GetElementCount();
+  for (size_t i = 0; i < pending_host_copies.size(); ++i) {
+    sync_on_return(pending_host_copies[i].stream);
+  }
 
-      if (src_size != dst_size) {
-        RETURN_ERROR(impl.ort_api, ORT_EP_FAIL, "Source and destination tensor sizes don't match");
-      }
+  // Drain everything that was enqueued even on failure so no staging buffer is still in flight
+  TRACE(impl.ort_api, impl.logger_,
+        "CopyTensors: " << num_tensors << " tensors, " << pending_host_copies.size() << " staged to pageable host, "
+                        << streams_to_sync.size() << " streams synchronized");
 
-      // Get element size based on data type
-      ONNXTensorElementDataType elem_type = src_type_shape.GetElementType();
-      size_t elem_size = 0;
-      switch (elem_type) {
-        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
-          elem_size = sizeof(float);
-          break;
-        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
-          elem_size = 2;
-          break;
-        case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
-          elem_size = 2;
-          break;
-        case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
-          elem_size = sizeof(double);
-          break;
-        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
-          elem_size = sizeof(int32_t);
-          break;
-        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
-          elem_size = sizeof(int64_t);
-          break;
-        default:
-          RETURN_ERROR(impl.ort_api, ORT_EP_FAIL, "Unsupported tensor element type");
-      }
+  for (hipStream_t stream : streams_to_sync) {
+    err = hipStreamSynchronize(stream);
+    if (err != hipSuccess && status == nullptr) {
+      std::string message = std::string("hipStreamSynchronize failed: ") + hipGetErrorString(err);
+      status = impl.ort_api.CreateStatus(ORT_EP_FAIL, message.c_str());
+    }
+  }
+
+  for (auto& copy : pending_host_copies) {
+    if (status == nullptr) {
+      std::memcpy(copy.dst, copy.staging.ptr, copy.byte_size);
+    }
+    impl.staging_pool_.Release(copy.staging, copy.stream);
+  }
+
+  return status;
+}
+
+OrtStatus* HipDataTransfer::EnqueueCopy(const OrtValue* src_value, OrtValue* dst_value, hipStream_t stream,
+                                        std::vector<PendingHostCopy>& pending_host_copies) {
+  try {
+    Ort::ConstValue src{src_value};
+    Ort::UnownedValue dst{dst_value};
+
+    auto src_type_shape = src.GetTensorTypeAndShapeInfo();
+    auto dst_type_shape = dst.GetTensorTypeAndShapeInfo();
+
+    size_t src_size = src_type_shape.GetElementCount();
+    size_t dst_size = dst_type_shape.GetElementCount();
+
+    if (src_size != dst_size) {
+      RETURN_ERROR(ort_api, ORT_EP_FAIL, "Source and destination tensor sizes don't match");
+    }
+
+    // Get element size based on data type
+    ONNXTensorElementDataType elem_type = src_type_shape.GetElementType();
+    size_t elem_size = 0;
+    switch (elem_type) {
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+        elem_size = sizeof(float);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+        elem_size = 2;
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+        elem_size = 2;
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+        elem_size = sizeof(double);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+        elem_size = sizeof(int32_t);
+        break;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+        elem_size = sizeof(int64_t);
+        break;
+      default:
+        RETURN_ERROR(ort_api, ORT_EP_FAIL, "Unsupported tensor element type");
+    }
+
+    size_t byte_size = src_size * elem_size;
+    if (byte_size == 0) {
+      return nullptr;
+    }
 
-      size_t byte_size = src_size * elem_size;
+    // Get memory info for source and destination
+    Ort::ConstMemoryInfo src_mem_info = src.GetTensorMemoryInfo();
+    Ort::ConstMemoryInfo dst_mem_info = dst.GetTensorMemoryInfo();
 
-      // Get memory info for source and destination
-      Ort::ConstMemoryInfo src_mem_info = src.GetTensorMemoryInfo();
-      Ort::ConstMemoryInfo dst_mem_info = dst.GetTensorMemoryInfo();
+    bool src_is_cpu = src_mem_info.GetDeviceType() == OrtMemoryInfoDeviceType_CPU;
+    bool dst_is_cpu = dst_mem_info.GetDeviceType() == OrtMemoryInfoDeviceType_CPU;
 
-      OrtMemoryInfoDeviceType src_device_type = src_mem_info.GetDeviceType();
-      OrtMemoryInfoDeviceType dst_device_type = dst_mem_info.GetDeviceType();
+    const void* src_data = src.GetTensorRawData();
+    void* dst_data = dst.GetTensorMutableRawData();
 
-      const void* src_data = src.GetTensorRawData();
-      void* dst_data = dst.GetTensorMutableRawData();
+    if (src_is_cpu && dst_is_cpu) {
+      std::memcpy(dst_data, src_data, byte_size);
+      return nullptr;
+    }
 
-      hipMemcpyKind kind;
-      if (src_device_type == OrtMemoryInfoDeviceType_CPU &&
-          dst_device_type == OrtMemoryInfoDeviceType_GPU) {
-        kind = hipMemcpyHostToDevice;
-      } else if (src_device_type == OrtMemoryInfoDeviceType_GPU &&
-                 dst_device_type == OrtMemoryInfoDeviceType_CPU) {
-        kind = hipMemcpyDeviceToHost;
-      } else if (src_device_type == OrtMemoryInfoDeviceType_GPU &&
-                 dst_device_type == OrtMemoryInfoDeviceType_GPU) {
-        kind = hipMemcpyDeviceToDevice;
+    hipError_t err = hipSuccess;
+    if (!src_is_cpu && !dst_is_cpu) {
+      err = hipMemcpyAsync(dst_data, src_data, byte_size, hipMemcpyDeviceToDevice, stream);
+    } else if (src_is_cpu) {
+      if (IsPinnedHostMemory(src_data)) {
+        err = hipMemcpyAsync(dst_data, src_data, byte_size, hipMemcpyHostToDevice, stream);
       } else {
-        // CPU to CPU - use memcpy
-        std::memcpy(dst_data, src_data, byte_size);
-        std::cerr << "std::memcpy: " << dst_data << ", " << src_data << ", " << byte_size << std::endl;
-        continue;
+        // Pageable source: copy into a pinned buffer so the upload itself runs asynchronously.
+        // The buffer goes back to the pool guarded by an event recorded after the upload.
+        PinnedBufferPool::Buffer staging;
+        err = staging_pool_.Acquire(byte_size, staging);
+        if (err != hipSuccess) {
+          RETURN_ERROR(ort_api, ORT_EP_FAIL, "Failed to allocate pinned staging buffer: " << hipGetErrorString(err));
+        }
+        std::memcpy(staging.ptr, src_data, byte_size);
+        err = hipMemcpyAsync(dst_data, staging.ptr, byte_size, hipMemcpyHostToDevice, stream);
+        staging_pool_.Release(staging, stream);
       }
-
-      // TODO: Use async copy with streams when available
-      err = hipMemcpy(dst_data, src_data, byte_size, kind);
-      if (err != hipSuccess) {
-        RETURN_ERROR(impl.ort_api, ORT_EP_FAIL, "hipMemcpy failed: " << hipGetErrorString(err));
+    } else {
+      if (IsPinnedHostMemory(dst_data)) {
+        err = hipMemcpyAsync(dst_data, src_data, byte_size, hipMemcpyDeviceToHost, stream);
+      } else {
+        // Pageable destination: download into a pinned buffer; the caller copies it out after syncing
+        PinnedBufferPool::Buffer staging;
+        err = staging_pool_.Acquire(byte_size, staging);
+        if (err != hipSuccess) {
+          RETURN_ERROR(ort_api, ORT_EP_FAIL, "Failed to allocate pinned staging buffer: " << hipGetErrorString(err));
+        }
+        err = hipMemcpyAsync(staging.ptr, src_data, byte_size, hipMemcpyDeviceToHost, stream);
+        pending_host_copies.push_back({dst_data, staging, byte_size, stream});
       }
+    }
 
-      std::cerr << "hipMemcpy: " << dst_data << ", " << src_data << ", " << byte_size << ", " << kind << std::endl;
-    } catch (const Ort::Exception& ex) {
-      Ort::Status status(ex);
-      return status.release();
-    } catch (const std::exception& ex) {
-      Ort::Status status(ex.what(), ORT_EP_FAIL);
-      return status.release();
+    if (err != hipSuccess) {
+      RETURN_ERROR(ort_api, ORT_EP_FAIL, "hipMemcpyAsync failed: " << hipGetErrorString(err));
     }
+  } catch (const Ort::Exception& ex) {
+    Ort::Status status(ex);
+    return status.release();
+  } catch (const std::exception& ex) {
+    Ort::Status status(ex.what(), ORT_EP_FAIL);
+    return status.release();
   }
 
   return nullptr;
@@ -3,6 +3,7 @@
 
 #include "hipdnn_ep/ep_factory.h"
 #include "hipdnn_ep/ep.h"
+#include "hipdnn_ep/ep_stream.h"
 #include "hipdnn_ep/memcpy_kernel.h"
 #include <hip/hip_runtime.h>
 
@@ -31,6 +32,8 @@ HipDNNEpFactory::HipDNNEpFactory(const char* ep_name, ApiPtrs apis, const OrtLog
   IsStreamAware = IsStreamAwareImpl;
   CreateSyncStreamForDevice = CreateSyncStreamForDeviceImpl;
 
+  UpdateMinLogSeverity(ort_api, default_logger_);
+
   // Get the first available HIP device
   int device_count = 0;
   hipError_t err = hipGetDeviceCount(&device_count);
@@ -38,7 +41,9 @@ HipDNNEpFactory::HipDNNEpFactory(const char* ep_name, ApiPtrs apis, const OrtLog
     device_id_ = 0;  // Use first device
 
     hipDeviceProp_t props;
-    (void)hipGetDeviceProperties(&props, device_id_);
+    if (hipGetDeviceProperties(&props, device_id_) == hipSuccess) {
+      device_arch_ = props.gcnArchName;
+    }
 
     IGNORE_ORTSTATUS(ort_api.Logger_LogMessage(
         &default_logger_, ORT_LOGGING_LEVEL_INFO,
@@ -67,7 +72,7 @@ HipDNNEpFactory::HipDNNEpFactory(const char* ep_name, ApiPtrs apis, const OrtLog
 
   // Create data transfer
   const OrtMemoryDevice* device = ep_api.MemoryInfo_GetMemoryDevice(default_memory_info_);
-  data_transfer_impl_ = std::make_unique<HipDataTransfer>(apis, device, device_id_);
+  data_transfer_impl_ = std::make_unique<HipDataTransfer>(apis, default_logger_, device, device_id_);
 
   // Create kernel registry and register memcpy kernels
   Ort::Status status{ep_api.CreateKernelRegistry(&kernel_registry_)};
@@ -161,18 +166,17 @@ OrtStatus* ORT_API_CALL HipDNNEpFactory::GetSupportedDevicesImpl(
     }
   }
 
-  // If no GPU was found in the device list, also check for CPU (for testing)
-  // This allows the EP to work even when no explicit GPU device is provided
+  // Without a GPU, offer the CPU device instead. The EP then runs the same compiled partitions on its
+  // host backend, so it stays usable (and testable) on machines without a GPU.
   if (num_ep_devices == 0) {
     for (size_t i = 0; i < num_devices && num_ep_devices < max_ep_devices; ++i) {
       const OrtHardwareDevice& device = *devices[i];
       OrtHardwareDeviceType device_type = factory->ort_api.HardwareDevice_Type(&device);
 
       if (device_type == OrtHardwareDeviceType_CPU) {
-        // Accept CPU as a fallback for testing
         OrtKeyValuePairs* ep_metadata = nullptr;
         factory->ort_api.CreateKeyValuePairs(&ep_metadata);
-        factory->ort_api.AddKeyValuePair(ep_metadata, "backend", "hipDNN");
+        factory->ort_api.AddKeyValuePair(ep_metadata, "backend", "host");
 
         OrtEpDevice* ep_device = nullptr;
         auto* status = factory->ep_api.CreateEpDevice(factory, &device, ep_metadata, nullptr, &ep_device);
@@ -183,7 +187,7 @@ OrtStatus* ORT_API_CALL HipDNNEpFactory::GetSupportedDevicesImpl(
           return status;
         }
 
-        RETURN_IF_ERROR(factory->ep_api.EpDevice_AddAllocatorInfo(ep_device, factory->default_memory_info_));
+        // No allocator info: the host backend's inputs and outputs live in ORT's CPU memory
         ep_devices[num_ep_devices++] = ep_device;
         break;
       }
@@ -196,7 +200,7 @@ OrtStatus* ORT_API_CALL HipDNNEpFactory::GetSupportedDevicesImpl(
 /*static*/
 OrtStatus* ORT_API_CALL HipDNNEpFactory::CreateEpImpl(
     OrtEpFactory* this_ptr,
-    const OrtHardwareDevice* const* /*devices*/,
+    const OrtHardwareDevice* const* devices,
     const OrtKeyValuePairs* const* /*ep_metadata*/,
     size_t num_devices,
     const OrtSessionOptions* session_options,
@@ -211,6 +215,9 @@ OrtStatus* ORT_API_CALL HipDNNEpFactory::CreateEpImpl(
         "hipDNN EP currently only supports selection for one device.");
   }
 
+  // Sessions may log at a more verbose level than the environment
+  UpdateMinLogSeverity(factory->ort_api, *logger);
+
   RETURN_IF_ERROR(factory->ort_api.Logger_LogMessage(
       logger, ORT_LOGGING_LEVEL_INFO,
       "Creating hipDNN Execution Provider",
@@ -220,8 +227,24 @@ OrtStatus* ORT_API_CALL HipDNNEpFactory::CreateEpImpl(
   std::string ep_context_enable;
   RETURN_IF_ERROR(GetSessionConfigEntryOrDefault(*session_options, "ep.context_enable", "0", ep_context_enable));
 
+  std::string conv_algo_cache_path;
+  RETURN_IF_ERROR(GetSessionConfigEntryOrDefault(*session_options, "ep.hipdnn.conv_algo_cache_path", "",
+                                                 conv_algo_cache_path));
+
+  std::string host_threads;
+  RETURN_IF_ERROR(GetSessionConfigEntryOrDefault(*session_options, "ep.hipdnn.host_threads", "0", host_threads));
+
   HipDNNEp::Config config{};
   config.enable_ep_context = (ep_context_enable == "1");
+  config.conv_algo_cache_path = conv_algo_cache_path;
+
+  // The CPU device is only offered without a GPU; kernels then run on the host backend
+  config.host_backend = factory->ort_api.HardwareDevice_Type(devices[0]) == OrtHardwareDeviceType_CPU;
+  try {
+    config.host_threads = static_cast<size_t>(std::stoull(host_threads));
+  } catch (const std::exception&) {
+    RETURN_ERROR(factory->ort_api, ORT_INVALID_ARGUMENT, "Invalid value for ep.hipdnn.host_threads: " << host_threads);
+  }
 
   try {
     auto hipdnn_ep = std::make_unique<HipDNNEp>(*factory, config, *logger);
@@ -242,17 +265,19 @@ void ORT_API_CALL HipDNNEpFactory::ReleaseEpImpl(OrtEpFactory* /*this_ptr*/, Ort
 OrtStatus* ORT_API_CALL HipDNNEpFactory::CreateAllocatorImpl(
     OrtEpFactory* this_ptr,
     const OrtMemoryInfo* memory_info,
-    const OrtKeyValuePairs* /*allocator_options*/,
+    const OrtKeyValuePairs* allocator_options,
     OrtAllocator** allocator) noexcept {
   auto& factory = *static_cast<HipDNNEpFactory*>(this_ptr);
   std::lock_guard<std::mutex> lock(factory.mutex_);
 
   *allocator = nullptr;
 
-  // Create allocator if not already created
+  // Create allocator if not already created. It is shared, so the options of the first request apply.
   if (!factory.device_allocator_) {
+    ArenaConfig arena_config;
+    RETURN_IF_ERROR(ArenaConfig::FromKeyValuePairs(factory.ort_api, allocator_options, arena_config));
     factory.device_allocator_ = std::make_unique<HipDeviceAllocator>(
-        memory_info, factory, factory.device_id_);
+        memory_info, factory, factory.default_logger_, factory.device_id_, arena_config);
   }
 
   *allocator = factory.device_allocator_.get();
@@ -276,19 +301,35 @@ OrtStatus* ORT_API_CALL HipDNNEpFactory::CreateDataTransferImpl(
 
 /*static*/
 bool ORT_API_CALL HipDNNEpFactory::IsStreamAwareImpl(const OrtEpFactory* /*this_ptr*/) noexcept {
-  // TODO: Implement stream support
-  return false;
+  return true;
 }
 
 /*static*/
 OrtStatus* ORT_API_CALL HipDNNEpFactory::CreateSyncStreamForDeviceImpl(
-    OrtEpFactory* /*this_ptr*/,
-    const OrtMemoryDevice* /*memory_device*/,
+    OrtEpFactory* this_ptr,
+    const OrtMemoryDevice* memory_device,
     const OrtKeyValuePairs* /*stream_options*/,
     OrtSyncStreamImpl** stream) noexcept {
-  // TODO: Implement stream support
+  auto& factory = *static_cast<HipDNNEpFactory*>(this_ptr);
+  return factory.CreateSyncStream(memory_device, stream);
+}
+
+OrtStatus* HipDNNEpFactory::CreateSyncStream(const OrtMemoryDevice* memory_device, OrtSyncStreamImpl** stream,
+                                             const std::shared_ptr<SessionStream>& session_stream) {
   *stream = nullptr;
-  return nullptr;
+
+  // Only our GPU's default memory has streams; ORT uses no stream for anything else
+  if (ep_api.MemoryDevice_GetDeviceType(memory_device) != OrtMemoryInfoDeviceType_GPU ||
+      ep_api.MemoryDevice_GetVendorId(memory_device) != vendor_id_ ||
+      ep_api.MemoryDevice_GetDeviceId(memory_device) != static_cast<uint32_t>(device_id_)) {
+    return nullptr;
+  }
+
+  if (session_stream && session_stream->TryLend()) {
+    *stream = HipSyncStream::Borrow(*this, session_stream);
+    return nullptr;
+  }
+  return HipSyncStream::Create(*this, device_id_, stream);
 }
 
 }  // namespace hipdnn_ep
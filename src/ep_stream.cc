@@ -0,0 +1,200 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/ep_stream.h"
+
+namespace hipdnn_ep {
+
+hipStream_t GetHipStream(const OrtApi& ort_api, OrtSyncStream* stream) {
+  if (stream == nullptr) {
+    return nullptr;
+  }
+  return static_cast<hipStream_t>(ort_api.SyncStream_GetHandle(stream));
+}
+
+//
+// SessionStream
+//
+
+/*static*/
+OrtStatus* SessionStream::Create(const OrtApi& ort_api, int device_id, std::shared_ptr<SessionStream>& stream) {
+  stream.reset();
+
+  hipError_t err = hipSetDevice(device_id);
+  if (err != hipSuccess) {
+    RETURN_ERROR(ort_api, ORT_EP_FAIL, "Failed to set HIP device: " << hipGetErrorString(err));
+  }
+
+  hipStream_t hip_stream = nullptr;
+  err = hipStreamCreateWithFlags(&hip_stream, hipStreamNonBlocking);
+  if (err != hipSuccess) {
+    RETURN_ERROR(ort_api, ORT_EP_FAIL, "Failed to create HIP stream: " << hipGetErrorString(err));
+  }
+
+  stream.reset(new SessionStream(hip_stream));
+  return nullptr;
+}
+
+SessionStream::~SessionStream() {
+  hipStreamSynchronize(stream_);
+  hipStreamDestroy(stream_);
+}
+
+//
+// HipSyncStream
+//
+
+/*static*/
+OrtStatus* HipSyncStream::Create(ApiPtrs api_ptrs, int device_id, OrtSyncStreamImpl** stream) {
+  *stream = nullptr;
+
+  hipError_t err = hipSetDevice(device_id);
+  if (err != hipSuccess) {
+    RETURN_ERROR(api_ptrs.ort_api, ORT_EP_FAIL, "Failed to set HIP device: " << hipGetErrorString(err));
+  }
+
+  // Non-blocking so work on it doesn't serialize against the legacy null stream
+  hipStream_t hip_stream = nullptr;
+  err = hipStreamCreateWithFlags(&hip_stream, hipStreamNonBlocking);
+  if (err != hipSuccess) {
+    RETURN_ERROR(api_ptrs.ort_api, ORT_EP_FAIL, "Failed to create HIP stream: " << hipGetErrorString(err));
+  }
+
+  *stream = new HipSyncStream(api_ptrs, hip_stream);
+  return nullptr;
+}
+
+/*static*/
+OrtSyncStreamImpl* HipSyncStream::Borrow(ApiPtrs api_ptrs, std::shared_ptr<SessionStream> session_stream) {
+  hipStream_t hip_stream = session_stream->Get();
+  return new HipSyncStream(api_ptrs, hip_stream, std::move(session_stream));
+}
+
+HipSyncStream::HipSyncStream(ApiPtrs api_ptrs, hipStream_t stream, std::shared_ptr<SessionStream> session_stream)
+    : OrtSyncStreamImpl{}, ApiPtrs(api_ptrs), stream_(stream), session_stream_(std::move(session_stream)) {
+  ort_version_supported = ORT_API_VERSION;
+  Release = ReleaseImpl;
+  GetHandle = GetHandleImpl;
+  CreateNotification = CreateNotificationImpl;
+  Flush = FlushImpl;
+  OnSessionRunEnd = OnSessionRunEndImpl;
+}
+
+HipSyncStream::~HipSyncStream() {
+  if (session_stream_) {
+    // The session keeps the stream; the next HipSyncStream may borrow it
+    hipStreamSynchronize(stream_);
+    session_stream_->Return();
+  } else if (stream_ != nullptr) {
+    hipStreamSynchronize(stream_);
+    hipStreamDestroy(stream_);
+  }
+}
+
+/*static*/
+void ORT_API_CALL HipSyncStream::ReleaseImpl(OrtSyncStreamImpl* this_ptr) noexcept {
+  delete static_cast<HipSyncStream*>(this_ptr);
+}
+
+/*static*/
+void* ORT_API_CALL HipSyncStream::GetHandleImpl(OrtSyncStreamImpl* this_ptr) noexcept {
+  return static_cast<HipSyncStream*>(this_ptr)->stream_;
+}
+
+/*static*/
+OrtStatus* ORT_API_CALL HipSyncStream::CreateNotificationImpl(OrtSyncStreamImpl* this_ptr,
+                                                              OrtSyncNotificationImpl** notification) noexcept {
+  auto& stream = *static_cast<HipSyncStream*>(this_ptr);
+  *notification = nullptr;
+
+  // Timing is never queried, and skipping it makes record/wait cheaper
+  hipEvent_t event = nullptr;
+  hipError_t err = hipEventCreateWithFlags(&event, hipEventDisableTiming);
+  if (err != hipSuccess) {
+    RETURN_ERROR(stream.ort_api, ORT_EP_FAIL, "Failed to create HIP event: " << hipGetErrorString(err));
+  }
+
+  *notification = new HipSyncNotification(stream, stream.stream_, event);
+  return nullptr;
+}
+
+/*static*/
+OrtStatus* ORT_API_CALL HipSyncStream::FlushImpl(OrtSyncStreamImpl* /*this_ptr*/) noexcept {
+  // Work is submitted as it is enqueued; there is nothing to flush
+  return nullptr;
+}
+
+/*static*/
+OrtStatus* ORT_API_CALL HipSyncStream::OnSessionRunEndImpl(OrtSyncStreamImpl* this_ptr) noexcept {
+  auto& stream = *static_cast<HipSyncStream*>(this_ptr);
+
+  // Outputs must be complete when Run returns
+  hipError_t err = hipStreamSynchronize(stream.stream_);
+  if (err != hipSuccess) {
+    RETURN_ERROR(stream.ort_api, ORT_EP_FAIL, "hipStreamSynchronize failed: " << hipGetErrorString(err));
+  }
+  return nullptr;
+}
+
+//
+// HipSyncNotification
+//
+
+HipSyncNotification::HipSyncNotification(ApiPtrs api_ptrs, hipStream_t stream, hipEvent_t event)
+    : OrtSyncNotificationImpl{}, ApiPtrs(api_ptrs), stream_(stream), event_(event) {
+  ort_version_supported = ORT_API_VERSION;
+  Release = ReleaseImpl;
+  Activate = ActivateImpl;
+  WaitOnDevice = WaitOnDeviceImpl;
+  WaitOnHost = WaitOnHostImpl;
+}
+
+HipSyncNotification::~HipSyncNotification() {
+  if (event_ != nullptr) {
+    hipEventDestroy(event_);
+  }
+}
+
+/*static*/
+void ORT_API_CALL HipSyncNotification::ReleaseImpl(OrtSyncNotificationImpl* this_ptr) noexcept {
+  delete static_cast<HipSyncNotification*>(this_ptr);
+}
+
+/*static*/
+OrtStatus* ORT_API_CALL HipSyncNotification::ActivateImpl(OrtSyncNotificationImpl* this_ptr) noexcept {
+  auto& notification = *static_cast<HipSyncNotification*>(this_ptr);
+
+  // Marks the point on the producer stream that consumers wait for
+  hipError_t err = hipEventRecord(notification.event_, notification.stream_);
+  if (err != hipSuccess) {
+    RETURN_ERROR(notification.ort_api, ORT_EP_FAIL, "hipEventRecord failed: " << hipGetErrorString(err));
+  }
+  return nullptr;
+}
+
+/*static*/
+OrtStatus* ORT_API_CALL HipSyncNotification::WaitOnDeviceImpl(OrtSyncNotificationImpl* this_ptr,
+                                                              OrtSyncStream* consumer_stream) noexcept {
+  auto& notification = *static_cast<HipSyncNotification*>(this_ptr);
+
+  // The consumer stream waits on the GPU; the host is not blocked
+  hipStream_t consumer = GetHipStream(notification.ort_api, consumer_stream);
+  hipError_t err = hipStreamWaitEvent(consumer, notification.event_, 0);
+  if (err != hipSuccess) {
+    RETURN_ERROR(notification.ort_api, ORT_EP_FAIL, "hipStreamWaitEvent failed: " << hipGetErrorString(err));
+  }
+  return nullptr;
+}
+
+/*static*/
+OrtStatus* ORT_API_CALL HipSyncNotification::WaitOnHostImpl(OrtSyncNotificationImpl* this_ptr) noexcept {
+  auto& notification = *static_cast<HipSyncNotification*>(this_ptr);
+
+  hipError_t err = hipEventSynchronize(notification.event_);
+  if (err != hipSuccess) {
+    RETURN_ERROR(notification.ort_api, ORT_EP_FAIL, "hipEventSynchronize failed: " << hipGetErrorString(err));
+  }
+  return nullptr;
+}
+
+}  // namespace hipdnn_ep
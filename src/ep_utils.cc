@@ -45,4 +45,58 @@ std::vector<int64_t> GetIntsAttrOrDefault(Ort::ConstNode node, const char* name,
   return value;
 }
 
+float GetFloatAttrOrDefault(Ort::ConstNode node, const char* name, float default_val) {
+  Ort::ConstOpAttr attr{nullptr};
+  auto status = node.GetAttributeByName(name, attr);
+  if (!status.IsOK() || !static_cast<const OrtOpAttr*>(attr)) {
+    return default_val;
+  }
+  float value;
+  if (!attr.GetValue(value).IsOK()) {
+    return default_val;
+  }
+  return value;
+}
+
+bool GetScalarInitializerValue(Ort::ConstValueInfo value_info, float& value) {
+  std::vector<float> values;
+  if (!GetInitializerValues(value_info, values) || values.size() != 1) {
+    return false;
+  }
+  value = values[0];
+  return true;
+}
+
+bool GetInitializerValues(Ort::ConstValueInfo value_info, std::vector<float>& values) {
+  if (!static_cast<const OrtValueInfo*>(value_info) || !value_info.IsConstantInitializer()) {
+    return false;
+  }
+
+  Ort::ConstValue initializer{nullptr};
+  if (!value_info.GetInitializer(initializer).IsOK() || !static_cast<const OrtValue*>(initializer)) {
+    return false;
+  }
+
+  auto type_shape = initializer.GetTensorTypeAndShapeInfo();
+  size_t count = type_shape.GetElementCount();
+  const void* data = initializer.GetTensorRawData();
+  switch (type_shape.GetElementType()) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT: {
+      const float* floats = static_cast<const float*>(data);
+      values.assign(floats, floats + count);
+      return true;
+    }
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16: {
+      const uint16_t* bits = static_cast<const uint16_t*>(data);
+      values.resize(count);
+      for (size_t i = 0; i < count; ++i) {
+        values[i] = Ort::Float16_t::FromBits(bits[i]).ToFloat();
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
 }  // namespace hipdnn_ep
@@ -0,0 +1,105 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/gpu_backend.h"
+#include "hipdnn_ep/conv_op.h"
+#include "hipdnn_ep/matmul_op.h"
+#include "hipdnn_ep/miopen_utils.h"
+#include "hipdnn_ep/pointwise_op.h"
+#include "hipdnn_ep/pool_op.h"
+
+namespace hipdnn_ep {
+
+GpuBackend::GpuBackend(const OrtApi& ort_api, const OrtLogger& logger, const std::string& conv_algo_cache_path,
+                       const std::string& device_arch, hipStream_t compile_stream)
+    : ort_api_(ort_api), logger_(logger), compile_stream_(compile_stream) {
+  conv_algo_cache_ = std::make_unique<ConvAlgoCache>(conv_algo_cache_path, device_arch);
+  if (!conv_algo_cache_->Load()) {
+    LOG(ort_api_, logger_, WARNING,
+        "HipDNN EP: Ignoring unreadable conv algo cache: " << conv_algo_cache_->Path());
+  } else if (!conv_algo_cache_->Path().empty()) {
+    LOG(ort_api_, logger_, INFO,
+        "HipDNN EP: Loaded " << conv_algo_cache_->Size() << " conv algo cache entries from "
+                             << conv_algo_cache_->Path());
+  }
+}
+
+std::string GpuBackend::Fingerprint() const {
+  // Solution ids only carry over to the GPU architecture and MIOpen build that found them
+  return conv_algo_cache_->Fingerprint();
+}
+
+bool GpuBackend::SupportsDataType(ONNXTensorElementDataType type) const {
+  return type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT || type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+}
+
+OrtStatus* GpuBackend::CompileConv(std::unique_ptr<ConvOpInfo> info, std::unique_ptr<Op>& op) {
+  // Compile on the session's stream: the pool hands this handle back to runs on that stream, so they find
+  // the solution already compiled in it
+  MIOpenHandlePool::Lease handle_lease;
+  MIOPEN_RETURN_IF_ERROR(ort_api_, handle_pool_.Acquire(compile_stream_, handle_lease));
+
+  auto conv_op = std::make_unique<ConvOp>(ort_api_, logger_, std::move(info));
+  RETURN_IF_ERROR(conv_op->Compile(handle_lease.Get(), *conv_algo_cache_));
+  op = std::move(conv_op);
+  return nullptr;
+}
+
+OrtStatus* GpuBackend::LoadConv(std::unique_ptr<ConvOpInfo> info, ContextReader& reader, bool same_fingerprint,
+                                std::unique_ptr<Op>& op) {
+  MIOpenHandlePool::Lease handle_lease;
+  MIOPEN_RETURN_IF_ERROR(ort_api_, handle_pool_.Acquire(compile_stream_, handle_lease));
+
+  auto conv_op = std::make_unique<ConvOp>(ort_api_, logger_, std::move(info));
+  RETURN_IF_ERROR(conv_op->Load(handle_lease.Get(), reader, *conv_algo_cache_, same_fingerprint));
+  op = std::move(conv_op);
+  return nullptr;
+}
+
+OrtStatus* GpuBackend::CompileMatMul(std::unique_ptr<MatMulOpInfo> info, std::unique_ptr<Op>& op) {
+  hipblasLtHandle_t blaslt_handle = nullptr;
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, blaslt_handle_.Get(blaslt_handle));
+
+  auto matmul_op = std::make_unique<MatMulOp>(ort_api_, logger_, std::move(info));
+  RETURN_IF_ERROR(matmul_op->Compile(blaslt_handle));
+  op = std::move(matmul_op);
+  return nullptr;
+}
+
+OrtStatus* GpuBackend::CompilePool(std::unique_ptr<PoolOpInfo> info, std::unique_ptr<Op>& op) {
+  auto pool_op = std::make_unique<PoolOp>(ort_api_, logger_, std::move(info));
+  RETURN_IF_ERROR(pool_op->Compile());
+  op = std::move(pool_op);
+  return nullptr;
+}
+
+OrtStatus* GpuBackend::CompilePointwise(std::unique_ptr<PointwiseOpInfo> info, std::unique_ptr<Op>& op) {
+  auto pointwise_op = std::make_unique<PointwiseOp>(ort_api_, logger_, std::move(info));
+  RETURN_IF_ERROR(pointwise_op->Compile());
+  op = std::move(pointwise_op);
+  return nullptr;
+}
+
+OrtStatus* GpuBackend::Run(Ort::KernelContext& context, size_t scratch_size, const RunFn& run) {
+  // Work is enqueued on ORT's stream for this node (the null stream if ORT provides none)
+  hipStream_t stream = static_cast<hipStream_t>(context.GetGPUComputeStream());
+
+  MIOpenHandlePool::Lease handle_lease;
+  MIOPEN_RETURN_IF_ERROR(ort_api_, handle_pool_.Acquire(stream, handle_lease));
+
+  ExecutionContext ctx;
+  ctx.miopen_handle = handle_lease.Get();
+  ctx.stream = stream;
+
+  // Lease scratch memory ordered on the same stream. The lease is exclusive, so concurrent runs
+  // sharing a stream never see each other's intermediates.
+  WorkspaceArena::Lease scratch_lease;
+  hipError_t hip_err = workspace_arena_.Acquire(stream, scratch_size, scratch_lease);
+  if (hip_err != hipSuccess) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Failed to acquire workspace: " << hipGetErrorString(hip_err));
+  }
+
+  return run(ctx, scratch_lease.Get());
+}
+
+}  // namespace hipdnn_ep
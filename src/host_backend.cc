@@ -0,0 +1,125 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/host_backend.h"
+#include "hipdnn_ep/host_conv_op.h"
+#include "hipdnn_ep/host_gemm.h"
+#include "hipdnn_ep/host_layout.h"
+#include "hipdnn_ep/host_matmul_op.h"
+#include "hipdnn_ep/host_pointwise_op.h"
+#include "hipdnn_ep/host_pool_op.h"
+
+#include <algorithm>
+
+namespace hipdnn_ep {
+
+namespace {
+
+// Scratch buffers are aligned for the widest vector loads the ops' loops may be compiled to
+constexpr size_t kScratchAlignment = 64;
+
+}  // namespace
+
+void HostBackend::AlignedDelete::operator()(char* ptr) const {
+  ::operator delete[](ptr, std::align_val_t{kScratchAlignment});
+}
+
+HostBackend::HostBackend(const OrtApi& ort_api, const OrtLogger& logger, size_t num_threads)
+    : ort_api_(ort_api), logger_(logger), thread_pool_(num_threads) {
+  LOG(ort_api_, logger_, INFO,
+      "HipDNN EP: Host backend running on " << thread_pool_.NumThreads() << " threads, GEMM micro-kernel: "
+                                            << GetGemmMicroKernel().isa);
+}
+
+bool HostBackend::SupportsDataType(ONNXTensorElementDataType type) const {
+  return type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+}
+
+int64_t HostBackend::BlockedLayoutChannels() const {
+  return kHostBlockChannels;
+}
+
+OrtStatus* HostBackend::CompileConv(std::unique_ptr<ConvOpInfo> info, std::unique_ptr<Op>& op) {
+  auto conv_op = std::make_unique<HostConvOp>(ort_api_, logger_, std::move(info), thread_pool_);
+  RETURN_IF_ERROR(conv_op->Compile());
+  op = std::move(conv_op);
+  return nullptr;
+}
+
+OrtStatus* HostBackend::LoadConv(std::unique_ptr<ConvOpInfo> info, ContextReader& /*reader*/,
+                                 bool /*same_fingerprint*/, std::unique_ptr<Op>& op) {
+  // A host Conv serializes nothing beyond its info
+  return CompileConv(std::move(info), op);
+}
+
+OrtStatus* HostBackend::CompileMatMul(std::unique_ptr<MatMulOpInfo> info, std::unique_ptr<Op>& op) {
+  auto matmul_op = std::make_unique<HostMatMulOp>(ort_api_, logger_, std::move(info), thread_pool_);
+  RETURN_IF_ERROR(matmul_op->Compile());
+  op = std::move(matmul_op);
+  return nullptr;
+}
+
+OrtStatus* HostBackend::CompilePool(std::unique_ptr<PoolOpInfo> info, std::unique_ptr<Op>& op) {
+  auto pool_op = std::make_unique<HostPoolOp>(ort_api_, logger_, std::move(info), thread_pool_);
+  RETURN_IF_ERROR(pool_op->Compile());
+  op = std::move(pool_op);
+  return nullptr;
+}
+
+OrtStatus* HostBackend::CompilePointwise(std::unique_ptr<PointwiseOpInfo> info, std::unique_ptr<Op>& op) {
+  auto pointwise_op = std::make_unique<HostPointwiseOp>(ort_api_, logger_, std::move(info), thread_pool_);
+  RETURN_IF_ERROR(pointwise_op->Compile());
+  op = std::move(pointwise_op);
+  return nullptr;
+}
+
+void HostBackend::ReserveScratch(size_t size) {
+  std::lock_guard<std::mutex> lock(scratch_mutex_);
+  reserved_size_ = std::max(reserved_size_, size);
+}
+
+OrtStatus* HostBackend::Run(Ort::KernelContext& /*context*/, size_t scratch_size, const RunFn& run) {
+  ScratchBuffer scratch = AcquireScratch(scratch_size);
+
+  // Host ops run synchronously on the calling thread and the backend's pool: no handle, no stream
+  ExecutionContext ctx;
+  OrtStatus* status = run(ctx, scratch.data.get());
+
+  ReleaseScratch(std::move(scratch));
+  return status;
+}
+
+HostBackend::ScratchBuffer HostBackend::AcquireScratch(size_t size) {
+  if (size == 0) {
+    return ScratchBuffer{};
+  }
+
+  size_t alloc_size = 0;
+  {
+    std::lock_guard<std::mutex> lock(scratch_mutex_);
+    auto it = std::find_if(free_scratch_.begin(), free_scratch_.end(),
+                           [size](const ScratchBuffer& buffer) { return buffer.size >= size; });
+    if (it != free_scratch_.end()) {
+      ScratchBuffer buffer = std::move(*it);
+      free_scratch_.erase(it);
+      return buffer;
+    }
+    // Size new buffers for the largest kernel, so one buffer per concurrent call serves all of them
+    alloc_size = std::max(size, reserved_size_);
+  }
+
+  ScratchBuffer buffer;
+  buffer.data.reset(static_cast<char*>(::operator new[](alloc_size, std::align_val_t{kScratchAlignment})));
+  buffer.size = alloc_size;
+  return buffer;
+}
+
+void HostBackend::ReleaseScratch(ScratchBuffer buffer) {
+  if (buffer.data == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(scratch_mutex_);
+  free_scratch_.push_back(std::move(buffer));
+}
+
+}  // namespace hipdnn_ep
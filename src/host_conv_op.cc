@@ -0,0 +1,1024 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/host_conv_op.h"
+#include "hipdnn_ep/host_pointwise_op.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace hipdnn_ep {
+
+namespace {
+
+// GEMM blocking: a task packs up to kGemmKc x kGemmNc of the im2col matrix at a time (256 KB), which stays
+// in L2 while every micro-kernel panel of the weights streams over it
+constexpr int64_t kGemmKc = 256;
+constexpr int64_t kGemmNc = 256;
+
+// Winograd blocking: a task transforms up to kWinogradKc input channels of up to kWinogradNc tiles at a time,
+// and accumulates at most about kWinogradMc output channels. Each micro-kernel panel of the transformed weights
+// is then reused across kWinogradNc / nr panels of tiles, which keeps the 36 weight matrices from being
+// streamed from memory once per nr tiles.
+constexpr int64_t kWinogradKc = 64;
+constexpr int64_t kWinogradMc = 144;
+constexpr int64_t kWinogradNc = 64;
+
+// F(4x4, 3x3): 4x4 outputs from 6x6 inputs, 36 transformed positions
+constexpr int64_t kWinogradTile = 6;
+constexpr int64_t kWinogradOut = 4;
+constexpr int64_t kWinogradPositions = kWinogradTile * kWinogradTile;
+
+// The Winograd transforms run this many lanes at a time; every micro-kernel's nr is a multiple of it
+constexpr int64_t kWinogradLanes = 8;
+
+// Depthwise blocking: a task packs the input rows of as many output rows as fit in kDepthwiseStripFloats
+// (64 KB), so they stay in L2 while the kernel reads each of them up to kh times
+constexpr int64_t kDepthwiseStripFloats = 16384;
+
+// Weight floats packed per ParallelFor task
+constexpr int64_t kPackGrain = 16384;
+
+// Winograd F(4x4, 3x3) transforms (the Lavin & Gray matrices, interpolation points 0, +-1, +-2 and infinity).
+// Each applies the 1D transform along one axis. The input and output transforms run kWinogradLanes
+// interleaved problems, rows `src_step` and `dst_step` floats apart; the fixed-size lane loops vectorize.
+
+// u = G g: 3 taps -> 6 transformed values
+inline void WeightTransform1D(const float* g, int64_t g_step, float* u, int64_t u_step) {
+  const float g0 = g[0];
+  const float g1 = g[g_step];
+  const float g2 = g[2 * g_step];
+  u[0] = g0 / 4.0f;
+  u[u_step] = -(g0 + g1 + g2) / 6.0f;
+  u[2 * u_step] = -(g0 - g1 + g2) / 6.0f;
+  u[3 * u_step] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+  u[4 * u_step] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+  u[5 * u_step] = g2;
+}
+
+// v = B^T d: 6 rows -> 6
+inline void InputTransform1D(const float* d, int64_t src_step, float* v, int64_t dst_step) {
+  float in[kWinogradTile][kWinogradLanes];
+  float out[kWinogradTile][kWinogradLanes];
+  for (int64_t r = 0; r < kWinogradTile; ++r) {
+    std::copy(d + r * src_step, d + r * src_step + kWinogradLanes, in[r]);
+  }
+  for (int64_t l = 0; l < kWinogradLanes; ++l) {
+    out[0][l] = 4.0f * in[0][l] - 5.0f * in[2][l] + in[4][l];
+    out[1][l] = -4.0f * (in[1][l] + in[2][l]) + in[3][l] + in[4][l];
+    out[2][l] = 4.0f * (in[1][l] - in[2][l]) - in[3][l] + in[4][l];
+    out[3][l] = 2.0f * (in[3][l] - in[1][l]) - in[2][l] + in[4][l];
+    out[4][l] = 2.0f * (in[1][l] - in[3][l]) - in[2][l] + in[4][l];
+    out[5][l] = 4.0f * in[1][l] - 5.0f * in[3][l] + in[5][l];
+  }
+  for (int64_t r = 0; r < kWinogradTile; ++r) {
+    std::copy(out[r], out[r] + kWinogradLanes, v + r * dst_step);
+  }
+}
+
+// o = A^T m: 6 rows -> 4
+inline void OutputTransform1D(const float* m, int64_t src_step, float* o, int64_t dst_step) {
+  float in[kWinogradTile][kWinogradLanes];
+  float out[kWinogradOut][kWinogradLanes];
+  for (int64_t r = 0; r < kWinogradTile; ++r) {
+    std::copy(m + r * src_step, m + r * src_step + kWinogradLanes, in[r]);
+  }
+  for (int64_t l = 0; l < kWinogradLanes; ++l) {
+    out[0][l] = in[0][l] + in[1][l] + in[2][l] + in[3][l] + in[4][l];
+    out[1][l] = in[1][l] - in[2][l] + 2.0f * (in[3][l] - in[4][l]);
+    out[2][l] = in[1][l] + in[2][l] + 4.0f * (in[3][l] + in[4][l]);
+    out[3][l] = in[1][l] - in[2][l] + 8.0f * (in[3][l] - in[4][l]) + in[5][l];
+  }
+  for (int64_t r = 0; r < kWinogradOut; ++r) {
+    std::copy(out[r], out[r] + kWinogradLanes, o + r * dst_step);
+  }
+}
+
+// [begin, end) of the positions `a` in [0, limit_a) for which a * stride + offset lies in [0, limit_b)
+std::pair<int64_t, int64_t> TapRange(int64_t limit_a, int64_t limit_b, int64_t stride, int64_t offset) {
+  const int64_t begin = offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+  const int64_t last = limit_b - 1 - offset;
+  const int64_t end = last < 0 ? 0 : std::min(last / stride + 1, limit_a);
+  return {begin, std::max(begin, end)};
+}
+
+}  // namespace
+
+HostConvOp::HostConvOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<ConvOpInfo> info,
+                       ThreadPool& thread_pool)
+    : Op(std::move(info)), ort_api_(ort_api), logger_(logger), thread_pool_(thread_pool) {
+}
+
+OrtStatus* HostConvOp::Compile(const HostConvOverrides& overrides) {
+  const ConvOpInfo& info = ConvInfo();
+
+  const size_t rank = info.x_shape.size();
+  if (rank < 3 || rank > 5 || info.w_shape.size() != rank || info.y_shape.size() != rank) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Only 1D, 2D and 3D convolution are supported, node: " << info.node_name);
+  }
+  if (info.dtype != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Host convolution only supports float, node: " << info.node_name);
+  }
+
+  c_in_ = info.x_shape[1];
+  c_out_ = info.y_shape[1];
+
+  // Right-align the spatial dims in (D, H, W); missing leading dims are a unit window over a unit extent
+  const size_t spatial_dims = rank - 2;
+  const size_t lead = 3 - spatial_dims;
+  x_dims_.fill(1);
+  y_dims_.fill(1);
+  k_dims_.fill(1);
+  strides_.fill(1);
+  dilations_.fill(1);
+  pads_.fill(0);
+  for (size_t i = 0; i < spatial_dims; ++i) {
+    x_dims_[lead + i] = info.x_shape[2 + i];
+    y_dims_[lead + i] = info.y_shape[2 + i];
+    k_dims_[lead + i] = info.w_shape[2 + i];
+    strides_[lead + i] = info.strides[i];
+    dilations_[lead + i] = info.dilations[i];
+    pads_[lead + i] = info.pads[i];
+  }
+
+  // Plain until the Kernel says otherwise
+  x_layout_ = {false, c_in_, x_dims_[0] * x_dims_[1] * x_dims_[2]};
+  y_layout_ = {false, c_out_, y_dims_[0] * y_dims_[1] * y_dims_[2]};
+
+  for (size_t d = 0; d < 3; ++d) {
+    tap_ranges_[d].clear();
+    for (int64_t k = 0; k < k_dims_[d]; ++k) {
+      const int64_t offset = k * dilations_[d] - pads_[d];
+      tap_ranges_[d].push_back(info.transposed ? TapRange(x_dims_[d], y_dims_[d], strides_[d], offset)
+                                               : TapRange(y_dims_[d], x_dims_[d], strides_[d], offset));
+    }
+  }
+
+  const int64_t c_in_group = c_in_ / info.group;
+  const int64_t c_out_group = c_out_ / info.group;
+  gemm_ = overrides.gemm != nullptr ? overrides.gemm : &GetGemmMicroKernel();
+  depthwise_ = overrides.depthwise != nullptr ? overrides.depthwise : &GetDepthwiseKernel();
+  if (overrides.algo.has_value() && !AlgoApplies(*overrides.algo)) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL,
+                 "Host convolution algorithm " << static_cast<int>(*overrides.algo) << " does not apply to node "
+                                               << info.node_name);
+  }
+  algo_ = overrides.algo.has_value() ? *overrides.algo : SelectAlgo();
+  const int64_t threads = static_cast<int64_t>(thread_pool_.NumThreads());
+  tasks_ = 0;
+  packed_size_ = 0;
+  if (algo_ == Algo::kDepthwise) {
+    channel_blocks_ = (c_out_ + kHostBlockChannels - 1) / kHostBlockChannels;
+    packed_size_ = channel_blocks_ * (k_dims_[1] * k_dims_[2] + 1) * kHostBlockChannels;
+    depthwise_x_cols_ = (y_dims_[2] - 1) * strides_[2] + (k_dims_[2] - 1) * dilations_[2] + 1;
+
+    // Strips as tall as the packing budget allows, but short enough to give every thread a task
+    const int64_t window = (k_dims_[1] - 1) * dilations_[1] + 1;
+    const int64_t budget_rows = kDepthwiseStripFloats / (depthwise_x_cols_ * kHostBlockChannels);
+    const int64_t planes = info.y_shape[0] * channel_blocks_;
+    const int64_t min_strips = (threads + planes - 1) / planes;
+    depthwise_rows_ = std::clamp<int64_t>((budget_rows - window) / strides_[1] + 1, 1, y_dims_[1]);
+    depthwise_rows_ = std::min(depthwise_rows_, (y_dims_[1] + min_strips - 1) / min_strips);
+    depthwise_strips_ = (y_dims_[1] + depthwise_rows_ - 1) / depthwise_rows_;
+    tasks_ = planes * depthwise_strips_;
+  } else if (algo_ != Algo::kDirect) {
+    const int64_t mr = gemm_->mr;
+    const int64_t m_panels = (c_out_group + mr - 1) / mr;
+    int64_t kc_max = kGemmKc;
+    int64_t min_m_splits = 1;
+    if (algo_ == Algo::kGemm) {
+      gemm_k_ = c_in_group * k_dims_[0] * k_dims_[1] * k_dims_[2];
+      packed_group_size_ = static_cast<int64_t>(PackedGemmASize(*gemm_, c_out_group, gemm_k_));
+      block_cols_ = std::max<int64_t>(1, kGemmNc / gemm_->nr) * gemm_->nr;
+      blocks_ = (y_dims_[0] * y_dims_[1] * y_dims_[2] + block_cols_ - 1) / block_cols_;
+    } else {
+      gemm_k_ = c_in_group;
+      packed_group_size_ = kWinogradPositions * static_cast<int64_t>(PackedGemmASize(*gemm_, c_out_group, gemm_k_));
+      winograd_tiles_w_ = (y_dims_[2] + kWinogradOut - 1) / kWinogradOut;
+      winograd_tiles_ = winograd_tiles_w_ * ((y_dims_[1] + kWinogradOut - 1) / kWinogradOut);
+      // As few panels of tiles per block as cover the tiles evenly, up to kWinogradNc
+      const int64_t nr = gemm_->nr;
+      const int64_t max_block_panels = std::max<int64_t>(1, kWinogradNc / nr);
+      const int64_t tile_panels = (winograd_tiles_ + nr - 1) / nr;
+      blocks_ = (tile_panels + max_block_panels - 1) / max_block_panels;
+      block_cols_ = (tile_panels + blocks_ - 1) / blocks_ * nr;
+      kc_max = kWinogradKc;
+      const int64_t mc_panels = std::max<int64_t>(1, kWinogradMc / mr);
+      min_m_splits = (m_panels + mc_panels - 1) / mc_panels;
+    }
+
+    // Even K blocks: a short last block would cost a full pass over the outputs for little work
+    const int64_t k_blocks = (gemm_k_ + kc_max - 1) / kc_max;
+    gemm_kc_ = (gemm_k_ + k_blocks - 1) / k_blocks;
+
+    const int64_t tasks = info.y_shape[0] * info.group * blocks_ * min_m_splits;
+    m_splits_ = tasks >= threads ? min_m_splits : std::min(m_panels, min_m_splits * ((threads + tasks - 1) / tasks));
+    tasks_ = info.y_shape[0] * info.group * blocks_ * m_splits_;
+    packed_size_ = info.group * packed_group_size_;
+  }
+
+  packed_weights_.clear();
+  if (packed_size_ > 0 && info.HasConstantWeights()) {
+    packed_weights_.resize(static_cast<size_t>(packed_size_));
+    PackWeights(info.constant_weights.data(), info.constant_bias.data(), packed_weights_.data());
+  }
+
+  const char* algo_name = "direct";
+  const char* isa = nullptr;
+  switch (algo_) {
+    case Algo::kGemm:
+      algo_name = "gemm";
+      isa = gemm_->isa;
+      break;
+    case Algo::kWinograd:
+      algo_name = "winograd";
+      isa = gemm_->isa;
+      break;
+    case Algo::kDepthwise:
+      algo_name = "depthwise";
+      isa = depthwise_->isa;
+      break;
+    case Algo::kDirect:
+      break;
+  }
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << " (host): c_in=" << c_in_ << ", c_out=" << c_out_
+                   << ", group: " << info.group << ", bias: " << info.has_bias
+                   << ", activation: " << static_cast<int>(info.activation.kind)
+                   << ", algorithm: " << algo_name
+                   << (isa != nullptr ? std::string(" (") + isa + ")" : std::string()));
+
+  return nullptr;
+}
+
+BlockedLayoutSupport HostConvOp::SupportsBlockedLayout() const {
+  return algo_ != Algo::kDirect ? BlockedLayoutSupport::kIndependent : BlockedLayoutSupport::kNone;
+}
+
+void HostConvOp::UseBlockedLayout(bool input, bool output) {
+  x_layout_.blocked = input;
+  y_layout_.blocked = output;
+}
+
+size_t HostConvOp::WorkspaceSize() const {
+  if (ConvInfo().HasConstantWeights()) {
+    return 0;
+  }
+  return static_cast<size_t>(packed_size_) * sizeof(float);
+}
+
+OrtStatus* HostConvOp::Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                               const std::vector<void*>& outputs) const {
+  const ConvOpInfo& info = ConvInfo();
+  const auto* x = static_cast<const float*>(inputs[0]);
+  const float* w = info.HasConstantWeights() ? info.constant_weights.data() : static_cast<const float*>(inputs[1]);
+  const float* bias = info.HasConstantWeights() ? info.constant_bias.data()
+                                      : (info.has_bias ? static_cast<const float*>(inputs[2]) : nullptr);
+  auto* y = static_cast<float*>(outputs[0]);
+
+  if (algo_ != Algo::kDirect) {
+    const float* packed_w = packed_weights_.data();
+    if (!info.HasConstantWeights()) {
+      auto* workspace = static_cast<float*>(ctx.workspace);
+      PackWeights(w, bias, workspace);
+      packed_w = workspace;
+    }
+
+    thread_pool_.ParallelFor(tasks_, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t task = begin; task < end; ++task) {
+        if (algo_ == Algo::kDepthwise) {
+          RunDepthwiseTask(task, x, packed_w, y);
+        } else if (algo_ == Algo::kWinograd) {
+          RunWinogradTask(task, x, packed_w, bias, y);
+        } else {
+          RunGemmTask(task, x, packed_w, bias, y);
+        }
+      }
+    });
+    return nullptr;
+  }
+
+  // One task per output plane: it is written by a single thread and stays in cache across all taps
+  const int64_t planes = info.y_shape[0] * c_out_;
+  thread_pool_.ParallelFor(planes, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t plane = begin; plane < end; ++plane) {
+      if (info.transposed) {
+        RunTransposedPlane(plane, x, w, bias, y);
+      } else {
+        RunForwardPlane(plane, x, w, bias, y);
+      }
+    }
+  });
+  return nullptr;
+}
+
+void HostConvOp::RunForwardPlane(int64_t plane, const float* x, const float* w, const float* bias,
+                                 float* y) const {
+  const ConvOpInfo& info = ConvInfo();
+  const int64_t c_in_group = c_in_ / info.group;
+  const int64_t c_out_group = c_out_ / info.group;
+  const int64_t n = plane / c_out_;
+  const int64_t c = plane % c_out_;
+  const int64_t g = c / c_out_group;
+
+  const int64_t x_plane_size = x_dims_[0] * x_dims_[1] * x_dims_[2];
+  const int64_t y_plane_size = y_dims_[0] * y_dims_[1] * y_dims_[2];
+  const int64_t k_size = k_dims_[0] * k_dims_[1] * k_dims_[2];
+
+  float* y_plane = y + plane * y_plane_size;
+  std::fill(y_plane, y_plane + y_plane_size, bias != nullptr ? bias[c] : 0.0f);
+
+  // W is [C_out, C_in / group, k...]
+  for (int64_t ci = 0; ci < c_in_group; ++ci) {
+    const float* x_plane = x + (n * c_in_ + g * c_in_group + ci) * x_plane_size;
+    const float* w_taps = w + (c * c_in_group + ci) * k_size;
+
+    for (int64_t kd = 0; kd < k_dims_[0]; ++kd) {
+      for (int64_t kh = 0; kh < k_dims_[1]; ++kh) {
+        for (int64_t kw = 0; kw < k_dims_[2]; ++kw) {
+          const float weight = w_taps[(kd * k_dims_[1] + kh) * k_dims_[2] + kw];
+          const auto [od_begin, od_end] = tap_ranges_[0][kd];
+          const auto [oh_begin, oh_end] = tap_ranges_[1][kh];
+          const auto [ow_begin, ow_end] = tap_ranges_[2][kw];
+          const int64_t w_offset = kw * dilations_[2] - pads_[2];
+
+          for (int64_t od = od_begin; od < od_end; ++od) {
+            const int64_t id = od * strides_[0] + kd * dilations_[0] - pads_[0];
+            for (int64_t oh = oh_begin; oh < oh_end; ++oh) {
+              const int64_t ih = oh * strides_[1] + kh * dilations_[1] - pads_[1];
+              float* y_row = y_plane + (od * y_dims_[1] + oh) * y_dims_[2];
+              const float* x_row = x_plane + (id * x_dims_[1] + ih) * x_dims_[2];
+
+              // Every output of the range reads inside the input row, so the loop has no bounds checks
+              if (strides_[2] == 1) {
+                for (int64_t ow = ow_begin; ow < ow_end; ++ow) {
+                  y_row[ow] += weight * x_row[ow + w_offset];
+                }
+              } else {
+                for (int64_t ow = ow_begin; ow < ow_end; ++ow) {
+                  y_row[ow] += weight * x_row[ow * strides_[2] + w_offset];
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (info.activation.kind != Activation::Kind::kNone) {
+    ApplyPointwiseInPlace(ToPointwiseFunc(info.activation.kind), info.activation.alpha, info.activation.beta,
+                          y_plane, y_plane_size);
+  }
+}
+
+void HostConvOp::RunTransposedPlane(int64_t plane, const float* x, const float* w, const float* bias,
+                                    float* y) const {
+  const ConvOpInfo& info = ConvInfo();
+  const int64_t c_in_group = c_in_ / info.group;
+  const int64_t c_out_group = c_out_ / info.group;
+  const int64_t n = plane / c_out_;
+  const int64_t c = plane % c_out_;
+  const int64_t g = c / c_out_group;
+
+  const int64_t x_plane_size = x_dims_[0] * x_dims_[1] * x_dims_[2];
+  const int64_t y_plane_size = y_dims_[0] * y_dims_[1] * y_dims_[2];
+  const int64_t k_size = k_dims_[0] * k_dims_[1] * k_dims_[2];
+
+  float* y_plane = y + plane * y_plane_size;
+  std::fill(y_plane, y_plane + y_plane_size, bias != nullptr ? bias[c] : 0.0f);
+
+  // W is [C_in, C_out / group, k...]; every input of the group scatters into this output plane
+  for (int64_t ci = 0; ci < c_in_group; ++ci) {
+    const int64_t channel = g * c_in_group + ci;
+    const float* x_plane = x + (n * c_in_ + channel) * x_plane_size;
+    const float* w_taps = w + (channel * c_out_group + c % c_out_group) * k_size;
+
+    for (int64_t kd = 0; kd < k_dims_[0]; ++kd) {
+      for (int64_t kh = 0; kh < k_dims_[1]; ++kh) {
+        for (int64_t kw = 0; kw < k_dims_[2]; ++kw) {
+          const float weight = w_taps[(kd * k_dims_[1] + kh) * k_dims_[2] + kw];
+          const auto [id_begin, id_end] = tap_ranges_[0][kd];
+          const auto [ih_begin, ih_end] = tap_ranges_[1][kh];
+          const auto [iw_begin, iw_end] = tap_ranges_[2][kw];
+          const int64_t w_offset = kw * dilations_[2] - pads_[2];
+
+          for (int64_t id = id_begin; id < id_end; ++id) {
+            const int64_t od = id * strides_[0] + kd * dilations_[0] - pads_[0];
+            for (int64_t ih = ih_begin; ih < ih_end; ++ih) {
+              const int64_t oh = ih * strides_[1] + kh * dilations_[1] - pads_[1];
+              float* y_row = y_plane + (od * y_dims_[1] + oh) * y_dims_[2];
+              const float* x_row = x_plane + (id * x_dims_[1] + ih) * x_dims_[2];
+
+              if (strides_[2] == 1) {
+                for (int64_t iw = iw_begin; iw < iw_end; ++iw) {
+                  y_row[iw + w_offset] += weight * x_row[iw];
+                }
+              } else {
+                for (int64_t iw = iw_begin; iw < iw_end; ++iw) {
+                  y_row[iw * strides_[2] + w_offset] += weight * x_row[iw];
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (info.activation.kind != Activation::Kind::kNone) {
+    ApplyPointwiseInPlace(ToPointwiseFunc(info.activation.kind), info.activation.alpha, info.activation.beta,
+                          y_plane, y_plane_size);
+  }
+}
+
+bool HostConvOp::AlgoApplies(Algo algo) const {
+  const ConvOpInfo& info = ConvInfo();
+  if (algo == Algo::kDirect) {
+    return true;
+  }
+  if (info.transposed) {
+    return false;
+  }
+  switch (algo) {
+    case Algo::kWinograd:
+      return info.x_shape.size() == 4 && k_dims_[1] == 3 && k_dims_[2] == 3 && strides_[1] == 1 &&
+             strides_[2] == 1 && dilations_[1] == 1 && dilations_[2] == 1;
+    case Algo::kDepthwise:
+      return c_in_ == info.group && c_out_ == info.group && info.x_shape.size() <= 4;
+    default:
+      return true;
+  }
+}
+
+HostConvOp::Algo HostConvOp::SelectAlgo() const {
+  const ConvOpInfo& info = ConvInfo();
+  const int64_t c_in_group = c_in_ / info.group;
+  const int64_t c_out_group = c_out_ / info.group;
+  if (info.transposed) {
+    return Algo::kDirect;
+  }
+  if (c_in_group == 1 && c_out_group == 1) {
+    return AlgoApplies(Algo::kDepthwise) ? Algo::kDepthwise : Algo::kDirect;
+  }
+  if (!AlgoApplies(Algo::kWinograd)) {
+    return Algo::kGemm;
+  }
+
+  // Multiply-adds per image and group. The GEMM pads the output positions, and Winograd the 4x4 tiles, to
+  // whole micro-kernel panels. A 6x6 transform costs about as much as 12 multiply-adds per position.
+  const int64_t nr = gemm_->nr;
+  auto round_up = [nr](int64_t value) { return (value + nr - 1) / nr * nr; };
+  const int64_t tiles_h = (y_dims_[1] + kWinogradOut - 1) / kWinogradOut;
+  const int64_t tiles = tiles_h * ((y_dims_[2] + kWinogradOut - 1) / kWinogradOut);
+  const int64_t gemm_cost = 9 * c_in_group * c_out_group * round_up(y_dims_[1] * y_dims_[2]);
+  const int64_t mc_splits = (c_out_group + kWinogradMc - 1) / kWinogradMc;
+  const int64_t transform_cost = 12 * kWinogradPositions * tiles * (c_in_group * mc_splits + c_out_group);
+  const int64_t winograd_cost = kWinogradPositions * c_in_group * c_out_group * round_up(tiles) + transform_cost;
+  return winograd_cost < gemm_cost ? Algo::kWinograd : Algo::kGemm;
+}
+
+void HostConvOp::PackWeights(const float* w, const float* bias, float* packed) const {
+  if (algo_ == Algo::kDepthwise) {
+    // W is [C, 1, kh, kw]; channel c of a block is lane c % kHostBlockChannels of every tap
+    const int64_t lanes = kHostBlockChannels;
+    const int64_t taps = k_dims_[1] * k_dims_[2];
+    for (int64_t block = 0; block < channel_blocks_; ++block) {
+      float* packed_block = packed + block * (taps + 1) * lanes;
+      for (int64_t lane = 0; lane < lanes; ++lane) {
+        const int64_t c = block * lanes + lane;
+        for (int64_t tap = 0; tap < taps; ++tap) {
+          packed_block[tap * lanes + lane] = c < c_out_ ? w[c * taps + tap] : 0.0f;
+        }
+        packed_block[taps * lanes + lane] = c < c_out_ && bias != nullptr ? bias[c] : 0.0f;
+      }
+    }
+    return;
+  }
+
+  const int64_t c_out_group = c_out_ / ConvInfo().group;
+  const int64_t mr = gemm_->mr;
+  const int64_t m_panels = (c_out_group + mr - 1) / mr;
+
+  // Panels are independent, so the packing is split over them; W rows of a group are contiguous
+  const int64_t positions = algo_ == Algo::kWinograd ? kWinogradPositions : 1;
+  const int64_t grain = std::max<int64_t>(1, kPackGrain / (positions * mr * gemm_k_));
+  thread_pool_.ParallelFor(ConvInfo().group * m_panels, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; ++task) {
+      const int64_t g = task / m_panels;
+      const int64_t row0 = (task % m_panels) * mr;
+      const int64_t rows = std::min(mr, c_out_group - row0);
+      if (algo_ == Algo::kGemm) {
+        PackGemmAPanels(*gemm_, rows, gemm_k_, w + (g * c_out_group + row0) * gemm_k_, gemm_k_,
+                        packed + g * packed_group_size_ + row0 * gemm_k_);
+        continue;
+      }
+
+      // U = G g G^T per filter, scattered into the panel of each of the 36 positions
+      const int64_t position_size = packed_group_size_ / kWinogradPositions;
+      float* panel = packed + g * packed_group_size_ + row0 * gemm_k_;
+      for (int64_t ci = 0; ci < gemm_k_; ++ci) {
+        for (int64_t i = 0; i < mr; ++i) {
+          float u[kWinogradPositions] = {};
+          if (i < rows) {
+            const float* filter = w + ((g * c_out_group + row0 + i) * gemm_k_ + ci) * 9;
+            float t[kWinogradTile * 3];
+            for (int64_t c = 0; c < 3; ++c) {
+              WeightTransform1D(filter + c, 3, t + c, 3);
+            }
+            for (int64_t r = 0; r < kWinogradTile; ++r) {
+              WeightTransform1D(t + r * 3, 1, u + r * kWinogradTile, 1);
+            }
+          }
+          for (int64_t p = 0; p < kWinogradPositions; ++p) {
+            panel[p * position_size + ci * mr + i] = u[p];
+          }
+        }
+      }
+    }
+  });
+}
+
+void HostConvOp::PackInputTile(const float* x_image, int64_t c0, int64_t k0, int64_t kc, int64_t col0,
+                               int64_t cols, float* packed) const {
+  const int64_t nr = gemm_->nr;
+  const int64_t panel_size = kc * nr;
+  const int64_t k_size = k_dims_[0] * k_dims_[1] * k_dims_[2];
+  const int64_t position_stride = x_layout_.PositionStride();
+
+  for (int64_t kk = 0; kk < kc; ++kk) {
+    // Row r of the im2col matrix is input channel r / k_size seen through kernel tap r % k_size
+    const int64_t r = k0 + kk;
+    const int64_t tap = r % k_size;
+    const int64_t kd = tap / (k_dims_[1] * k_dims_[2]);
+    const int64_t kh = (tap / k_dims_[2]) % k_dims_[1];
+    const int64_t kw = tap % k_dims_[2];
+    const float* x_plane = x_image + x_layout_.ChannelOffset(c0 + r / k_size);
+    const auto [od_begin, od_end] = tap_ranges_[0][kd];
+    const auto [oh_begin, oh_end] = tap_ranges_[1][kh];
+    const auto [ow_begin, ow_end] = tap_ranges_[2][kw];
+    const int64_t w_offset = kw * dilations_[2] - pads_[2];
+
+    // Column j of the tile goes to lane j % nr of panel j / nr. `put` writes `count` consecutive columns,
+    // read `stride` apart from `src` or zeros when it is null, one panel-contiguous run at a time.
+    float* dst = packed + kk * nr;
+    int64_t lane = 0;
+    auto put = [&](const float* src, int64_t stride, int64_t count) {
+      while (count > 0) {
+        const int64_t run = std::min(count, nr - lane);
+        if (src == nullptr) {
+          std::fill(dst + lane, dst + lane + run, 0.0f);
+        } else if (stride == 1) {
+          std::copy(src, src + run, dst + lane);
+          src += run;
+        } else {
+          for (int64_t i = 0; i < run; ++i) {
+            dst[lane + i] = src[i * stride];
+          }
+          src += run * stride;
+        }
+        count -= run;
+        lane += run;
+        if (lane == nr) {
+          lane = 0;
+          dst += panel_size;
+        }
+      }
+    };
+
+    // Walk the tile one output row (od, oh) at a time: outside the tap's valid range it reads padding
+    int64_t col = col0;
+    while (col < col0 + cols) {
+      const int64_t y_row = col / y_dims_[2];
+      const int64_t ow_first = col % y_dims_[2];
+      const int64_t ow_last = std::min(y_dims_[2], ow_first + col0 + cols - col);
+      const int64_t od = y_row / y_dims_[1];
+      const int64_t oh = y_row % y_dims_[1];
+
+      if (od < od_begin || od >= od_end || oh < oh_begin || oh >= oh_end) {
+        put(nullptr, 0, ow_last - ow_first);
+      } else {
+        const int64_t id = od * strides_[0] + kd * dilations_[0] - pads_[0];
+        const int64_t ih = oh * strides_[1] + kh * dilations_[1] - pads_[1];
+        const float* x_row = x_plane + (id * x_dims_[1] + ih) * x_dims_[2] * position_stride;
+        const int64_t valid_begin = std::clamp(ow_begin, ow_first, ow_last);
+        const int64_t valid_end = std::clamp(ow_end, valid_begin, ow_last);
+        put(nullptr, 0, valid_begin - ow_first);
+        put(x_row + (valid_begin * strides_[2] + w_offset) * position_stride, strides_[2] * position_stride,
+            valid_end - valid_begin);
+        put(nullptr, 0, ow_last - valid_end);
+      }
+      col += ow_last - ow_first;
+    }
+
+    // Zero the unused lanes of a partial last panel, so the micro-kernel never reads stale values
+    if (lane != 0) {
+      std::fill(dst + lane, dst + nr, 0.0f);
+    }
+  }
+}
+
+void HostConvOp::RunGemmTask(int64_t task, const float* x, const float* packed_w, const float* bias,
+                             float* y) const {
+  const ConvOpInfo& info = ConvInfo();
+  const GemmMicroKernel& gemm = *gemm_;
+  const int64_t mr = gemm.mr;
+  const int64_t nr = gemm.nr;
+  const int64_t c_in_group = c_in_ / info.group;
+  const int64_t c_out_group = c_out_ / info.group;
+
+  const int64_t m_split = task % m_splits_;
+  const int64_t tile = (task / m_splits_) % blocks_;
+  const int64_t g = (task / (m_splits_ * blocks_)) % info.group;
+  const int64_t n = task / (m_splits_ * blocks_ * info.group);
+
+  const int64_t y_plane_size = y_layout_.plane_size;
+  const int64_t col0 = tile * block_cols_;
+  const int64_t cols = std::min(block_cols_, y_plane_size - col0);
+
+  const int64_t m_panels = (c_out_group + mr - 1) / mr;
+  const int64_t panels_per_split = (m_panels + m_splits_ - 1) / m_splits_;
+  const int64_t panel_begin = std::min(m_panels, m_split * panels_per_split);
+  const int64_t panel_end = std::min(m_panels, panel_begin + panels_per_split);
+
+  const float* x_image = x + n * x_layout_.ImageSize();
+  const float* w_group = packed_w + g * packed_group_size_;
+  float* y_image = y + n * y_layout_.ImageSize();
+  float* y_group = y_image + y_layout_.ChannelOffset(g * c_out_group);
+
+  // Reused by every task this thread runs; sized for the largest (kc, tile) block
+  thread_local std::vector<float> packed_x;
+  const int64_t n_panels = (cols + nr - 1) / nr;
+  packed_x.resize(static_cast<size_t>(gemm_kc_ * n_panels * nr));
+
+  // Edge blocks run on a full-size temporary, since micro-kernels always write mr x nr
+  float edge[kGemmMaxMr * kGemmMaxNr];
+
+  for (int64_t k0 = 0; k0 < gemm_k_; k0 += gemm_kc_) {
+    const int64_t kc = std::min(gemm_kc_, gemm_k_ - k0);
+    const bool accumulate = k0 > 0;
+    const bool last = k0 + kc == gemm_k_;
+    PackInputTile(x_image, g * c_in_group, k0, kc, col0, cols, packed_x.data());
+
+    for (int64_t panel = panel_begin; panel < panel_end; ++panel) {
+      const int64_t row0 = panel * mr;
+      const int64_t rows = std::min(mr, c_out_group - row0);
+      const float* a = w_group + row0 * gemm_k_ + k0 * mr;
+
+      if (y_layout_.blocked) {
+        // A blocked Y has each channel's positions kHostBlockChannels floats apart, so every block runs on the
+        // temporary: gathered from Y to accumulate, finished there, and scattered a position at a time
+        int64_t row_offsets[kGemmMaxMr];
+        for (int64_t i = 0; i < rows; ++i) {
+          row_offsets[i] = y_layout_.ChannelOffset(g * c_out_group + row0 + i);
+        }
+        for (int64_t np = 0; np < n_panels; ++np) {
+          const int64_t j0 = np * nr;
+          const int64_t block_cols = std::min(nr, cols - j0);
+          const float* b = packed_x.data() + np * kc * nr;
+          float* c = y_image + (col0 + j0) * kHostBlockChannels;
+
+          if (accumulate) {
+            for (int64_t j = 0; j < block_cols; ++j) {
+              for (int64_t i = 0; i < rows; ++i) {
+                edge[i * nr + j] = c[j * kHostBlockChannels + row_offsets[i]];
+              }
+            }
+          }
+          gemm.fn(kc, a, b, edge, nr, accumulate);
+          if (last) {
+            for (int64_t i = 0; bias != nullptr && i < rows; ++i) {
+              const float channel_bias = bias[g * c_out_group + row0 + i];
+              for (int64_t j = 0; j < block_cols; ++j) {
+                edge[i * nr + j] += channel_bias;
+              }
+            }
+            if (info.activation.kind != Activation::Kind::kNone) {
+              ApplyPointwiseInPlace(ToPointwiseFunc(info.activation.kind), info.activation.alpha,
+                                    info.activation.beta, edge, rows * nr);
+            }
+          }
+          for (int64_t j = 0; j < block_cols; ++j) {
+            for (int64_t i = 0; i < rows; ++i) {
+              c[j * kHostBlockChannels + row_offsets[i]] = edge[i * nr + j];
+            }
+          }
+        }
+        continue;
+      }
+
+      for (int64_t np = 0; np < n_panels; ++np) {
+        const int64_t j0 = np * nr;
+        const int64_t block_cols = std::min(nr, cols - j0);
+        const float* b = packed_x.data() + np * kc * nr;
+        float* c = y_group + row0 * y_plane_size + col0 + j0;
+
+        if (rows == mr && block_cols == nr) {
+          gemm.fn(kc, a, b, c, y_plane_size, accumulate);
+          continue;
+        }
+        if (accumulate) {
+          for (int64_t i = 0; i < rows; ++i) {
+            std::copy(c + i * y_plane_size, c + i * y_plane_size + block_cols, edge + i * nr);
+          }
+        }
+        gemm.fn(kc, a, b, edge, nr, accumulate);
+        for (int64_t i = 0; i < rows; ++i) {
+          std::copy(edge + i * nr, edge + i * nr + block_cols, c + i * y_plane_size);
+        }
+      }
+
+      // Bias and activation on this panel's rows of the tile while they are still in cache
+      if (last && (bias != nullptr || info.activation.kind != Activation::Kind::kNone)) {
+        for (int64_t i = 0; i < rows; ++i) {
+          float* y_row = y_group + (row0 + i) * y_plane_size + col0;
+          if (bias != nullptr) {
+            const float channel_bias = bias[g * c_out_group + row0 + i];
+            for (int64_t j = 0; j < cols; ++j) {
+              y_row[j] += channel_bias;
+            }
+          }
+          if (info.activation.kind != Activation::Kind::kNone) {
+            ApplyPointwiseInPlace(ToPointwiseFunc(info.activation.kind), info.activation.alpha,
+                                  info.activation.beta, y_row, cols);
+          }
+        }
+      }
+    }
+  }
+}
+
+void HostConvOp::RunWinogradTask(int64_t task, const float* x, const float* packed_w, const float* bias,
+                                 float* y) const {
+  const ConvOpInfo& info = ConvInfo();
+  const GemmMicroKernel& gemm = *gemm_;
+  const int64_t mr = gemm.mr;
+  const int64_t nr = gemm.nr;
+  const int64_t c_in_group = c_in_ / info.group;
+  const int64_t c_out_group = c_out_ / info.group;
+
+  const int64_t m_split = task % m_splits_;
+  const int64_t block = (task / m_splits_) % blocks_;
+  const int64_t g = (task / (m_splits_ * blocks_)) % info.group;
+  const int64_t n = task / (m_splits_ * blocks_ * info.group);
+
+  const int64_t x_h = x_dims_[1];
+  const int64_t x_w = x_dims_[2];
+  const int64_t y_h = y_dims_[1];
+  const int64_t y_w = y_dims_[2];
+  const int64_t tile0 = block * block_cols_;
+  const int64_t tile_count = std::min(block_cols_, winograd_tiles_ - tile0);
+  const int64_t n_panels = (tile_count + nr - 1) / nr;
+  const int64_t lanes = n_panels * nr;
+
+  const int64_t m_panels = (c_out_group + mr - 1) / mr;
+  const int64_t panels_per_split = (m_panels + m_splits_ - 1) / m_splits_;
+  const int64_t panel_begin = std::min(m_panels, m_split * panels_per_split);
+  const int64_t panel_end = std::min(m_panels, panel_begin + panels_per_split);
+  const int64_t rows = std::min(c_out_group, panel_end * mr) - panel_begin * mr;
+  const int64_t padded_rows = (panel_end - panel_begin) * mr;
+  if (rows <= 0) {
+    return;
+  }
+
+  const float* x_image = x + n * x_layout_.ImageSize();
+  const int64_t x_stride = x_layout_.PositionStride();
+  const float* w_group = packed_w + g * packed_group_size_;
+  const int64_t position_size = packed_group_size_ / kWinogradPositions;
+
+  // Per position: transformed inputs as n_panels micro-kernel panels [kc, nr], and accumulators
+  // [padded_rows, lanes]. Reused by every task this thread runs.
+  thread_local std::vector<float> v;
+  thread_local std::vector<float> m;
+  v.resize(static_cast<size_t>(kWinogradPositions * gemm_kc_ * lanes));
+  m.resize(static_cast<size_t>(kWinogradPositions * padded_rows * lanes));
+
+  // Tiles run kWinogradLanes at a time through local [position][lane] buffers, which stay in registers or L1
+  float d[kWinogradPositions * kWinogradLanes];
+  float t[kWinogradPositions * kWinogradLanes];
+  constexpr int64_t kRowStep = kWinogradTile * kWinogradLanes;
+
+  for (int64_t k0 = 0; k0 < gemm_k_; k0 += gemm_kc_) {
+    const int64_t kc = std::min(gemm_kc_, gemm_k_ - k0);
+    const int64_t position_step = n_panels * kc * nr;
+
+    // V = B^T d B for every channel of the block; padding, and lanes past the last tile, are zero
+    for (int64_t kk = 0; kk < kc; ++kk) {
+      const float* x_plane = x_image + x_layout_.ChannelOffset(g * c_in_group + k0 + kk);
+      for (int64_t l0 = 0; l0 < lanes; l0 += kWinogradLanes) {
+        std::fill(d, d + kWinogradPositions * kWinogradLanes, 0.0f);
+        const int64_t chunk_tiles = std::clamp<int64_t>(tile_count - l0, 0, kWinogradLanes);
+        for (int64_t lane = 0; lane < chunk_tiles; ++lane) {
+          const int64_t tile = tile0 + l0 + lane;
+          const int64_t ih0 = tile / winograd_tiles_w_ * kWinogradOut - pads_[1];
+          const int64_t iw0 = tile % winograd_tiles_w_ * kWinogradOut - pads_[2];
+          const int64_t r_begin = std::max<int64_t>(0, -ih0);
+          const int64_t r_end = std::min(kWinogradTile, x_h - ih0);
+          const int64_t c_begin = std::max<int64_t>(0, -iw0);
+          const int64_t c_end = std::min(kWinogradTile, x_w - iw0);
+          for (int64_t r = r_begin; r < r_end; ++r) {
+            const float* x_row = x_plane + ((ih0 + r) * x_w + iw0) * x_stride;
+            for (int64_t c = c_begin; c < c_end; ++c) {
+              d[(r * kWinogradTile + c) * kWinogradLanes + lane] = x_row[c * x_stride];
+            }
+          }
+        }
+
+        for (int64_t c = 0; c < kWinogradTile; ++c) {
+          InputTransform1D(d + c * kWinogradLanes, kRowStep, t + c * kWinogradLanes, kRowStep);
+        }
+        float* v_lanes = v.data() + ((l0 / nr) * kc + kk) * nr + l0 % nr;
+        for (int64_t r = 0; r < kWinogradTile; ++r) {
+          InputTransform1D(t + r * kRowStep, kWinogradLanes, v_lanes + r * kWinogradTile * position_step,
+                           position_step);
+        }
+      }
+    }
+
+    // M[p] (+)= U[p] V[p] for each of the 36 positions; each weight panel is reused across the tile panels
+    for (int64_t p = 0; p < kWinogradPositions; ++p) {
+      const float* b = v.data() + p * position_step;
+      for (int64_t panel = panel_begin; panel < panel_end; ++panel) {
+        const float* a = w_group + p * position_size + panel * mr * gemm_k_ + k0 * mr;
+        float* c = m.data() + (p * padded_rows + (panel - panel_begin) * mr) * lanes;
+        for (int64_t np = 0; np < n_panels; ++np) {
+          gemm.fn(kc, a, b + np * kc * nr, c + np * nr, lanes, k0 > 0);
+        }
+      }
+    }
+  }
+
+  // Y = A^T M A per output channel, then bias and activation, scattered to the tiles' output positions
+  const int64_t row0 = panel_begin * mr;
+  const int64_t m_position_step = padded_rows * lanes;
+  float* y_image = y + n * y_layout_.ImageSize();
+  const int64_t y_stride = y_layout_.PositionStride();
+  for (int64_t i = 0; i < rows; ++i) {
+    const int64_t channel = g * c_out_group + row0 + i;
+    const float channel_bias = bias != nullptr ? bias[channel] : 0.0f;
+    float* y_plane = y_image + y_layout_.ChannelOffset(channel);
+
+    for (int64_t l0 = 0; l0 < tile_count; l0 += kWinogradLanes) {
+      // Columns first, straight from the accumulators, leaving 4 rows of 6 in t; then each row into d as [4][4]
+      const float* m_lanes = m.data() + i * lanes + l0;
+      for (int64_t c = 0; c < kWinogradTile; ++c) {
+        OutputTransform1D(m_lanes + c * m_position_step, kWinogradTile * m_position_step, t + c * kWinogradLanes,
+                          kRowStep);
+      }
+      for (int64_t r = 0; r < kWinogradOut; ++r) {
+        OutputTransform1D(t + r * kRowStep, kWinogradLanes, d + r * kWinogradOut * kWinogradLanes,
+                          kWinogradLanes);
+      }
+
+      constexpr int64_t kOutCount = kWinogradOut * kWinogradOut * kWinogradLanes;
+      for (int64_t j = 0; j < kOutCount; ++j) {
+        d[j] += channel_bias;
+      }
+      if (info.activation.kind != Activation::Kind::kNone) {
+        ApplyPointwiseInPlace(ToPointwiseFunc(info.activation.kind), info.activation.alpha, info.activation.beta,
+                              d, kOutCount);
+      }
+
+      const int64_t chunk_tiles = std::min(kWinogradLanes, tile_count - l0);
+      for (int64_t lane = 0; lane < chunk_tiles; ++lane) {
+        const int64_t tile = tile0 + l0 + lane;
+        const int64_t oh0 = tile / winograd_tiles_w_ * kWinogradOut;
+        const int64_t ow0 = tile % winograd_tiles_w_ * kWinogradOut;
+        const int64_t r_end = std::min(kWinogradOut, y_h - oh0);
+        const int64_t c_end = std::min(kWinogradOut, y_w - ow0);
+        for (int64_t r = 0; r < r_end; ++r) {
+          float* y_row = y_plane + ((oh0 + r) * y_w + ow0) * y_stride;
+          for (int64_t c = 0; c < c_end; ++c) {
+            y_row[c * y_stride] = d[(r * kWinogradOut + c) * kWinogradLanes + lane];
+          }
+        }
+      }
+    }
+  }
+}
+
+void HostConvOp::RunDepthwiseTask(int64_t task, const float* x, const float* packed_w, float* y) const {
+  const ConvOpInfo& info = ConvInfo();
+  const DepthwiseKernel& kernel = *depthwise_;
+  constexpr int64_t kBlock = kHostBlockChannels;
+
+  const int64_t strip = task % depthwise_strips_;
+  const int64_t block = (task / depthwise_strips_) % channel_blocks_;
+  const int64_t n = task / (depthwise_strips_ * channel_blocks_);
+  const int64_t c0 = block * kBlock;
+  const int64_t channels = std::min(kBlock, c_out_ - c0);
+
+  const int64_t x_h = x_dims_[1];
+  const int64_t x_w = x_dims_[2];
+  const int64_t y_h = y_dims_[1];
+  const int64_t y_w = y_dims_[2];
+  const int64_t oh_begin = strip * depthwise_rows_;
+  const int64_t oh_end = std::min(y_h, oh_begin + depthwise_rows_);
+  const int64_t ih_begin = oh_begin * strides_[1] - pads_[1];
+  const int64_t x_rows = (oh_end - oh_begin - 1) * strides_[1] + (k_dims_[1] - 1) * dilations_[1] + 1;
+
+  // Packed column j is input column j - pad; columns [valid_begin, valid_end) are inside the input
+  const int64_t cols = depthwise_x_cols_;
+  const int64_t valid_begin = std::min(cols, pads_[2]);
+  const int64_t valid_end = std::clamp(x_w + pads_[2], valid_begin, cols);
+  const int64_t row_size = cols * kBlock;
+
+  // Packed input rows of the strip and one output row, both [position][kBlock]. Reused by every task this
+  // thread runs.
+  thread_local std::vector<float> packed_x;
+  thread_local std::vector<float> y_row;
+  packed_x.resize(static_cast<size_t>(x_rows * row_size));
+  y_row.resize(static_cast<size_t>(y_w * kBlock));
+
+  // Pack: padding, and lanes past the last channel of a plain X, are zero. A blocked X already has the
+  // block's rows in this layout; its padding lanes only ever reach the padding lanes of Y.
+  const float* x_block = x + n * x_layout_.ImageSize() + x_layout_.ChannelOffset(c0);
+  for (int64_t i = 0; i < x_rows; ++i) {
+    const int64_t ih = ih_begin + i;
+    float* dst = packed_x.data() + i * row_size;
+    if (ih < 0 || ih >= x_h || (!x_layout_.blocked && channels < kBlock)) {
+      std::fill(dst, dst + row_size, 0.0f);
+      if (ih < 0 || ih >= x_h) {
+        continue;
+      }
+    } else {
+      std::fill(dst, dst + valid_begin * kBlock, 0.0f);
+      std::fill(dst + valid_end * kBlock, dst + row_size, 0.0f);
+    }
+    if (x_layout_.blocked) {
+      const float* x_row = x_block + (ih * x_w + valid_begin - pads_[2]) * kBlock;
+      std::copy(x_row, x_row + (valid_end - valid_begin) * kBlock, dst + valid_begin * kBlock);
+      continue;
+    }
+    for (int64_t c = 0; c < channels; ++c) {
+      const float* x_row = x_block + (c * x_h + ih) * x_w - pads_[2];
+      for (int64_t j = valid_begin; j < valid_end; ++j) {
+        dst[j * kBlock + c] = x_row[j];
+      }
+    }
+  }
+
+  DepthwiseRowArgs args;
+  args.x_row_stride = row_size;
+  args.position_stride = kBlock;
+  args.width = y_w;
+  args.kh = k_dims_[1];
+  args.kw = k_dims_[2];
+  args.stride_w = strides_[2];
+  args.dilation_h = dilations_[1];
+  args.dilation_w = dilations_[2];
+  const float* w_block = packed_w + block * (k_dims_[1] * k_dims_[2] + 1) * kBlock;
+
+  // Relu and Clip are a clamp the kernel applies in registers; any other activation runs on the output row
+  const Activation& activation = info.activation;
+  args.lower = -std::numeric_limits<float>::infinity();
+  args.upper = std::numeric_limits<float>::infinity();
+  bool clamp = true;
+  switch (activation.kind) {
+    case Activation::Kind::kRelu:
+      args.lower = 0.0f;
+      break;
+    case Activation::Kind::kClip:
+      args.lower = activation.alpha;
+      args.upper = activation.beta;
+      break;
+    default:
+      clamp = false;
+      break;
+  }
+
+  // A blocked Y takes the rows as they are; a plain one gets each row unpacked into the channels' planes
+  float* y_block = y + n * y_layout_.ImageSize() + y_layout_.ChannelOffset(c0);
+  for (int64_t oh = oh_begin; oh < oh_end; ++oh) {
+    const float* x_window = packed_x.data() + (oh - oh_begin) * strides_[1] * row_size;
+    float* y_out = y_layout_.blocked ? y_block + oh * y_w * kBlock : y_row.data();
+
+    // Kernels narrower than the block cover it a group of lanes at a time
+    for (int64_t lane = 0; lane < channels; lane += kernel.lanes) {
+      args.x = x_window + lane;
+      args.w = w_block + lane;
+      args.bias = w_block + k_dims_[1] * k_dims_[2] * kBlock + lane;
+      args.y = y_out + lane;
+      kernel.fn(args);
+    }
+
+    if (activation.kind != Activation::Kind::kNone && !clamp) {
+      ApplyPointwiseInPlace(ToPointwiseFunc(activation.kind), activation.alpha, activation.beta, y_out,
+                            y_w * kBlock);
+    }
+
+    if (!y_layout_.blocked) {
+      for (int64_t c = 0; c < channels; ++c) {
+        float* y_plane_row = y_block + (c * y_h + oh) * y_w;
+        for (int64_t ow = 0; ow < y_w; ++ow) {
+          y_plane_row[ow] = y_row[ow * kBlock + c];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,82 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/host_depthwise.h"
+#include "hipdnn_ep/host_layout.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace hipdnn_ep {
+
+namespace {
+
+constexpr int64_t kGenericLanes = 8;
+constexpr int64_t kGenericTile = 4;
+
+// Portable fallback: kGenericTile outputs at a time in fixed-size accumulators the compiler can vectorize at
+// baseline ISA and keep in registers
+void DepthwiseRowGeneric(const DepthwiseRowArgs& args) {
+  const int64_t position_stride = args.position_stride;
+  const int64_t x_tap_step = args.dilation_w * position_stride;
+  const int64_t x_out_step = args.stride_w * position_stride;
+
+  for (int64_t ow0 = 0; ow0 < args.width; ow0 += kGenericTile) {
+    const int64_t tile = std::min(kGenericTile, args.width - ow0);
+    float acc[kGenericTile][kGenericLanes];
+    for (int64_t j = 0; j < kGenericTile; ++j) {
+      std::copy(args.bias, args.bias + kGenericLanes, acc[j]);
+    }
+
+    for (int64_t r = 0; r < args.kh; ++r) {
+      const float* x_row = args.x + r * args.dilation_h * args.x_row_stride + ow0 * x_out_step;
+      for (int64_t s = 0; s < args.kw; ++s) {
+        const float* w = args.w + (r * args.kw + s) * position_stride;
+        const float* x_tap = x_row + s * x_tap_step;
+        // A partial tile recomputes its last output rather than reading past the row
+        for (int64_t j = 0; j < kGenericTile; ++j) {
+          const float* x = x_tap + std::min(j, tile - 1) * x_out_step;
+          for (int64_t l = 0; l < kGenericLanes; ++l) {
+            acc[j][l] += w[l] * x[l];
+          }
+        }
+      }
+    }
+
+    for (int64_t j = 0; j < tile; ++j) {
+      for (int64_t l = 0; l < kGenericLanes; ++l) {
+        args.y[(ow0 + j) * position_stride + l] = std::min(std::max(acc[j][l], args.lower), args.upper);
+      }
+    }
+  }
+}
+
+static_assert(kHostBlockChannels % kGenericLanes == 0, "Depthwise kernels must cover whole channel blocks");
+
+std::vector<DepthwiseKernel> SupportedDepthwiseKernels() {
+  std::vector<DepthwiseKernel> kernels;
+#if defined(HIPDNN_EP_HOST_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    kernels.push_back({"avx512", 16, DepthwiseRowAvx512});
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    kernels.push_back({"avx2", 8, DepthwiseRowAvx2});
+  }
+#endif
+  kernels.push_back({"generic", kGenericLanes, DepthwiseRowGeneric});
+  return kernels;
+}
+
+}  // namespace
+
+const std::vector<DepthwiseKernel>& GetDepthwiseKernels() {
+  static const std::vector<DepthwiseKernel> kernels = SupportedDepthwiseKernels();
+  return kernels;
+}
+
+const DepthwiseKernel& GetDepthwiseKernel() {
+  return GetDepthwiseKernels().front();
+}
+
+}  // namespace hipdnn_ep
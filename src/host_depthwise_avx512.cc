@@ -0,0 +1,92 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Built with -mavx512f; only reached through GetDepthwiseKernels() on CPUs that support it.
+
+#include "hipdnn_ep/host_depthwise.h"
+
+#include <immintrin.h>
+
+namespace hipdnn_ep {
+
+namespace {
+
+constexpr int kTile = 8;
+
+// max and min return their second operand when either is NaN, so a NaN output stays NaN as in std::min/max
+inline __m512 Clamp(__m512 v, __m512 lower, __m512 upper) {
+  return _mm512_min_ps(upper, _mm512_max_ps(lower, v));
+}
+
+// kTile outputs at a time in registers, one zmm of channels each. KH and KW fix the kernel size so its taps
+// unroll; 0 takes them from `args`.
+template <int KH, int KW>
+void DepthwiseRow(const DepthwiseRowArgs& args) {
+  const int64_t kh = KH > 0 ? KH : args.kh;
+  const int64_t kw = KW > 0 ? KW : args.kw;
+  const int64_t position_stride = args.position_stride;
+  const int64_t x_tap_step = args.dilation_w * position_stride;
+  const int64_t x_out_step = args.stride_w * position_stride;
+  const int64_t x_row_step = args.dilation_h * args.x_row_stride;
+  const __m512 bias = _mm512_loadu_ps(args.bias);
+  const __m512 lower = _mm512_set1_ps(args.lower);
+  const __m512 upper = _mm512_set1_ps(args.upper);
+
+  int64_t ow = 0;
+  for (; ow + kTile <= args.width; ow += kTile) {
+    __m512 acc[kTile];
+#pragma GCC unroll 16
+    for (int j = 0; j < kTile; ++j) {
+      acc[j] = bias;
+    }
+
+    const float* x_row = args.x + ow * x_out_step;
+    const float* w = args.w;
+#pragma GCC unroll 8
+    for (int64_t r = 0; r < kh; ++r) {
+#pragma GCC unroll 8
+      for (int64_t s = 0; s < kw; ++s) {
+        const __m512 w_tap = _mm512_loadu_ps(w + s * position_stride);
+        const float* x = x_row + s * x_tap_step;
+#pragma GCC unroll 16
+        for (int j = 0; j < kTile; ++j) {
+          acc[j] = _mm512_fmadd_ps(w_tap, _mm512_loadu_ps(x + j * x_out_step), acc[j]);
+        }
+      }
+      x_row += x_row_step;
+      w += kw * position_stride;
+    }
+
+#pragma GCC unroll 16
+    for (int j = 0; j < kTile; ++j) {
+      _mm512_storeu_ps(args.y + (ow + j) * position_stride, Clamp(acc[j], lower, upper));
+    }
+  }
+
+  for (; ow < args.width; ++ow) {
+    __m512 acc = bias;
+    const float* x_row = args.x + ow * x_out_step;
+    for (int64_t r = 0; r < kh; ++r) {
+      for (int64_t s = 0; s < kw; ++s) {
+        acc = _mm512_fmadd_ps(_mm512_loadu_ps(args.w + (r * kw + s) * position_stride),
+                              _mm512_loadu_ps(x_row + s * x_tap_step), acc);
+      }
+      x_row += x_row_step;
+    }
+    _mm512_storeu_ps(args.y + ow * position_stride, Clamp(acc, lower, upper));
+  }
+}
+
+}  // namespace
+
+void DepthwiseRowAvx512(const DepthwiseRowArgs& args) {
+  if (args.kh == 3 && args.kw == 3) {
+    DepthwiseRow<3, 3>(args);
+  } else if (args.kh == 5 && args.kw == 5) {
+    DepthwiseRow<5, 5>(args);
+  } else {
+    DepthwiseRow<0, 0>(args);
+  }
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,83 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/host_gemm.h"
+
+#include <algorithm>
+
+namespace hipdnn_ep {
+
+namespace {
+
+constexpr int64_t kGenericMr = 4;
+constexpr int64_t kGenericNr = 8;
+
+// Portable fallback; the fixed-size loops are simple enough for the compiler to vectorize at baseline ISA
+void GemmMicroKernelGeneric(int64_t kc, const float* a, const float* b, float* c, int64_t ldc, bool accumulate) {
+  float acc[kGenericMr][kGenericNr] = {};
+  for (int64_t p = 0; p < kc; ++p) {
+    for (int64_t i = 0; i < kGenericMr; ++i) {
+      const float a_value = a[i];
+      for (int64_t j = 0; j < kGenericNr; ++j) {
+        acc[i][j] += a_value * b[j];
+      }
+    }
+    a += kGenericMr;
+    b += kGenericNr;
+  }
+
+  for (int64_t i = 0; i < kGenericMr; ++i) {
+    float* c_row = c + i * ldc;
+    for (int64_t j = 0; j < kGenericNr; ++j) {
+      c_row[j] = accumulate ? c_row[j] + acc[i][j] : acc[i][j];
+    }
+  }
+}
+
+std::vector<GemmMicroKernel> SupportedGemmMicroKernels() {
+  std::vector<GemmMicroKernel> kernels;
+#if defined(HIPDNN_EP_HOST_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    kernels.push_back({"avx512", 12, 32, GemmMicroKernelAvx512});
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    kernels.push_back({"avx2", 6, 16, GemmMicroKernelAvx2});
+  }
+#endif
+  kernels.push_back({"generic", kGenericMr, kGenericNr, GemmMicroKernelGeneric});
+  return kernels;
+}
+
+}  // namespace
+
+const std::vector<GemmMicroKernel>& GetGemmMicroKernels() {
+  static const std::vector<GemmMicroKernel> kernels = SupportedGemmMicroKernels();
+  return kernels;
+}
+
+const GemmMicroKernel& GetGemmMicroKernel() {
+  return GetGemmMicroKernels().front();
+}
+
+size_t PackedGemmASize(const GemmMicroKernel& kernel, int64_t m, int64_t k) {
+  const int64_t panels = (m + kernel.mr - 1) / kernel.mr;
+  return static_cast<size_t>(panels * kernel.mr * k);
+}
+
+void PackGemmAPanels(const GemmMicroKernel& kernel, int64_t m, int64_t k, const float* a, int64_t lda,
+                     float* packed) {
+  const int64_t mr = kernel.mr;
+  for (int64_t row0 = 0; row0 < m; row0 += mr) {
+    const int64_t rows = std::min(mr, m - row0);
+    for (int64_t p = 0; p < k; ++p) {
+      for (int64_t i = 0; i < rows; ++i) {
+        packed[i] = a[(row0 + i) * lda + p];
+      }
+      std::fill(packed + rows, packed + mr, 0.0f);
+      packed += mr;
+    }
+  }
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,53 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Built with -mavx2 -mfma; only reached through GetGemmMicroKernels() on CPUs that support both.
+
+#include "hipdnn_ep/host_gemm.h"
+
+#include <immintrin.h>
+
+namespace hipdnn_ep {
+
+namespace {
+
+constexpr int kMr = 6;
+constexpr int kNr = 16;
+
+}  // namespace
+
+// 6x16 block: 12 accumulators, two B vectors and one broadcast A value fill 15 of the 16 ymm registers
+void GemmMicroKernelAvx2(int64_t kc, const float* a, const float* b, float* c, int64_t ldc, bool accumulate) {
+  __m256 acc[kMr][2];
+#pragma GCC unroll 16
+  for (int i = 0; i < kMr; ++i) {
+    acc[i][0] = _mm256_setzero_ps();
+    acc[i][1] = _mm256_setzero_ps();
+  }
+
+  for (int64_t p = 0; p < kc; ++p) {
+    const __m256 b0 = _mm256_loadu_ps(b);
+    const __m256 b1 = _mm256_loadu_ps(b + 8);
+#pragma GCC unroll 16
+    for (int i = 0; i < kMr; ++i) {
+      const __m256 a_value = _mm256_broadcast_ss(a + i);
+      acc[i][0] = _mm256_fmadd_ps(a_value, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(a_value, b1, acc[i][1]);
+    }
+    a += kMr;
+    b += kNr;
+  }
+
+#pragma GCC unroll 16
+  for (int i = 0; i < kMr; ++i) {
+    float* c_row = c + i * ldc;
+    if (accumulate) {
+      acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_loadu_ps(c_row));
+      acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_loadu_ps(c_row + 8));
+    }
+    _mm256_storeu_ps(c_row, acc[i][0]);
+    _mm256_storeu_ps(c_row + 8, acc[i][1]);
+  }
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,53 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Built with -mavx512f; only reached through GetGemmMicroKernels() on CPUs that support it.
+
+#include "hipdnn_ep/host_gemm.h"
+
+#include <immintrin.h>
+
+namespace hipdnn_ep {
+
+namespace {
+
+constexpr int kMr = 12;
+constexpr int kNr = 32;
+
+}  // namespace
+
+// 12x32 block: 24 accumulators, two B vectors and one broadcast A value out of the 32 zmm registers
+void GemmMicroKernelAvx512(int64_t kc, const float* a, const float* b, float* c, int64_t ldc, bool accumulate) {
+  __m512 acc[kMr][2];
+#pragma GCC unroll 16
+  for (int i = 0; i < kMr; ++i) {
+    acc[i][0] = _mm512_setzero_ps();
+    acc[i][1] = _mm512_setzero_ps();
+  }
+
+  for (int64_t p = 0; p < kc; ++p) {
+    const __m512 b0 = _mm512_loadu_ps(b);
+    const __m512 b1 = _mm512_loadu_ps(b + 16);
+#pragma GCC unroll 16
+    for (int i = 0; i < kMr; ++i) {
+      const __m512 a_value = _mm512_set1_ps(a[i]);
+      acc[i][0] = _mm512_fmadd_ps(a_value, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_ps(a_value, b1, acc[i][1]);
+    }
+    a += kMr;
+    b += kNr;
+  }
+
+#pragma GCC unroll 16
+  for (int i = 0; i < kMr; ++i) {
+    float* c_row = c + i * ldc;
+    if (accumulate) {
+      acc[i][0] = _mm512_add_ps(acc[i][0], _mm512_loadu_ps(c_row));
+      acc[i][1] = _mm512_add_ps(acc[i][1], _mm512_loadu_ps(c_row + 16));
+    }
+    _mm512_storeu_ps(c_row, acc[i][0]);
+    _mm512_storeu_ps(c_row + 16, acc[i][1]);
+  }
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,118 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/host_matmul_op.h"
+#include "hipdnn_ep/host_pointwise_op.h"
+
+#include <algorithm>
+
+namespace hipdnn_ep {
+
+namespace {
+
+// Multiply-adds per ParallelFor task: small problems stay on the calling thread
+constexpr int64_t kGrainFlops = 32768;
+
+}  // namespace
+
+HostMatMulOp::HostMatMulOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<MatMulOpInfo> info,
+                           ThreadPool& thread_pool)
+    : Op(std::move(info)), ort_api_(ort_api), logger_(logger), thread_pool_(thread_pool) {
+}
+
+OrtStatus* HostMatMulOp::Compile() {
+  const MatMulOpInfo& info = MatMulInfo();
+  if (info.dtype != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Host " << info.op_type << " only supports float, node: "
+                                                << info.node_name);
+  }
+  if (info.m <= 0 || info.n <= 0 || info.k <= 0 || info.batch_count <= 0) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Empty GEMM problem, node: " << info.node_name);
+  }
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << " (host): m=" << info.m << ", n=" << info.n << ", k=" << info.k
+                   << ", batch: " << info.batch_count << ", addend: " << static_cast<int>(info.addend)
+                   << ", activation: " << static_cast<int>(info.activation.kind));
+
+  return nullptr;
+}
+
+OrtStatus* HostMatMulOp::Execute(const ExecutionContext& /*ctx*/, const std::vector<const void*>& inputs,
+                                 const std::vector<void*>& outputs) const {
+  const MatMulOpInfo& info = MatMulInfo();
+  const auto* a = static_cast<const float*>(inputs[0]);
+  const auto* b = static_cast<const float*>(inputs[1]);
+  const auto* c = info.addend != MatMulOpInfo::Addend::kNone ? static_cast<const float*>(inputs[2]) : nullptr;
+  auto* y = static_cast<float*>(outputs[0]);
+
+  const int64_t grain = std::max<int64_t>(1, kGrainFlops / (info.n * info.k));
+  thread_pool_.ParallelFor(info.batch_count * info.m, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t row = begin; row < end; ++row) {
+      RunRow(row, a, b, c, y);
+    }
+  });
+  return nullptr;
+}
+
+void HostMatMulOp::RunRow(int64_t row, const float* a, const float* b, const float* c, float* y) const {
+  const MatMulOpInfo& info = MatMulInfo();
+  const int64_t batch = row / info.m;
+  const int64_t i = row % info.m;
+  const int64_t m = info.m;
+  const int64_t n = info.n;
+  const int64_t k = info.k;
+
+  // Row-major operands; a transposed A is [K, M] and a transposed B is [N, K]
+  const float* a_batch = a + (info.a_batched ? batch * m * k : 0);
+  const float* b_batch = b + (info.b_batched ? batch * k * n : 0);
+  const int64_t a_step = info.trans_a ? m : 1;
+  const float* a_row = a_batch + (info.trans_a ? i : i * k);
+  float* y_row = y + row * n;
+
+  if (info.trans_b) {
+    // Each output is a dot product of the A row with a contiguous B row
+    for (int64_t j = 0; j < n; ++j) {
+      const float* b_row = b_batch + j * k;
+      float sum = 0.0f;
+      for (int64_t p = 0; p < k; ++p) {
+        sum += a_row[p * a_step] * b_row[p];
+      }
+      y_row[j] = sum;
+    }
+  } else {
+    // Accumulate scaled B rows into the output row: contiguous in both, so the inner loop vectorizes
+    std::fill(y_row, y_row + n, 0.0f);
+    for (int64_t p = 0; p < k; ++p) {
+      const float a_value = a_row[p * a_step];
+      const float* b_row = b_batch + p * n;
+      for (int64_t j = 0; j < n; ++j) {
+        y_row[j] += a_value * b_row[j];
+      }
+    }
+  }
+
+  // y = alpha * AB (+ beta * C[i] | + bias), then the activation
+  const float alpha = info.alpha;
+  if (info.addend == MatMulOpInfo::Addend::kMatrix) {
+    const float* c_row = c + i * n;
+    for (int64_t j = 0; j < n; ++j) {
+      y_row[j] = alpha * y_row[j] + info.beta * c_row[j];
+    }
+  } else if (info.addend == MatMulOpInfo::Addend::kBias) {
+    for (int64_t j = 0; j < n; ++j) {
+      y_row[j] = alpha * y_row[j] + c[j];
+    }
+  } else if (alpha != 1.0f) {
+    for (int64_t j = 0; j < n; ++j) {
+      y_row[j] *= alpha;
+    }
+  }
+
+  if (info.activation.kind != Activation::Kind::kNone) {
+    ApplyPointwiseInPlace(ToPointwiseFunc(info.activation.kind), info.activation.alpha, info.activation.beta,
+                          y_row, n);
+  }
+}
+
+}  // namespace hipdnn_ep
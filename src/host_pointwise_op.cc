@@ -0,0 +1,160 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/host_pointwise_op.h"
+#include "hipdnn_ep/host_layout.h"
+#include "hipdnn_ep/pointwise_functors.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace hipdnn_ep {
+
+namespace {
+
+// Elements per ParallelFor task: small tensors stay on the calling thread
+constexpr int64_t kGrain = 16384;
+
+// Inputs laid out exactly like the output (or absent): plain loops the compiler vectorizes
+template <PointwiseFunc F>
+void RunContiguous(const float* a, const float* b, float* y, int64_t begin, int64_t end, float alpha,
+                   float beta) {
+  if (b == nullptr) {
+    for (int64_t i = begin; i < end; ++i) {
+      y[i] = PointwiseFunctor<F>::Apply(a[i], 0.0f, alpha, beta);
+    }
+  } else {
+    for (int64_t i = begin; i < end; ++i) {
+      y[i] = PointwiseFunctor<F>::Apply(a[i], b[i], alpha, beta);
+    }
+  }
+}
+
+// Numpy broadcasting over outputs [begin, end): the outer coordinates give the input offsets of each row of the
+// innermost dim, which is then walked with the inputs' innermost strides
+template <PointwiseFunc F>
+void RunBroadcast(const PointwiseParams& params, const float* a, const float* b, float* y, int64_t begin,
+                  int64_t end) {
+  const int last = params.rank - 1;
+  const int64_t inner = params.y_dims[last];
+  const int64_t a_step = params.a_strides[last];
+  const int64_t b_step = params.b_strides[last];
+
+  for (int64_t i = begin; i < end;) {
+    int64_t remaining = i / inner;
+    const int64_t col = i % inner;
+    const int64_t len = std::min(inner - col, end - i);
+
+    int64_t a_offset = col * a_step;
+    int64_t b_offset = col * b_step;
+    for (int d = last - 1; d >= 0; --d) {
+      const int64_t coord = remaining % params.y_dims[d];
+      remaining /= params.y_dims[d];
+      a_offset += coord * params.a_strides[d];
+      b_offset += coord * params.b_strides[d];
+    }
+
+    const float* a_row = a + a_offset;
+    float* y_row = y + i;
+    if (b == nullptr) {
+      for (int64_t j = 0; j < len; ++j) {
+        y_row[j] = PointwiseFunctor<F>::Apply(a_row[j * a_step], 0.0f, params.alpha, params.beta);
+      }
+    } else {
+      const float* b_row = b + b_offset;
+      for (int64_t j = 0; j < len; ++j) {
+        y_row[j] = PointwiseFunctor<F>::Apply(a_row[j * a_step], b_row[j * b_step], params.alpha, params.beta);
+      }
+    }
+    i += len;
+  }
+}
+
+using ContiguousFn = void (*)(const float*, const float*, float*, int64_t, int64_t, float, float);
+using BroadcastFn = void (*)(const PointwiseParams&, const float*, const float*, float*, int64_t, int64_t);
+
+// Loops indexed by PointwiseFunc, like the device kernel's launch table
+template <size_t... I>
+constexpr std::array<ContiguousFn, sizeof...(I)> MakeContiguousTable(std::index_sequence<I...>) {
+  return {&RunContiguous<static_cast<PointwiseFunc>(I)>...};
+}
+
+template <size_t... I>
+constexpr std::array<BroadcastFn, sizeof...(I)> MakeBroadcastTable(std::index_sequence<I...>) {
+  return {&RunBroadcast<static_cast<PointwiseFunc>(I)>...};
+}
+
+constexpr size_t kNumFuncs = static_cast<size_t>(PointwiseFunc::kCount);
+constexpr auto kContiguousTable = MakeContiguousTable(std::make_index_sequence<kNumFuncs>());
+constexpr auto kBroadcastTable = MakeBroadcastTable(std::make_index_sequence<kNumFuncs>());
+
+}  // namespace
+
+void ApplyPointwiseInPlace(PointwiseFunc func, float alpha, float beta, float* y, int64_t count) {
+  kContiguousTable[static_cast<size_t>(func)](y, nullptr, y, 0, count, alpha, beta);
+}
+
+HostPointwiseOp::HostPointwiseOp(const OrtApi& ort_api, const OrtLogger& logger,
+                                 std::unique_ptr<PointwiseOpInfo> info, ThreadPool& thread_pool)
+    : Op(std::move(info)), ort_api_(ort_api), logger_(logger), thread_pool_(thread_pool) {
+}
+
+OrtStatus* HostPointwiseOp::Compile() {
+  const PointwiseOpInfo& info = PointwiseInfo();
+  if (info.dtype != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT || static_cast<size_t>(info.func) >= kNumFuncs) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Host pointwise op only supports float, node: " << info.node_name);
+  }
+  if (!ResolvePointwiseParams(info, params_)) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Unsupported broadcast of the inputs to the output shape, node: "
+                                            << info.node_name);
+  }
+  count_ = params_.count;
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << " (host): " << params_.count << " elements, broadcast rank "
+                   << params_.rank);
+
+  return nullptr;
+}
+
+BlockedLayoutSupport HostPointwiseOp::SupportsBlockedLayout() const {
+  const PointwiseOpInfo& info = PointwiseInfo();
+  const bool same_shapes = info.a_shape == info.y_shape && (info.inputs.size() < 2 || info.b_shape == info.y_shape);
+  return params_.rank == 0 && same_shapes && info.y_shape.size() >= 3 ? BlockedLayoutSupport::kUniform
+                                                                       : BlockedLayoutSupport::kNone;
+}
+
+void HostPointwiseOp::UseBlockedLayout(bool input, bool /*output*/) {
+  // Elementwise over whatever layout the tensors share, so only the padded size changes
+  const std::vector<int64_t>& shape = PointwiseInfo().y_shape;
+  count_ = params_.count;
+  if (input && shape[1] > 0) {
+    const int64_t channels = shape[1];
+    const int64_t padded = (channels + kHostBlockChannels - 1) / kHostBlockChannels * kHostBlockChannels;
+    count_ = params_.count / channels * padded;
+  }
+}
+
+OrtStatus* HostPointwiseOp::Execute(const ExecutionContext& /*ctx*/, const std::vector<const void*>& inputs,
+                                    const std::vector<void*>& outputs) const {
+  const auto* a = static_cast<const float*>(inputs[0]);
+  const auto* b = inputs.size() > 1 ? static_cast<const float*>(inputs[1]) : nullptr;
+  auto* y = static_cast<float*>(outputs[0]);
+  const auto func = static_cast<size_t>(params_.func);
+
+  if (params_.rank == 0) {
+    const ContiguousFn run = kContiguousTable[func];
+    thread_pool_.ParallelFor(count_, kGrain, [&](int64_t begin, int64_t end) {
+      run(a, b, y, begin, end, params_.alpha, params_.beta);
+    });
+  } else {
+    const BroadcastFn run = kBroadcastTable[func];
+    thread_pool_.ParallelFor(params_.count, kGrain, [&](int64_t begin, int64_t end) {
+      run(params_, a, b, y, begin, end);
+    });
+  }
+  return nullptr;
+}
+
+}  // namespace hipdnn_ep
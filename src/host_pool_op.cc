@@ -0,0 +1,210 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/host_pool_op.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace hipdnn_ep {
+
+HostPoolOp::HostPoolOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<PoolOpInfo> info,
+                       ThreadPool& thread_pool)
+    : Op(std::move(info)), ort_api_(ort_api), logger_(logger), thread_pool_(thread_pool) {
+}
+
+OrtStatus* HostPoolOp::Compile() {
+  const PoolOpInfo& info = PoolInfo();
+
+  const size_t rank = info.x_shape.size();
+  const size_t spatial_dims = rank - 2;
+  if (rank < 3 || rank > 5 || info.y_shape.size() != rank || info.kernel_shape.size() != spatial_dims ||
+      info.strides.size() != spatial_dims || info.pads.size() != 2 * spatial_dims) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Only 1D, 2D and 3D pooling are supported, node: " << info.node_name);
+  }
+  if (info.dtype != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Host pooling only supports float, node: " << info.node_name);
+  }
+
+  planes_ = info.x_shape[0] * info.x_shape[1];
+
+  // Right-align the spatial dims in (D, H, W) like the host convolution
+  const size_t lead = 3 - spatial_dims;
+  x_dims_.fill(1);
+  y_dims_.fill(1);
+  k_dims_.fill(1);
+  strides_.fill(1);
+  pads_begin_.fill(0);
+  pads_end_.fill(0);
+  for (size_t i = 0; i < spatial_dims; ++i) {
+    x_dims_[lead + i] = info.x_shape[2 + i];
+    y_dims_[lead + i] = info.y_shape[2 + i];
+    k_dims_[lead + i] = info.kernel_shape[i];
+    strides_[lead + i] = info.strides[i];
+    pads_begin_[lead + i] = info.pads[i];
+    pads_end_[lead + i] = info.pads[spatial_dims + i];
+  }
+
+  // Plain until the Kernel says otherwise
+  x_layout_ = {false, info.x_shape[1], x_dims_[0] * x_dims_[1] * x_dims_[2]};
+  y_layout_ = {false, info.y_shape[1], y_dims_[0] * y_dims_[1] * y_dims_[2]};
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << " (host): " << planes_ << " planes, mode "
+                   << static_cast<int>(info.mode));
+
+  return nullptr;
+}
+
+void HostPoolOp::UseBlockedLayout(bool input, bool output) {
+  x_layout_.blocked = input;
+  y_layout_.blocked = output;
+}
+
+OrtStatus* HostPoolOp::Execute(const ExecutionContext& /*ctx*/, const std::vector<const void*>& inputs,
+                               const std::vector<void*>& outputs) const {
+  const auto* x = static_cast<const float*>(inputs[0]);
+  auto* y = static_cast<float*>(outputs[0]);
+  const int64_t channels = x_layout_.channels;
+
+  if (x_layout_.blocked) {
+    const int64_t blocks = (channels + kHostBlockChannels - 1) / kHostBlockChannels;
+    const int64_t images = channels > 0 ? planes_ / channels : 0;
+    thread_pool_.ParallelFor(images * blocks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t task = begin; task < end; ++task) {
+        const int64_t n = task / blocks;
+        const int64_t c0 = task % blocks * kHostBlockChannels;
+        RunBlock(x + n * x_layout_.ImageSize() + x_layout_.ChannelOffset(c0),
+                 y + n * y_layout_.ImageSize() + y_layout_.ChannelOffset(c0),
+                 std::min(kHostBlockChannels, channels - c0));
+      }
+    });
+    return nullptr;
+  }
+
+  thread_pool_.ParallelFor(planes_, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t plane = begin; plane < end; ++plane) {
+      const int64_t n = plane / channels;
+      const int64_t c = plane % channels;
+      RunPlane(x + plane * x_layout_.plane_size, y + n * y_layout_.ImageSize() + y_layout_.ChannelOffset(c),
+               y_layout_.PositionStride());
+    }
+  });
+  return nullptr;
+}
+
+void HostPoolOp::Window(size_t d, int64_t o, int64_t& begin, int64_t& end, int64_t& padded) const {
+  begin = o * strides_[d] - pads_begin_[d];
+  end = std::min(begin + k_dims_[d], x_dims_[d] + pads_end_[d]);
+  padded = end - begin;
+  begin = std::max<int64_t>(begin, 0);
+  end = std::min(end, x_dims_[d]);
+}
+
+void HostPoolOp::RunPlane(const float* x, float* y, int64_t y_stride) const {
+  const PoolOpInfo::Mode mode = PoolInfo().mode;
+
+  for (int64_t od = 0; od < y_dims_[0]; ++od) {
+    int64_t d_begin, d_end, d_padded;
+    Window(0, od, d_begin, d_end, d_padded);
+    for (int64_t oh = 0; oh < y_dims_[1]; ++oh) {
+      int64_t h_begin, h_end, h_padded;
+      Window(1, oh, h_begin, h_end, h_padded);
+      for (int64_t ow = 0; ow < y_dims_[2]; ++ow) {
+        int64_t w_begin, w_end, w_padded;
+        Window(2, ow, w_begin, w_end, w_padded);
+
+        float value = 0.0f;
+        if (mode == PoolOpInfo::Mode::kMax) {
+          value = std::numeric_limits<float>::lowest();
+          for (int64_t id = d_begin; id < d_end; ++id) {
+            for (int64_t ih = h_begin; ih < h_end; ++ih) {
+              const float* x_row = x + (id * x_dims_[1] + ih) * x_dims_[2];
+              for (int64_t iw = w_begin; iw < w_end; ++iw) {
+                value = std::max(value, x_row[iw]);
+              }
+            }
+          }
+        } else {
+          float sum = 0.0f;
+          for (int64_t id = d_begin; id < d_end; ++id) {
+            for (int64_t ih = h_begin; ih < h_end; ++ih) {
+              const float* x_row = x + (id * x_dims_[1] + ih) * x_dims_[2];
+              for (int64_t iw = w_begin; iw < w_end; ++iw) {
+                sum += x_row[iw];
+              }
+            }
+          }
+          const int64_t count = mode == PoolOpInfo::Mode::kAverageIncludePad
+                                    ? d_padded * h_padded * w_padded
+                                    : (d_end - d_begin) * (h_end - h_begin) * (w_end - w_begin);
+          value = count > 0 ? sum / static_cast<float>(count) : 0.0f;
+        }
+        y[((od * y_dims_[1] + oh) * y_dims_[2] + ow) * y_stride] = value;
+      }
+    }
+  }
+}
+
+void HostPoolOp::RunBlock(const float* x, float* y, int64_t channels) const {
+  constexpr int64_t kBlock = kHostBlockChannels;
+  const PoolOpInfo::Mode mode = PoolInfo().mode;
+
+  // The same windows as RunPlane, each position a whole block; the fixed-size lane loops vectorize
+  float value[kBlock];
+  for (int64_t od = 0; od < y_dims_[0]; ++od) {
+    int64_t d_begin, d_end, d_padded;
+    Window(0, od, d_begin, d_end, d_padded);
+    for (int64_t oh = 0; oh < y_dims_[1]; ++oh) {
+      int64_t h_begin, h_end, h_padded;
+      Window(1, oh, h_begin, h_end, h_padded);
+      for (int64_t ow = 0; ow < y_dims_[2]; ++ow) {
+        int64_t w_begin, w_end, w_padded;
+        Window(2, ow, w_begin, w_end, w_padded);
+
+        if (mode == PoolOpInfo::Mode::kMax) {
+          std::fill(value, value + kBlock, std::numeric_limits<float>::lowest());
+          for (int64_t id = d_begin; id < d_end; ++id) {
+            for (int64_t ih = h_begin; ih < h_end; ++ih) {
+              const float* x_row = x + (id * x_dims_[1] + ih) * x_dims_[2] * kBlock;
+              for (int64_t iw = w_begin; iw < w_end; ++iw) {
+                for (int64_t l = 0; l < kBlock; ++l) {
+                  value[l] = std::max(value[l], x_row[iw * kBlock + l]);
+                }
+              }
+            }
+          }
+        } else {
+          std::fill(value, value + kBlock, 0.0f);
+          for (int64_t id = d_begin; id < d_end; ++id) {
+            for (int64_t ih = h_begin; ih < h_end; ++ih) {
+              const float* x_row = x + (id * x_dims_[1] + ih) * x_dims_[2] * kBlock;
+              for (int64_t iw = w_begin; iw < w_end; ++iw) {
+                for (int64_t l = 0; l < kBlock; ++l) {
+                  value[l] += x_row[iw * kBlock + l];
+                }
+              }
+            }
+          }
+          const int64_t count = mode == PoolOpInfo::Mode::kAverageIncludePad
+                                    ? d_padded * h_padded * w_padded
+                                    : (d_end - d_begin) * (h_end - h_begin) * (w_end - w_begin);
+          for (int64_t l = 0; l < kBlock; ++l) {
+            value[l] = count > 0 ? value[l] / static_cast<float>(count) : 0.0f;
+          }
+        }
+
+        const int64_t position = (od * y_dims_[1] + oh) * y_dims_[2] + ow;
+        if (y_layout_.blocked) {
+          std::copy(value, value + kBlock, y + position * kBlock);
+        } else {
+          for (int64_t c = 0; c < channels; ++c) {
+            y[c * y_layout_.plane_size + position] = value[c];
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace hipdnn_ep
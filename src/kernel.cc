@@ -2,78 +2,67 @@
 // Licensed under the MIT License.
 
 #include "hipdnn_ep/kernel.h"
+#include "hipdnn_ep/ep_context.h"
 
-#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
 
 namespace hipdnn_ep {
 
 namespace {
 
-// Helper to check MIOpen status
-#define MIOPEN_CHECK(call)                                                  \
-  do {                                                                       \
-    miopenStatus_t status = (call);                                         \
-    if (status != miopenStatusSuccess) {                                    \
-      std::cerr << "MIOpen error: " << status << " at " << __FILE__ << ":" << __LINE__ << std::endl; \
-    }                                                                        \
-  } while (0)
-
-#define MIOPEN_RETURN_IF_ERROR(ort_api, call)                               \
-  do {                                                                       \
-    miopenStatus_t status = (call);                                         \
-    if (status != miopenStatusSuccess) {                                    \
-      RETURN_ERROR(ort_api, ORT_EP_FAIL, "MIOpen error: " << status);       \
-    }                                                                        \
-  } while (0)
-
-// Convert ONNX data type to MIOpen data type
-miopenDataType_t ToMIOpenDataType(ONNXTensorElementDataType onnx_dtype) {
-  switch (onnx_dtype) {
+bool IsPoolOpType(const std::string& op_type) {
+  return op_type == "MaxPool" || op_type == "AveragePool" || op_type == "GlobalMaxPool" ||
+         op_type == "GlobalAveragePool";
+}
+
+bool IsPointwiseOpType(const std::string& op_type) {
+  PointwiseFunc func;
+  size_t arity = 0;
+  return LookupPointwiseOp(op_type, func, arity);
+}
+
+// Intermediates are placed at offsets aligned for any vectorized kernel access
+constexpr size_t kScratchAlignment = 256;
+
+// First token of a serialized kernel; bump when the layout changes
+constexpr const char* kContextVersion = "hipdnn_ep_kernel_v6";
+
+size_t AlignScratch(size_t size) {
+  return (size + kScratchAlignment - 1) / kScratchAlignment * kScratchAlignment;
+}
+
+size_t GetElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
     case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
-      return miopenFloat;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      return 4;
     case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
-      return miopenHalf;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
     default:
-      return miopenFloat;
+      return 0;
   }
 }
 
 }  // namespace
 
-Kernel::Kernel(const OrtApi& ort_api, const OrtLogger& logger)
-    : ort_api_(ort_api), logger_(logger) {
-  // Create MIOpen handle
-  miopenStatus_t status = miopenCreate(&miopen_handle_);
-  if (status != miopenStatusSuccess) {
-    std::cerr << "Failed to create MIOpen handle: " << status << std::endl;
-  }
+Kernel::Kernel(const OrtApi& ort_api, const OrtLogger& logger, Backend& backend)
+    : ort_api_(ort_api), logger_(logger), backend_(backend) {
 }
 
-Kernel::~Kernel() {
-  // Free workspace
-  if (workspace_ != nullptr) {
-    hipFree(workspace_);
-    workspace_ = nullptr;
-  }
-
-  // Destroy descriptors
-  if (x_desc_) miopenDestroyTensorDescriptor(x_desc_);
-  if (w_desc_) miopenDestroyTensorDescriptor(w_desc_);
-  if (y_desc_) miopenDestroyTensorDescriptor(y_desc_);
-  if (b_desc_) miopenDestroyTensorDescriptor(b_desc_);
-  if (conv_desc_) miopenDestroyConvolutionDescriptor(conv_desc_);
-
-  // Destroy MIOpen handle
-  if (miopen_handle_) {
-    miopenDestroy(miopen_handle_);
-    miopen_handle_ = nullptr;
-  }
-}
+Kernel::~Kernel() = default;
 
 OrtStatus* Kernel::BuildAndCompile(Ort::ConstGraph graph) {
   try {
-    std::cerr << "MIOpen Kernel::BuildAndCompile" << std::endl;
-
     // Get graph inputs and outputs
     std::vector<Ort::ConstValueInfo> graph_inputs = graph.GetInputs();
     std::vector<Ort::ConstValueInfo> graph_outputs = graph.GetOutputs();
@@ -83,314 +72,511 @@ OrtStatus* Kernel::BuildAndCompile(Ort::ConstGraph graph) {
       RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Empty graph");
     }
 
-    num_inputs_ = graph_inputs.size();
-    num_outputs_ = graph_outputs.size();
+    // Kernel context inputs/outputs follow the order of the fused graph's inputs/outputs
+    for (size_t i = 0; i < graph_inputs.size(); ++i) {
+      input_indices_[graph_inputs[i].GetName()] = i;
+    }
+    for (size_t i = 0; i < graph_outputs.size(); ++i) {
+      output_indices_[graph_outputs[i].GetName()] = i;
 
-    // We expect a single Conv node
-    Ort::ConstNode conv_node = nodes[0];
-    std::string op_type = conv_node.GetOperatorType();
-    if (op_type != "Conv") {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Expected Conv node, got: " << op_type);
+      auto shape = GetTensorShape(graph_outputs[i]);
+      if (!shape.has_value()) {
+        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Output must have static shape");
+      }
+      output_shapes_.push_back(*shape);
     }
 
-    // Get node inputs
-    std::vector<Ort::ConstValueInfo> node_inputs = conv_node.GetInputs();
-    std::vector<Ort::ConstValueInfo> node_outputs = conv_node.GetOutputs();
+    // Nodes arrive in topological order. A Conv, ConvTranspose, MatMul or Gemm absorbs the epilogue
+    // nodes GetCapability matched for it; every other node must map to an op of its own.
+    std::unordered_set<size_t> fused_node_ids;
+    std::unordered_map<std::string, Ort::ConstValueInfo> node_outputs;
+    for (const auto& node : nodes) {
+      for (const auto& output : node.GetOutputs()) {
+        if (output) {
+          node_outputs.emplace(output.GetName(), output);
+        }
+      }
+
+      if (fused_node_ids.count(node.GetId()) != 0) {
+        continue;
+      }
+
+      std::string op_type = node.GetOperatorType();
+      std::unique_ptr<Op> op;
+      if (op_type == "Conv" || op_type == "ConvTranspose") {
+        ConvFusion fusion = MatchConvFusion(node);
+        for (const auto& fused_node : fusion.Nodes()) {
+          fused_node_ids.insert(fused_node.GetId());
+        }
+        RETURN_IF_ERROR(backend_.CompileConv(CreateConvOpInfo(fusion, backend_.OwnsConstantWeights()), op));
+      } else if (op_type == "MatMul" || op_type == "Gemm") {
+        MatMulFusion fusion = MatchMatMulFusion(node);
+        for (const auto& fused_node : fusion.Nodes()) {
+          fused_node_ids.insert(fused_node.GetId());
+        }
+        RETURN_IF_ERROR(backend_.CompileMatMul(CreateMatMulOpInfo(fusion), op));
+      } else if (IsPoolOpType(op_type)) {
+        RETURN_IF_ERROR(backend_.CompilePool(CreatePoolOpInfo(node), op));
+      } else if (IsPointwiseOpType(op_type)) {
+        RETURN_IF_ERROR(backend_.CompilePointwise(CreatePointwiseOpInfo(node), op));
+      } else {
+        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Unsupported node in fused graph: " << op_type
+                                                                               << " (" << node.GetName() << ")");
+      }
+      AddOp(std::move(op));
+    }
+
+    const std::unordered_set<std::string> blocked_values = AssignLayouts();
+    RETURN_IF_ERROR(PlanValues(node_outputs, blocked_values));
+    RETURN_IF_ERROR(ApplyLayouts());
+
+    LOG(ort_api_, logger_, VERBOSE,
+        "Compiled " << ops_.size() << " ops from " << nodes.size() << " nodes on the " << backend_.Name()
+                    << " backend, intermediates: " << intermediates_size_ << " bytes (" << blocked_values.size()
+                    << " blocked), workspace: " << workspace_size_ << " bytes");
+
+    // The scratch memory itself is borrowed from the backend at execution time
+    backend_.ReserveScratch(intermediates_size_ + workspace_size_);
+
+  } catch (const Ort::Exception& ex) {
+    Ort::Status status(ex);
+    return status.release();
+  } catch (const std::exception& ex) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Exception building kernel: " << ex.what());
+  }
+
+  return nullptr;
+}
+
+OrtStatus* Kernel::Serialize(std::string& context) const {
+  ContextWriter writer;
+  writer.Write(std::string(kContextVersion)).Write(std::string(backend_.Name())).Write(backend_.Fingerprint());
+
+  writer.Write(static_cast<uint64_t>(output_shapes_.size()));
+  for (const auto& shape : output_shapes_) {
+    writer.Write(shape);
+  }
+  writer.Write(static_cast<uint64_t>(intermediates_size_));
 
-    if (node_inputs.size() < 2) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Conv requires at least 2 inputs");
+  auto write_locations = [&writer](const std::vector<ValueLocation>& locations) {
+    writer.Write(static_cast<uint64_t>(locations.size()));
+    for (const auto& location : locations) {
+      writer.Write(static_cast<int64_t>(location.kind)).Write(static_cast<uint64_t>(location.index));
+      writer.Write(static_cast<int64_t>(location.blocked));
     }
+  };
+
+  writer.Write(static_cast<uint64_t>(ops_.size()));
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    writer.Write(ops_[i]->Info().op_type);
+    ops_[i]->Serialize(writer);
+    write_locations(op_inputs_[i]);
+    write_locations(op_outputs_[i]);
+  }
 
-    has_bias_ = node_inputs.size() >= 3;
+  context = writer.Str();
+  return nullptr;
+}
 
-    // Get input shape (X)
-    auto x_shape_opt = GetTensorShape(node_inputs[0]);
-    if (!x_shape_opt.has_value()) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Input must have static shape");
+OrtStatus* Kernel::LoadFromContext(const std::string& context) {
+  try {
+    ContextReader reader(context);
+
+    std::string version;
+    std::string backend_name;
+    std::string fingerprint;
+    if (!reader.Read(version) || version != kContextVersion || !reader.Read(backend_name) ||
+        !reader.Read(fingerprint)) {
+      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Unsupported EP context; re-export the model with this EP version");
     }
-    x_shape_ = x_shape_opt.value();
 
-    // Get weight shape (W)
-    auto w_shape_opt = GetTensorShape(node_inputs[1]);
-    if (!w_shape_opt.has_value()) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Weight must have static shape");
+    // Ops are serialized with backend-specific state, so a context only loads where it was compiled
+    if (backend_name != backend_.Name()) {
+      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "EP context was compiled for the " << backend_name
+                                              << " backend but this EP runs on the " << backend_.Name()
+                                              << " backend; re-export the model on this device");
     }
-    w_shape_ = w_shape_opt.value();
 
-    // Get bias shape (B) if present
-    if (has_bias_) {
-      auto b_shape_opt = GetTensorShape(node_inputs[2]);
-      if (!b_shape_opt.has_value()) {
-        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Bias must have static shape");
+    // Choices such as convolution solutions only carry over to the device and library build that made them
+    bool same_fingerprint = fingerprint == backend_.Fingerprint();
+    if (!same_fingerprint) {
+      LOG(ort_api_, logger_, WARNING,
+          "EP context was created for " << fingerprint << ", running on " << backend_.Fingerprint()
+                                        << "; convolution solutions will be selected again");
+    }
+
+    uint64_t num_outputs = 0;
+    if (!reader.Read(num_outputs)) {
+      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: outputs");
+    }
+    output_shapes_.resize(num_outputs);
+    for (auto& shape : output_shapes_) {
+      if (!reader.Read(shape)) {
+        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: output shapes");
       }
-      b_shape_ = b_shape_opt.value();
     }
 
-    // Get output shape (Y)
-    auto y_shape_opt = GetTensorShape(node_outputs[0]);
-    if (!y_shape_opt.has_value()) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Output must have static shape");
+    uint64_t intermediates_size = 0;
+    if (!reader.Read(intermediates_size)) {
+      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: memory plan");
     }
-    y_shape_ = y_shape_opt.value();
-    output_shapes_.push_back(y_shape_);
+    intermediates_size_ = static_cast<size_t>(intermediates_size);
 
-    // Get data type
-    data_type_ = ToMIOpenDataType(GetTensorElementType(node_inputs[0]));
+    auto read_locations = [&reader](std::vector<ValueLocation>& locations) {
+      uint64_t count = 0;
+      if (!reader.Read(count)) {
+        return false;
+      }
+      locations.resize(count);
+      for (auto& location : locations) {
+        int64_t kind = 0;
+        uint64_t index = 0;
+        int64_t blocked = 0;
+        if (!reader.Read(kind) || !reader.Read(index) || !reader.Read(blocked) || kind < 0 ||
+            kind > static_cast<int64_t>(ValueLocation::Kind::kScratch)) {
+          return false;
+        }
+        location = {static_cast<ValueLocation::Kind>(kind), static_cast<size_t>(index), blocked != 0};
+      }
+      return true;
+    };
 
-    // Get convolution attributes
-    std::vector<int64_t> pads = GetIntsAttrOrDefault(conv_node, "pads", {0, 0, 0, 0});
-    std::vector<int64_t> strides = GetIntsAttrOrDefault(conv_node, "strides", {1, 1});
-    std::vector<int64_t> dilations = GetIntsAttrOrDefault(conv_node, "dilations", {1, 1});
+    uint64_t num_ops = 0;
+    if (!reader.Read(num_ops)) {
+      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: ops");
+    }
+    op_inputs_.resize(num_ops);
+    op_outputs_.resize(num_ops);
 
-    // Normalize pads
-    if (pads.size() == 2) {
-      pads = {pads[0], pads[1], pads[0], pads[1]};
+    for (size_t i = 0; i < num_ops; ++i) {
+      std::string op_type;
+      if (!reader.Read(op_type)) {
+        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: op " << i);
+      }
+
+      std::unique_ptr<Op> op;
+      if (op_type == "Conv" || op_type == "ConvTranspose") {
+        auto info = std::make_unique<ConvOpInfo>();
+        if (!info->Deserialize(reader)) {
+          RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: " << op_type << " op " << i);
+        }
+        RETURN_IF_ERROR(backend_.LoadConv(std::move(info), reader, same_fingerprint, op));
+      } else if (op_type == "MatMul" || op_type == "Gemm") {
+        auto info = std::make_unique<MatMulOpInfo>();
+        info->op_type = op_type;
+        if (!info->Deserialize(reader)) {
+          RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: " << op_type << " op " << i);
+        }
+        RETURN_IF_ERROR(backend_.CompileMatMul(std::move(info), op));
+      } else if (IsPoolOpType(op_type)) {
+        auto info = std::make_unique<PoolOpInfo>();
+        info->op_type = op_type;
+        if (!info->Deserialize(reader)) {
+          RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: " << op_type << " op " << i);
+        }
+        RETURN_IF_ERROR(backend_.CompilePool(std::move(info), op));
+      } else if (IsPointwiseOpType(op_type)) {
+        auto info = std::make_unique<PointwiseOpInfo>();
+        info->op_type = op_type;
+        if (!info->Deserialize(reader)) {
+          RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: " << op_type << " op " << i);
+        }
+        RETURN_IF_ERROR(backend_.CompilePointwise(std::move(info), op));
+      } else {
+        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Unsupported op in EP context: " << op_type);
+      }
+      AddOp(std::move(op));
+
+      if (!read_locations(op_inputs_[i]) || !read_locations(op_outputs_[i])) {
+        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Corrupt EP context: locations of op " << i);
+      }
     }
 
-    std::cerr << "Input shape: [" << x_shape_[0] << ", " << x_shape_[1] << ", " 
-              << x_shape_[2] << ", " << x_shape_[3] << "]" << std::endl;
-    std::cerr << "Weight shape: [" << w_shape_[0] << ", " << w_shape_[1] << ", " 
-              << w_shape_[2] << ", " << w_shape_[3] << "]" << std::endl;
-    std::cerr << "Output shape: [" << y_shape_[0] << ", " << y_shape_[1] << ", " 
-              << y_shape_[2] << ", " << y_shape_[3] << "]" << std::endl;
-    std::cerr << "Has bias: " << has_bias_ << std::endl;
-
-    // Create tensor descriptors
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&x_desc_));
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&w_desc_));
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&y_desc_));
-
-    // Set tensor descriptors (NCHW format)
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSet4dTensorDescriptor(
-        x_desc_, data_type_,
-        static_cast<int>(x_shape_[0]), static_cast<int>(x_shape_[1]),
-        static_cast<int>(x_shape_[2]), static_cast<int>(x_shape_[3])));
-
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSet4dTensorDescriptor(
-        w_desc_, data_type_,
-        static_cast<int>(w_shape_[0]), static_cast<int>(w_shape_[1]),
-        static_cast<int>(w_shape_[2]), static_cast<int>(w_shape_[3])));
-
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSet4dTensorDescriptor(
-        y_desc_, data_type_,
-        static_cast<int>(y_shape_[0]), static_cast<int>(y_shape_[1]),
-        static_cast<int>(y_shape_[2]), static_cast<int>(y_shape_[3])));
-
-    // Create and set bias descriptor if needed
-    if (has_bias_) {
-      MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&b_desc_));
-      // Bias is 1D [C], we set it as [1, C, 1, 1] for broadcasting
-      // Use explicit strides for proper broadcasting behavior
-      int b_dims[4] = {1, static_cast<int>(b_shape_[0]), 1, 1};
-      int b_strides[4] = {static_cast<int>(b_shape_[0]), 1, 1, 1};
-      MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetTensorDescriptor(
-          b_desc_, data_type_, 4, b_dims, b_strides));
+    RETURN_IF_ERROR(ApplyLayouts());
+
+    LOG(ort_api_, logger_, VERBOSE,
+        "Loaded " << ops_.size() << " ops from EP context, intermediates: " << intermediates_size_
+                  << " bytes, workspace: " << workspace_size_ << " bytes");
+
+    backend_.ReserveScratch(intermediates_size_ + workspace_size_);
+
+  } catch (const Ort::Exception& ex) {
+    Ort::Status status(ex);
+    return status.release();
+  } catch (const std::exception& ex) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Exception loading EP context: " << ex.what());
+  }
+
+  return nullptr;
+}
+
+void Kernel::AddOp(std::unique_ptr<Op> op) {
+  workspace_size_ = std::max(workspace_size_, op->WorkspaceSize());
+  ops_.push_back(std::move(op));
+}
+
+std::unordered_set<std::string> Kernel::AssignLayouts() const {
+  std::unordered_set<std::string> blocked;
+  if (backend_.BlockedLayoutChannels() == 0) {
+    return blocked;
+  }
+
+  // Intermediates whose producer can write them blocked...
+  for (const auto& op : ops_) {
+    const std::vector<std::string>& outputs = op->Info().outputs;
+    if (op->SupportsBlockedLayout() != BlockedLayoutSupport::kNone && !outputs.empty() &&
+        output_indices_.count(outputs[0]) == 0) {
+      blocked.insert(outputs[0]);
     }
+  }
 
-    // Create convolution descriptor
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateConvolutionDescriptor(&conv_desc_));
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenInitConvolutionDescriptor(
-        conv_desc_,
-        miopenConvolution,  // mode
-        static_cast<int>(pads[0]),      // pad_h
-        static_cast<int>(pads[1]),      // pad_w
-        static_cast<int>(strides[0]),   // stride_h
-        static_cast<int>(strides[1]),   // stride_w
-        static_cast<int>(dilations[0]), // dilation_h
-        static_cast<int>(dilations[1])  // dilation_w
-    ));
-
-    // Get workspace size first
-    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenConvolutionForwardGetWorkSpaceSize(
-        miopen_handle_,
-        w_desc_,
-        x_desc_,
-        conv_desc_,
-        y_desc_,
-        &workspace_size_));
-
-    std::cerr << "Workspace size: " << workspace_size_ << std::endl;
-
-    // Allocate workspace
-    if (workspace_size_ > 0) {
-      hipError_t hip_err = hipMalloc(&workspace_, workspace_size_);
-      if (hip_err != hipSuccess) {
-        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Failed to allocate workspace: " << hipGetErrorString(hip_err));
+  // ...and every consumer can read them blocked at that input
+  for (const auto& op : ops_) {
+    const BlockedLayoutSupport support = op->SupportsBlockedLayout();
+    const std::vector<std::string>& inputs = op->Info().inputs;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (support == BlockedLayoutSupport::kNone || (support == BlockedLayoutSupport::kIndependent && i > 0)) {
+        blocked.erase(inputs[i]);
       }
     }
+  }
 
-    // Allocate temporary GPU buffers for finding algorithm
-    void* x_tmp = nullptr;
-    void* w_tmp = nullptr;
-    void* y_tmp = nullptr;
-    
-    size_t x_size = x_shape_[0] * x_shape_[1] * x_shape_[2] * x_shape_[3] * sizeof(float);
-    size_t w_size = w_shape_[0] * w_shape_[1] * w_shape_[2] * w_shape_[3] * sizeof(float);
-    size_t y_size = y_shape_[0] * y_shape_[1] * y_shape_[2] * y_shape_[3] * sizeof(float);
-    
-    if (data_type_ == miopenHalf) {
-      x_size /= 2;
-      w_size /= 2;
-      y_size /= 2;
+  // A uniform op with any plain tensor needs all of them plain. That can leave another uniform op mixed, so
+  // repeat until no op changes.
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (const auto& op : ops_) {
+      if (op->SupportsBlockedLayout() != BlockedLayoutSupport::kUniform) {
+        continue;
+      }
+      const OpInfo& info = op->Info();
+      bool all_blocked = blocked.count(info.outputs[0]) != 0;
+      for (const auto& name : info.inputs) {
+        all_blocked = all_blocked && blocked.count(name) != 0;
+      }
+      if (!all_blocked) {
+        changed = blocked.erase(info.outputs[0]) != 0 || changed;
+        for (const auto& name : info.inputs) {
+          changed = blocked.erase(name) != 0 || changed;
+        }
+      }
     }
+  }
 
-    hipError_t hip_err = hipMalloc(&x_tmp, x_size);
-    if (hip_err != hipSuccess) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Failed to allocate x_tmp: " << hipGetErrorString(hip_err));
+  return blocked;
+}
+
+OrtStatus* Kernel::ApplyLayouts() {
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    const BlockedLayoutSupport support = ops_[i]->SupportsBlockedLayout();
+    const bool input_blocked = !op_inputs_[i].empty() && op_inputs_[i][0].blocked;
+    const bool output_blocked = !op_outputs_[i].empty() && op_outputs_[i][0].blocked;
+
+    bool valid = true;
+    for (size_t j = 0; j < op_inputs_[i].size(); ++j) {
+      const bool blocked = op_inputs_[i][j].blocked;
+      switch (support) {
+        case BlockedLayoutSupport::kNone:
+          valid = valid && !blocked;
+          break;
+        case BlockedLayoutSupport::kIndependent:
+          valid = valid && (j == 0 || !blocked);
+          break;
+        case BlockedLayoutSupport::kUniform:
+          valid = valid && blocked == output_blocked;
+          break;
+      }
+    }
+    for (size_t j = 1; j < op_outputs_[i].size(); ++j) {
+      valid = valid && !op_outputs_[i][j].blocked;
     }
-    
-    hip_err = hipMalloc(&w_tmp, w_size);
-    if (hip_err != hipSuccess) {
-      hipFree(x_tmp);
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Failed to allocate w_tmp: " << hipGetErrorString(hip_err));
+    valid = valid && (support != BlockedLayoutSupport::kNone || !output_blocked);
+    if (!valid) {
+      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Op " << ops_[i]->Info().node_name
+                                                << " doesn't support the blocked layout of its tensors");
     }
-    
-    hip_err = hipMalloc(&y_tmp, y_size);
-    if (hip_err != hipSuccess) {
-      hipFree(x_tmp);
-      hipFree(w_tmp);
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Failed to allocate y_tmp: " << hipGetErrorString(hip_err));
+
+    if (support != BlockedLayoutSupport::kNone) {
+      ops_[i]->UseBlockedLayout(input_blocked, output_blocked);
     }
+  }
+  return nullptr;
+}
 
-    // Find the best convolution algorithm (required by MIOpen)
-    const int request_algo_count = 4;
-    int returned_algo_count = 0;
-    miopenConvAlgoPerf_t perf_results[request_algo_count];
-
-    std::cerr << "Finding convolution algorithm..." << std::endl;
-    miopenStatus_t find_status = miopenFindConvolutionForwardAlgorithm(
-        miopen_handle_,
-        x_desc_,
-        x_tmp,
-        w_desc_,
-        w_tmp,
-        conv_desc_,
-        y_desc_,
-        y_tmp,
-        request_algo_count,
-        &returned_algo_count,
-        perf_results,
-        workspace_,
-        workspace_size_,
-        false  // exhaustiveSearch
-    );
-
-    // Free temporary buffers
-    hipFree(x_tmp);
-    hipFree(w_tmp);
-    hipFree(y_tmp);
-
-    if (find_status != miopenStatusSuccess) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "miopenFindConvolutionForwardAlgorithm failed: " << find_status);
+OrtStatus* Kernel::PlanValues(const std::unordered_map<std::string, Ort::ConstValueInfo>& node_outputs,
+                              const std::unordered_set<std::string>& blocked_values) {
+  // Index of the last op reading each value, so its scratch space can be reused afterwards
+  std::unordered_map<std::string, size_t> last_use;
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    for (const auto& name : ops_[i]->Info().inputs) {
+      last_use[name] = i;
     }
+  }
 
-    if (returned_algo_count == 0) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "No convolution algorithm found");
+  struct Block {
+    size_t offset;
+    size_t size;
+  };
+  std::vector<Block> free_blocks;
+  std::unordered_map<std::string, Block> scratch_values;
+
+  op_inputs_.resize(ops_.size());
+  op_outputs_.resize(ops_.size());
+
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    const OpInfo& info = ops_[i]->Info();
+
+    for (const auto& name : info.inputs) {
+      ValueLocation location;
+      if (!name.empty()) {
+        if (auto it = input_indices_.find(name); it != input_indices_.end()) {
+          location = {ValueLocation::Kind::kInput, it->second};
+        } else if (auto it = output_indices_.find(name); it != output_indices_.end()) {
+          location = {ValueLocation::Kind::kOutput, it->second};
+        } else if (auto it = scratch_values.find(name); it != scratch_values.end()) {
+          location = {ValueLocation::Kind::kScratch, it->second.offset, blocked_values.count(name) != 0};
+        } else {
+          RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Input " << name << " of " << info.node_name << " is not produced");
+        }
+      }
+      op_inputs_[i].push_back(location);
     }
 
-    // Use the best algorithm found
-    conv_algo_ = perf_results[0].fwd_algo;
-    std::cerr << "Selected algorithm: " << conv_algo_ << ", time: " << perf_results[0].time << " ms" << std::endl;
+    for (const auto& name : info.outputs) {
+      if (auto it = output_indices_.find(name); it != output_indices_.end()) {
+        op_outputs_[i].push_back({ValueLocation::Kind::kOutput, it->second});
+        continue;
+      }
 
-    std::cerr << "MIOpen Kernel::BuildAndCompile complete" << std::endl;
+      // Intermediate: first fit into space released by earlier values, else grow the scratch buffer
+      auto value_it = node_outputs.find(name);
+      if (value_it == node_outputs.end()) {
+        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "No type info for intermediate " << name);
+      }
+      auto shape = GetTensorShape(value_it->second);
+      size_t element_size = GetElementSize(GetTensorElementType(value_it->second));
+      if (!shape.has_value() || element_size == 0) {
+        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Intermediate " << name << " must be a static-shaped tensor");
+      }
 
-  } catch (const std::exception& ex) {
-    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Exception building MIOpen kernel: " << ex.what());
+      // A blocked intermediate pads its channels to whole blocks
+      const bool blocked = blocked_values.count(name) != 0;
+      std::vector<int64_t> dims = *shape;
+      if (blocked) {
+        const int64_t block_channels = backend_.BlockedLayoutChannels();
+        dims[1] = (dims[1] + block_channels - 1) / block_channels * block_channels;
+      }
+
+      size_t size = element_size;
+      for (int64_t dim : dims) {
+        if (dim < 0) {
+          RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Intermediate " << name << " must have a static shape");
+        }
+        size *= static_cast<size_t>(dim);
+      }
+      size = AlignScratch(size);
+
+      Block block{intermediates_size_, size};
+      auto fit = std::find_if(free_blocks.begin(), free_blocks.end(), [&](const Block& b) { return b.size >= size; });
+      if (fit != free_blocks.end()) {
+        block.offset = fit->offset;
+        fit->offset += size;
+        fit->size -= size;
+        if (fit->size == 0) {
+          free_blocks.erase(fit);
+        }
+      } else {
+        intermediates_size_ += size;
+      }
+
+      scratch_values[name] = block;
+      op_outputs_[i].push_back({ValueLocation::Kind::kScratch, block.offset, blocked});
+    }
+
+    // Release intermediates whose last reader is this op (or that nothing reads)
+    for (const auto& name : info.outputs) {
+      auto it = scratch_values.find(name);
+      if (it != scratch_values.end() && last_use.count(name) == 0) {
+        free_blocks.push_back(it->second);
+      }
+    }
+    for (const auto& name : info.inputs) {
+      auto it = scratch_values.find(name);
+      if (it != scratch_values.end() && last_use[name] == i) {
+        free_blocks.push_back(it->second);
+        last_use[name] = SIZE_MAX;  // An op may read the same value twice
+      }
+    }
   }
 
   return nullptr;
 }
 
-OrtStatus* Kernel::Execute(OrtKernelContext* kernel_ctx) {
+OrtStatus* Kernel::Execute(OrtKernelContext* kernel_ctx) const {
   try {
-    std::cerr << "MIOpen Kernel::Execute" << std::endl;
-
     Ort::KernelContext context(kernel_ctx);
 
-    // Validate input/output counts
-    if (context.GetInputCount() < 2) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Expected at least 2 inputs, got " << context.GetInputCount());
-    }
+    auto run_ops = [&](ExecutionContext& ctx, void* scratch) -> OrtStatus* {
+      if (workspace_size_ > 0) {
+        ctx.workspace = static_cast<char*>(scratch) + intermediates_size_;
+      }
 
-    // Get input pointers
-    Ort::ConstValue x_tensor = context.GetInput(0);
-    Ort::ConstValue w_tensor = context.GetInput(1);
-    const void* x_ptr = x_tensor.GetTensorRawData();
-    const void* w_ptr = w_tensor.GetTensorRawData();
-
-    // Allocate output
-    Ort::UnownedValue y_tensor = context.GetOutput(0, output_shapes_[0]);
-    void* y_ptr = y_tensor.GetTensorMutableRawData();
-
-    // Scaling factors
-    float alpha = 1.0f;
-    float beta = 0.0f;
-
-    miopenStatus_t status;
-
-    // Execute convolution: y = conv(x, w)
-    // Note: MIOpen only supports alpha=1 and beta=0 for 2D convolutions
-    std::cerr << "Executing miopenConvolutionForward..." << std::endl;
-    
-    status = miopenConvolutionForward(
-        miopen_handle_,
-        &alpha,
-        x_desc_,
-        x_ptr,
-        w_desc_,
-        w_ptr,
-        conv_desc_,
-        conv_algo_,
-        &beta,
-        y_desc_,
-        y_ptr,
-        workspace_,
-        workspace_size_);
-
-    if (status != miopenStatusSuccess) {
-      RETURN_ERROR(ort_api_, ORT_EP_FAIL, "miopenConvolutionForward failed: " << status);
-    }
+      // Resolve the kernel's own inputs/outputs once; outputs are allocated by ORT here
+      std::vector<const void*> inputs(context.GetInputCount());
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i] = context.GetInput(i).GetTensorRawData();
+      }
+      std::vector<void*> outputs(output_shapes_.size());
+      for (size_t i = 0; i < outputs.size(); ++i) {
+        outputs[i] = context.GetOutput(i, output_shapes_[i]).GetTensorMutableRawData();
+      }
 
-    // Add bias if present: y = y + bias
-    if (has_bias_ && context.GetInputCount() >= 3) {
-      std::cerr << "Adding bias with miopenOpTensor..." << std::endl;
-      
-      Ort::ConstValue b_tensor = context.GetInput(2);
-      const void* b_ptr = b_tensor.GetTensorRawData();
-
-      // y = 1*y + 1*bias + 0*y = y + bias
-      float alpha1 = 1.0f;
-      float alpha2 = 1.0f;
-      float beta_op = 0.0f;
-      
-      status = miopenOpTensor(
-          miopen_handle_,
-          miopenTensorOpAdd,
-          &alpha1,
-          y_desc_,
-          y_ptr,
-          &alpha2,
-          b_desc_,
-          b_ptr,
-          &beta_op,
-          y_desc_,
-          y_ptr);
-
-      if (status != miopenStatusSuccess) {
-        RETURN_ERROR(ort_api_, ORT_EP_FAIL, "miopenOpTensor (bias add) failed: " << status);
+      auto* intermediates = static_cast<char*>(scratch);
+      auto resolve = [&](const ValueLocation& location) -> void* {
+        switch (location.kind) {
+          case ValueLocation::Kind::kInput:
+            return const_cast<void*>(inputs[location.index]);
+          case ValueLocation::Kind::kOutput:
+            return outputs[location.index];
+          case ValueLocation::Kind::kScratch:
+            return intermediates + location.index;
+          case ValueLocation::Kind::kNone:
+            break;
+        }
+        return nullptr;
+      };
+
+      std::vector<const void*> op_inputs;
+      std::vector<void*> op_outputs;
+      for (size_t i = 0; i < ops_.size(); ++i) {
+        op_inputs.clear();
+        for (const auto& location : op_inputs_[i]) {
+          op_inputs.push_back(resolve(location));
+        }
+
+        op_outputs.clear();
+        for (const auto& location : op_outputs_[i]) {
+          op_outputs.push_back(resolve(location));
+        }
+
+        TRACE(ort_api_, logger_, "Execute " << ops_[i]->Info().op_type << " " << ops_[i]->Info().node_name);
+        RETURN_IF_ERROR(ops_[i]->Execute(ctx, op_inputs, op_outputs));
       }
-    }
+      return nullptr;
+    };
 
-    std::cerr << "MIOpen Kernel::Execute complete" << std::endl;
+    // The backend leases what the call runs with: a handle and stream on the GPU, and scratch memory for the
+    // intermediates followed by the op workspace. The lease is exclusive, so concurrent runs never see each
+    // other's intermediates.
+    return backend_.Run(context, intermediates_size_ + workspace_size_, run_ops);
 
   } catch (const Ort::Exception& ex) {
     Ort::Status status(ex);
     return status.release();
   } catch (const std::exception& ex) {
-    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Exception in MIOpen Kernel::Execute: " << ex.what());
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Exception in Kernel::Execute: " << ex.what());
   }
-
-  return nullptr;
 }
 
 }  // namespace hipdnn_ep
@@ -0,0 +1,195 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/matmul_op.h"
+#include "hipdnn_ep/blaslt_handle.h"
+#include "hipdnn_ep/miopen_utils.h"
+
+#include <memory>
+#include <type_traits>
+
+namespace hipdnn_ep {
+
+namespace {
+
+// Upper bound on the workspace an algorithm may ask for; the arena keeps the largest one per stream
+constexpr uint64_t kMaxWorkspaceSize = 32 * 1024 * 1024;
+
+using MatmulDescPtr = std::unique_ptr<std::remove_pointer_t<hipblasLtMatmulDesc_t>,
+                                      decltype(&hipblasLtMatmulDescDestroy)>;
+
+// Creates a column-major rows x cols matrix layout, strided by `batch_stride` elements when batched
+OrtStatus* CreateMatrixLayout(const OrtApi& ort_api, hipDataType data_type, int64_t rows, int64_t cols,
+                              int64_t batch_count, int64_t batch_stride, hipblasLtMatrixLayout_t& layout) {
+  HIPBLASLT_RETURN_IF_ERROR(ort_api, hipblasLtMatrixLayoutCreate(&layout, data_type, static_cast<uint64_t>(rows),
+                                                                 static_cast<uint64_t>(cols), rows));
+  if (batch_count > 1) {
+    int32_t count = static_cast<int32_t>(batch_count);
+    HIPBLASLT_RETURN_IF_ERROR(ort_api, hipblasLtMatrixLayoutSetAttribute(
+        layout, HIPBLASLT_MATRIX_LAYOUT_BATCH_COUNT, &count, sizeof(count)));
+    HIPBLASLT_RETURN_IF_ERROR(ort_api, hipblasLtMatrixLayoutSetAttribute(
+        layout, HIPBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET, &batch_stride, sizeof(batch_stride)));
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+MatMulOp::MatMulOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<MatMulOpInfo> info)
+    : Op(std::move(info)), ort_api_(ort_api), logger_(logger) {
+}
+
+MatMulOp::~MatMulOp() {
+  if (matmul_desc_) hipblasLtMatmulDescDestroy(matmul_desc_);
+  if (b_layout_) hipblasLtMatrixLayoutDestroy(b_layout_);
+  if (a_layout_) hipblasLtMatrixLayoutDestroy(a_layout_);
+  if (y_layout_) hipblasLtMatrixLayoutDestroy(y_layout_);
+  if (y_desc_) miopenDestroyTensorDescriptor(y_desc_);
+  if (activation_desc_) miopenDestroyActivationDescriptor(activation_desc_);
+}
+
+OrtStatus* MatMulOp::Compile(hipblasLtHandle_t blaslt_handle) {
+  const MatMulOpInfo& info = MatMulInfo();
+  blaslt_handle_ = blaslt_handle;
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << ": m=" << info.m << ", n=" << info.n << ", k=" << info.k
+                   << ", batch: " << info.batch_count << ", addend: " << static_cast<int>(info.addend)
+                   << ", activation: " << static_cast<int>(info.activation.kind));
+
+  const bool has_bias = info.addend == MatMulOpInfo::Addend::kBias;
+  const bool relu = info.activation.kind == Activation::Kind::kRelu;
+  if (has_bias) {
+    epilogue_ = relu ? HIPBLASLT_EPILOGUE_RELU_BIAS : HIPBLASLT_EPILOGUE_BIAS;
+  } else if (relu) {
+    epilogue_ = HIPBLASLT_EPILOGUE_RELU;
+  }
+  RETURN_IF_ERROR(CreateMatmulDesc(matmul_desc_));
+
+  // Row-major [r, c] is column-major c x r with leading dimension c
+  hipDataType data_type = ToHipDataType(info.dtype);
+  RETURN_IF_ERROR(CreateMatrixLayout(ort_api_, data_type, info.trans_b ? info.k : info.n,
+                                     info.trans_b ? info.n : info.k, info.batch_count,
+                                     info.b_batched ? info.n * info.k : 0, b_layout_));
+  RETURN_IF_ERROR(CreateMatrixLayout(ort_api_, data_type, info.trans_a ? info.m : info.k,
+                                     info.trans_a ? info.k : info.m, info.batch_count,
+                                     info.a_batched ? info.m * info.k : 0, a_layout_));
+  RETURN_IF_ERROR(CreateMatrixLayout(ort_api_, data_type, info.n, info.m, info.batch_count, info.m * info.n,
+                                     y_layout_));
+
+  // Pick the algorithm hipBLASLt ranks first for this problem within the workspace limit
+  hipblasLtMatmulPreference_t preference = nullptr;
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulPreferenceCreate(&preference));
+  std::unique_ptr<std::remove_pointer_t<hipblasLtMatmulPreference_t>, decltype(&hipblasLtMatmulPreferenceDestroy)>
+      preference_guard(preference, hipblasLtMatmulPreferenceDestroy);
+  uint64_t max_workspace_size = kMaxWorkspaceSize;
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulPreferenceSetAttribute(
+      preference, HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES, &max_workspace_size, sizeof(max_workspace_size)));
+
+  hipblasLtMatmulHeuristicResult_t result{};
+  int returned_algo_count = 0;
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulAlgoGetHeuristic(
+      blaslt_handle_, matmul_desc_, b_layout_, a_layout_, y_layout_, y_layout_, preference, 1, &result,
+      &returned_algo_count));
+  if (returned_algo_count == 0) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "No hipBLASLt algorithm for " << info.op_type << " " << info.node_name);
+  }
+  algo_ = result.algo;
+  workspace_size_ = result.workspaceSize;
+
+  if (info.activation.kind != Activation::Kind::kNone && !relu) {
+    miopenActivationMode_t mode = miopenActivationPASTHRU;
+    double alpha = 0.0;
+    double beta = 0.0;
+    double gamma = 0.0;
+    ToMIOpenActivation(info.activation, mode, alpha, beta, gamma);
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateActivationDescriptor(&activation_desc_));
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetActivationDescriptor(activation_desc_, mode, alpha, beta, gamma));
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&y_desc_));
+    MIOPEN_RETURN_IF_ERROR(ort_api_, SetPackedTensorDescriptor(
+        y_desc_, ToMIOpenDataType(info.dtype), {info.batch_count * info.m, info.n}));
+  }
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << ": epilogue " << epilogue_ << ", workspace size: "
+                   << workspace_size_);
+  return nullptr;
+}
+
+OrtStatus* MatMulOp::CreateMatmulDesc(hipblasLtMatmulDesc_t& desc) const {
+  const MatMulOpInfo& info = MatMulInfo();
+
+  // Compute in fp32 for both fp32 and fp16 data, so alpha and beta are floats
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulDescCreate(&desc, HIPBLAS_COMPUTE_32F, HIP_R_32F));
+  hipblasOperation_t op_b = info.trans_b ? HIPBLAS_OP_T : HIPBLAS_OP_N;
+  hipblasOperation_t op_a = info.trans_a ? HIPBLAS_OP_T : HIPBLAS_OP_N;
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulDescSetAttribute(
+      desc, HIPBLASLT_MATMUL_DESC_TRANSA, &op_b, sizeof(op_b)));
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulDescSetAttribute(
+      desc, HIPBLASLT_MATMUL_DESC_TRANSB, &op_a, sizeof(op_a)));
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulDescSetAttribute(
+      desc, HIPBLASLT_MATMUL_DESC_EPILOGUE, &epilogue_, sizeof(epilogue_)));
+  if (info.addend == MatMulOpInfo::Addend::kBias) {
+    hipDataType bias_type = ToHipDataType(info.dtype);
+    HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulDescSetAttribute(
+        desc, HIPBLASLT_MATMUL_DESC_BIAS_DATA_TYPE, &bias_type, sizeof(bias_type)));
+  }
+  return nullptr;
+}
+
+OrtStatus* MatMulOp::Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                             const std::vector<void*>& outputs) const {
+  const MatMulOpInfo& info = MatMulInfo();
+  const void* a = inputs[0];
+  const void* b = inputs[1];
+  void* y = outputs[0];
+
+  // Without Gemm's C matrix, beta is 0 and C aliases Y
+  const bool has_c = info.addend == MatMulOpInfo::Addend::kMatrix;
+  const void* c = has_c ? inputs[2] : y;
+  float alpha = info.alpha;
+  float beta = has_c ? info.beta : 0.0f;
+
+  // The bias pointer belongs to this call, so concurrent runs each set it on their own descriptor
+  hipblasLtMatmulDesc_t matmul_desc = matmul_desc_;
+  MatmulDescPtr call_desc(nullptr, hipblasLtMatmulDescDestroy);
+  if (info.addend == MatMulOpInfo::Addend::kBias) {
+    hipblasLtMatmulDesc_t desc = nullptr;
+    RETURN_IF_ERROR(CreateMatmulDesc(desc));
+    call_desc.reset(desc);
+    const void* bias = inputs[2];
+    HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmulDescSetAttribute(
+        desc, HIPBLASLT_MATMUL_DESC_BIAS_POINTER, &bias, sizeof(bias)));
+    matmul_desc = desc;
+  }
+
+  HIPBLASLT_RETURN_IF_ERROR(ort_api_, hipblasLtMatmul(
+      blaslt_handle_,
+      matmul_desc,
+      &alpha,
+      b,
+      b_layout_,
+      a,
+      a_layout_,
+      &beta,
+      c,
+      y_layout_,
+      y,
+      y_layout_,
+      &algo_,
+      ctx.workspace,
+      workspace_size_,
+      ctx.stream));
+
+  // Apply the activation hipBLASLt could not fuse: y = act(y)
+  if (activation_desc_ != nullptr) {
+    float act_alpha = 1.0f;
+    float act_beta = 0.0f;
+    MIOPEN_RETURN_IF_ERROR(ort_api_, miopenActivationForward(
+        ctx.miopen_handle, activation_desc_, &act_alpha, y_desc_, y, &act_beta, y_desc_, y));
+  }
+
+  return nullptr;
+}
+
+}  // namespace hipdnn_ep
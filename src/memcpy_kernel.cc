@@ -5,7 +5,6 @@
 #include "hipdnn_ep/ep_factory.h"
 
 #include <cstring>
-#include <iostream>
 
 namespace hipdnn_ep {
 
@@ -36,9 +35,7 @@ OrtStatus* ORT_API_CALL MemcpyKernelImpl::ComputeImpl(
     auto shape = input_type_shape.GetShape();
 
     // Create output with same shape
-    std::cerr << "MemcpyKernelImpl::ComputeImpl ctx.GetOutput 0" << std::endl;
     Ort::UnownedValue output = ctx.GetOutput(0, shape);
-    std::cerr << "MemcpyKernelImpl::ComputeImpl ctx.GetOutput 1" << std::endl;
 
     // Get data pointers
     const void* src_data = input.GetTensorRawData();
@@ -108,14 +105,22 @@ OrtStatus* ORT_API_CALL MemcpyKernelImpl::ComputeImpl(
     if (impl->direction_ == Direction::ToHost) {
       // GPU -> CPU
       copy_kind = hipMemcpyDeviceToHost;
-      std::cerr << "MemcpyToHost: " << byte_size << " bytes" << std::endl;
     } else {
       // CPU -> GPU
       copy_kind = hipMemcpyHostToDevice;
-      std::cerr << "MemcpyFromHost: " << byte_size << " bytes" << std::endl;
     }
 
-    err = hipMemcpy(dst_data, src_data, byte_size, copy_kind);
+    // Enqueued on the node's stream; consumers on other streams (or the host) wait on ORT's
+    // notification for it, so no synchronization is needed here
+    hipStream_t stream = static_cast<hipStream_t>(ctx.GetGPUComputeStream());
+    TRACE(impl->factory_.ort_api, impl->factory_.GetLogger(),
+          (impl->direction_ == Direction::ToHost ? "MemcpyToHost: " : "MemcpyFromHost: ")
+              << byte_size << " bytes on stream " << stream);
+    if (stream != nullptr) {
+      err = hipMemcpyAsync(dst_data, src_data, byte_size, copy_kind, stream);
+    } else {
+      err = hipMemcpy(dst_data, src_data, byte_size, copy_kind);
+    }
     if (err != hipSuccess) {
       RETURN_ERROR(impl->factory_.ort_api, ORT_EP_FAIL,
                    "MemcpyKernel: hipMemcpy failed: " << hipGetErrorString(err));
@@ -213,7 +218,7 @@ OrtStatus* RegisterMemcpyKernels(
 
     ep_api.ReleaseKernelDef(kernel_def);
 
-    std::cerr << "Registered MemcpyToHost kernel for " << ep_name << std::endl;
+    LOG(factory.ort_api, factory.GetLogger(), VERBOSE, "Registered MemcpyToHost kernel for " << ep_name);
   }
 
   // Register MemcpyFromHost kernel (CPU -> GPU)
@@ -242,7 +247,7 @@ OrtStatus* RegisterMemcpyKernels(
 
     ep_api.ReleaseKernelDef(kernel_def);
 
-    std::cerr << "Registered MemcpyFromHost kernel for " << ep_name << std::endl;
+    LOG(factory.ort_api, factory.GetLogger(), VERBOSE, "Registered MemcpyFromHost kernel for " << ep_name);
   }
 
   return nullptr;
@@ -0,0 +1,89 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/miopen_handle_pool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace hipdnn_ep {
+
+MIOpenHandlePool::Lease::~Lease() {
+  if (pool_ != nullptr && handle_ != nullptr) {
+    pool_->Release(handle_);
+  }
+}
+
+MIOpenHandlePool::Lease::Lease(Lease&& other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr)), handle_(std::exchange(other.handle_, nullptr)) {}
+
+MIOpenHandlePool::Lease& MIOpenHandlePool::Lease::operator=(Lease&& other) noexcept {
+  if (this != &other) {
+    if (pool_ != nullptr && handle_ != nullptr) {
+      pool_->Release(handle_);
+    }
+    pool_ = std::exchange(other.pool_, nullptr);
+    handle_ = std::exchange(other.handle_, nullptr);
+  }
+  return *this;
+}
+
+MIOpenHandlePool::~MIOpenHandlePool() {
+  for (miopenHandle_t handle : handles_) {
+    miopenDestroy(handle);
+  }
+}
+
+miopenStatus_t MIOpenHandlePool::Acquire(hipStream_t stream, Lease& lease) {
+  miopenHandle_t handle = nullptr;
+  miopenStatus_t status = AcquireHandle(stream, handle);
+  if (status != miopenStatusSuccess) {
+    return status;
+  }
+
+  // Assigned outside the lock: dropping a previous lease returns its handle to the pool
+  lease = Lease(this, handle);
+  return miopenStatusSuccess;
+}
+
+miopenStatus_t MIOpenHandlePool::AcquireHandle(hipStream_t stream, miopenHandle_t& handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!free_handles_.empty()) {
+    // Prefer a handle already bound to this stream, otherwise rebind the most recently used one
+    auto it = std::find_if(free_handles_.begin(), free_handles_.end(),
+                           [&](miopenHandle_t h) { return streams_[h] == stream; });
+    if (it == free_handles_.end()) {
+      it = std::prev(free_handles_.end());
+      miopenStatus_t status = miopenSetStream(*it, stream);
+      if (status != miopenStatusSuccess) {
+        return status;
+      }
+      streams_[*it] = stream;
+    }
+    handle = *it;
+    free_handles_.erase(it);
+  } else {
+    miopenStatus_t status = miopenCreateWithStream(&handle, stream);
+    if (status != miopenStatusSuccess) {
+      return status;
+    }
+    handles_.push_back(handle);
+    streams_[handle] = stream;
+  }
+
+  return miopenStatusSuccess;
+}
+
+size_t MIOpenHandlePool::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return handles_.size();
+}
+
+void MIOpenHandlePool::Release(miopenHandle_t handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_handles_.push_back(handle);
+}
+
+}  // namespace hipdnn_ep
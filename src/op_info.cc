@@ -0,0 +1,1119 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/op_info.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace hipdnn_ep {
+
+namespace {
+
+// Op types run by the generic pointwise kernel, with the number of tensor inputs it reads
+struct PointwiseOpDef {
+  const char* op_type;
+  PointwiseFunc func;
+  size_t arity;
+};
+
+constexpr PointwiseOpDef kPointwiseOps[] = {
+    {"Relu", PointwiseFunc::kRelu, 1},
+    {"LeakyRelu", PointwiseFunc::kLeakyRelu, 1},
+    {"Sigmoid", PointwiseFunc::kSigmoid, 1},
+    {"Tanh", PointwiseFunc::kTanh, 1},
+    {"Clip", PointwiseFunc::kClip, 1},
+    {"HardSwish", PointwiseFunc::kHardSwish, 1},
+    {"Gelu", PointwiseFunc::kGelu, 1},
+    {"Add", PointwiseFunc::kAdd, 2},
+    {"Sub", PointwiseFunc::kSub, 2},
+    {"Mul", PointwiseFunc::kMul, 2},
+    {"Div", PointwiseFunc::kDiv, 2},
+};
+
+// Returns the only node consuming `value`, or a null node if the value has other consumers
+// or is a graph output (and therefore must be materialized).
+Ort::ConstNode GetSoleConsumer(Ort::ConstValueInfo value) {
+  if (value.IsGraphOutput()) {
+    return Ort::ConstNode{nullptr};
+  }
+
+  std::vector<Ort::ValueInfoConsumerProducerInfo> consumers = value.GetConsumers();
+  if (consumers.size() != 1) {
+    return Ort::ConstNode{nullptr};
+  }
+  return consumers[0].node;
+}
+
+// Returns the constant operand of `add` when it adds a constant of the same element type to `output`,
+// or a null value otherwise.
+Ort::ConstValueInfo GetConstantAddend(Ort::ConstNode add, Ort::ConstValueInfo output) {
+  if (add.GetOperatorType() != "Add" || !add.GetDomain().empty()) {
+    return Ort::ConstValueInfo{nullptr};
+  }
+
+  std::vector<Ort::ConstValueInfo> inputs = add.GetInputs();
+  std::vector<Ort::ConstValueInfo> outputs = add.GetOutputs();
+  if (inputs.size() != 2 || outputs.size() != 1) {
+    return Ort::ConstValueInfo{nullptr};
+  }
+
+  std::string output_name = output.GetName();
+  Ort::ConstValueInfo other{nullptr};
+  if (inputs[0].GetName() == output_name) {
+    other = inputs[1];
+  } else if (inputs[1].GetName() == output_name) {
+    other = inputs[0];
+  } else {
+    return Ort::ConstValueInfo{nullptr};
+  }
+
+  // Add(y, y) also has a single consumer but is not a bias
+  if (other.GetName() == output_name || !other.IsConstantInitializer()) {
+    return Ort::ConstValueInfo{nullptr};
+  }
+
+  if (GetTensorElementType(other) != GetTensorElementType(output) ||
+      GetTensorElementType(outputs[0]) != GetTensorElementType(output)) {
+    return Ort::ConstValueInfo{nullptr};
+  }
+  return other;
+}
+
+// Checks whether `add` adds a per-channel constant ([C,1,...] or [1,C,1,...]) to `conv_output`.
+// On success `bias` is set to the constant operand.
+bool IsPerChannelBiasAdd(Ort::ConstNode add, Ort::ConstValueInfo conv_output, int64_t channels,
+                         Ort::ConstValueInfo& bias) {
+  Ort::ConstValueInfo other = GetConstantAddend(add, conv_output);
+  if (!other) {
+    return false;
+  }
+
+  auto shape = GetTensorShape(other);
+  if (!shape.has_value() || shape->empty()) {
+    return false;
+  }
+
+  // The constant broadcasts against the trailing dims of the conv output, so it reaches the channel
+  // dim only as [1, C, 1, ...] (full rank) or [C, 1, ...] (rank - 1). Every other dim must be 1 so
+  // the output shape stays the conv's.
+  auto conv_shape = GetTensorShape(conv_output);
+  if (!conv_shape.has_value()) {
+    return false;
+  }
+  const std::vector<int64_t>& dims = *shape;
+  if (dims.size() != conv_shape->size() && dims.size() + 1 != conv_shape->size()) {
+    return false;
+  }
+  size_t channel_axis = dims.size() == conv_shape->size() ? 1 : 0;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (dims[i] != (i == channel_axis ? channels : 1)) {
+      return false;
+    }
+  }
+
+  bias = other;
+  return true;
+}
+
+// Checks whether `batch_norm` is an inference-mode BatchNormalization of the output of `conv` (a Conv with
+// `channels` output channels) that can be folded into it: the normalization parameters, and the Conv's
+// weights and bias, must all be constant.
+bool IsFoldableBatchNorm(Ort::ConstNode batch_norm, Ort::ConstNode conv, int64_t channels) {
+  if (batch_norm.GetOperatorType() != "BatchNormalization" || !batch_norm.GetDomain().empty() ||
+      conv.GetOperatorType() != "Conv") {
+    return false;
+  }
+
+  // Older opsets have a per-activation (spatial = 0) variant and optional running statistics outputs
+  if (GetIntAttrOrDefault(batch_norm, "training_mode", 0) != 0 || GetIntAttrOrDefault(batch_norm, "spatial", 1) != 1) {
+    return false;
+  }
+
+  std::vector<Ort::ConstValueInfo> inputs = batch_norm.GetInputs();
+  std::vector<Ort::ConstValueInfo> outputs = batch_norm.GetOutputs();
+  if (inputs.size() != 5 || outputs.empty() || !outputs[0]) {
+    return false;
+  }
+  for (size_t i = 1; i < outputs.size(); ++i) {
+    if (outputs[i]) {
+      return false;
+    }
+  }
+
+  Ort::ConstValueInfo conv_output = conv.GetOutputs()[0];
+  if (inputs[0].GetName() != conv_output.GetName() ||
+      GetTensorElementType(outputs[0]) != GetTensorElementType(conv_output)) {
+    return false;
+  }
+
+  // scale, B, mean and var are [C] constants
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    auto shape = GetTensorShape(inputs[i]);
+    if (!inputs[i].IsConstantInitializer() || !shape.has_value() || shape->size() != 1 || (*shape)[0] != channels) {
+      return false;
+    }
+  }
+
+  std::vector<Ort::ConstValueInfo> conv_inputs = conv.GetInputs();
+  if (!conv_inputs[1].IsConstantInitializer()) {
+    return false;
+  }
+  return conv_inputs.size() < 3 || !conv_inputs[2] || conv_inputs[2].IsConstantInitializer();
+}
+
+// Checks whether `add` adds a row bias ([N], [1, N], ...) to `matmul_output`, whose last dim is N.
+// On success `bias` is set to the constant operand.
+bool IsRowBiasAdd(Ort::ConstNode add, Ort::ConstValueInfo matmul_output, Ort::ConstValueInfo& bias) {
+  Ort::ConstValueInfo other = GetConstantAddend(add, matmul_output);
+  if (!other) {
+    return false;
+  }
+
+  auto shape = GetTensorShape(other);
+  auto y_shape = GetTensorShape(matmul_output);
+  if (!shape.has_value() || shape->empty() || !y_shape.has_value() || y_shape->empty() ||
+      shape->size() > y_shape->size()) {
+    return false;
+  }
+
+  // Every dim but the last must be 1 so the output shape stays the matmul's
+  const std::vector<int64_t>& dims = *shape;
+  for (size_t i = 0; i + 1 < dims.size(); ++i) {
+    if (dims[i] != 1) {
+      return false;
+    }
+  }
+  if (dims.back() != y_shape->back()) {
+    return false;
+  }
+
+  bias = other;
+  return true;
+}
+
+// Checks whether `node` is an activation that can be fused onto `input`
+bool IsFusableActivation(Ort::ConstNode node, Ort::ConstValueInfo input, ONNXTensorElementDataType dtype) {
+  Activation activation;
+  return ParseActivation(node, activation) && node.GetInputs()[0].GetName() == input.GetName() &&
+         GetTensorElementType(node.GetOutputs()[0]) == dtype;
+}
+
+// Folds the BatchNormalization of `fusion` (and the bias Add after it) into constant weights and bias:
+//   scale * (conv(x, W) + b - mean) / sqrt(var + epsilon) + beta [+ add]
+// is a Conv whose output channel c has weights W[c] * s[c] and bias (b[c] - mean[c]) * s[c] + beta[c] [+ add[c]],
+// with s = scale / sqrt(var + epsilon).
+void FoldBatchNorm(const ConvFusion& fusion, ConvOpInfo& info) {
+  std::vector<Ort::ConstValueInfo> conv_inputs = fusion.conv.GetInputs();
+  std::vector<Ort::ConstValueInfo> bn_inputs = fusion.batch_norm.GetInputs();
+  const size_t channels = static_cast<size_t>(info.w_shape[0]);
+
+  std::vector<float> scale;
+  std::vector<float> beta;
+  std::vector<float> mean;
+  std::vector<float> var;
+  HIPDNN_EP_ENFORCE(GetInitializerValues(conv_inputs[1], info.constant_weights) &&
+                        GetInitializerValues(bn_inputs[1], scale) && GetInitializerValues(bn_inputs[2], beta) &&
+                        GetInitializerValues(bn_inputs[3], mean) && GetInitializerValues(bn_inputs[4], var),
+                    "BatchNormalization " << fusion.batch_norm.GetName() << " can't be folded into its Conv");
+  HIPDNN_EP_ENFORCE(scale.size() == channels && beta.size() == channels && mean.size() == channels &&
+                        var.size() == channels && info.constant_weights.size() % channels == 0,
+                    "BatchNormalization " << fusion.batch_norm.GetName() << " parameters don't match its Conv");
+
+  std::vector<float> conv_bias(channels, 0.0f);
+  if (conv_inputs.size() >= 3 && conv_inputs[2]) {
+    HIPDNN_EP_ENFORCE(GetInitializerValues(conv_inputs[2], conv_bias) && conv_bias.size() == channels,
+                      "Conv " << fusion.conv.GetName() << " bias can't be folded");
+  }
+
+  // The Add constant is per channel, so its values are in channel order whatever its rank
+  std::vector<float> add_bias(channels, 0.0f);
+  if (fusion.bias_add) {
+    Ort::ConstValueInfo bn_output = fusion.batch_norm.GetOutputs()[0];
+    HIPDNN_EP_ENFORCE(GetInitializerValues(GetConstantAddend(fusion.bias_add, bn_output), add_bias) &&
+                          add_bias.size() == channels,
+                      "Add " << fusion.bias_add.GetName() << " can't be folded");
+  }
+
+  float epsilon = GetFloatAttrOrDefault(fusion.batch_norm, "epsilon", 1e-5f);
+  size_t channel_size = info.constant_weights.size() / channels;
+  info.constant_bias.resize(channels);
+  for (size_t c = 0; c < channels; ++c) {
+    float s = scale[c] / std::sqrt(var[c] + epsilon);
+    for (size_t i = 0; i < channel_size; ++i) {
+      info.constant_weights[c * channel_size + i] *= s;
+    }
+    info.constant_bias[c] = (conv_bias[c] - mean[c]) * s + beta[c] + add_bias[c];
+  }
+
+  info.has_bias = true;
+  info.inputs = {conv_inputs[0].GetName()};
+}
+
+// Copies the Conv's weights and bias (null without one) into `info`, which then reads only X. Leaves `info` as
+// it is unless both are constant initializers.
+void TakeConstantWeights(Ort::ConstValueInfo weights, Ort::ConstValueInfo bias, ConvOpInfo& info) {
+  const size_t channels = static_cast<size_t>(info.y_shape[1]);
+  std::vector<float> w;
+  std::vector<float> b(channels, 0.0f);
+  if (!GetInitializerValues(weights, w) || (bias && (!GetInitializerValues(bias, b) || b.size() != channels))) {
+    return;
+  }
+
+  info.constant_weights = std::move(w);
+  info.constant_bias = std::move(b);
+  info.inputs.resize(1);
+}
+
+// Resolves the explicit pads ({begin..., end...}) of a Conv or pooling node sliding a `kernel` window over the
+// spatial dims of `x_shape`, computing them from `auto_pad` (SAME_UPPER, SAME_LOWER, VALID) when it is set.
+bool ResolveWindowPads(Ort::ConstNode node, const std::vector<int64_t>& x_shape, const std::vector<int64_t>& kernel,
+                       std::vector<int64_t>& pads) {
+  size_t spatial_dims = x_shape.size() - 2;
+  std::string auto_pad = GetStringAttrOrDefault(node, "auto_pad", "NOTSET");
+
+  if (auto_pad == "NOTSET") {
+    pads = GetIntsAttrOrDefault(node, "pads", std::vector<int64_t>(spatial_dims * 2, 0));
+    if (pads.size() == spatial_dims) {
+      pads.insert(pads.end(), pads.begin(), pads.end());
+    }
+    return pads.size() == spatial_dims * 2;
+  }
+
+  pads.assign(spatial_dims * 2, 0);
+  if (auto_pad == "VALID") {
+    return true;
+  }
+  if (auto_pad != "SAME_UPPER" && auto_pad != "SAME_LOWER") {
+    return false;
+  }
+
+  // SAME: output = ceil(input / stride), with the total padding split between both ends.
+  // An odd total puts the extra element at the end (SAME_UPPER) or the beginning (SAME_LOWER).
+  std::vector<int64_t> strides = GetIntsAttrOrDefault(node, "strides", std::vector<int64_t>(spatial_dims, 1));
+  std::vector<int64_t> dilations = GetIntsAttrOrDefault(node, "dilations", std::vector<int64_t>(spatial_dims, 1));
+  if (strides.size() != spatial_dims || dilations.size() != spatial_dims || kernel.size() != spatial_dims) {
+    return false;
+  }
+  for (size_t i = 0; i < spatial_dims; ++i) {
+    int64_t input = x_shape[i + 2];
+    int64_t window = (kernel[i] - 1) * dilations[i] + 1;
+    int64_t output = (input + strides[i] - 1) / strides[i];
+    int64_t total = std::max<int64_t>(0, (output - 1) * strides[i] + window - input);
+    int64_t small_half = total / 2;
+    pads[i] = auto_pad == "SAME_UPPER" ? small_half : total - small_half;
+    pads[i + spatial_dims] = total - pads[i];
+  }
+  return true;
+}
+
+// Element strides of `shape` right-aligned against `y_shape`, 0 along the dims it is broadcast over.
+// Returns false if `shape` doesn't broadcast to `y_shape`.
+bool GetBroadcastStrides(const std::vector<int64_t>& shape, const std::vector<int64_t>& y_shape,
+                         std::vector<int64_t>& strides) {
+  if (shape.size() > y_shape.size()) {
+    return false;
+  }
+
+  strides.assign(y_shape.size(), 0);
+  const size_t offset = y_shape.size() - shape.size();
+  int64_t stride = 1;
+  for (size_t i = shape.size(); i-- > 0;) {
+    if (shape[i] == y_shape[i + offset]) {
+      strides[i + offset] = shape[i] == 1 ? 0 : stride;
+    } else if (shape[i] != 1) {
+      return false;
+    }
+    stride *= shape[i];
+  }
+  return true;
+}
+
+}  // namespace
+
+bool ParseActivation(Ort::ConstNode node, Activation& activation) {
+  if (!node.GetDomain().empty()) {
+    return false;
+  }
+
+  std::vector<Ort::ConstValueInfo> outputs = node.GetOutputs();
+  if (outputs.size() != 1) {
+    return false;
+  }
+
+  std::string op_type = node.GetOperatorType();
+  if (op_type == "Relu") {
+    activation = Activation{Activation::Kind::kRelu};
+  } else if (op_type == "LeakyRelu") {
+    activation = Activation{Activation::Kind::kLeakyRelu, GetFloatAttrOrDefault(node, "alpha", 0.01f)};
+  } else if (op_type == "Sigmoid") {
+    activation = Activation{Activation::Kind::kSigmoid};
+  } else if (op_type == "Clip") {
+    // Opset < 11 carries min/max as attributes, later opsets as optional constant inputs
+    float min_val = GetFloatAttrOrDefault(node, "min", std::numeric_limits<float>::lowest());
+    float max_val = GetFloatAttrOrDefault(node, "max", std::numeric_limits<float>::max());
+
+    std::vector<Ort::ConstValueInfo> inputs = node.GetInputs();
+    if (inputs.size() > 1 && inputs[1] && !GetScalarInitializerValue(inputs[1], min_val)) {
+      return false;
+    }
+    if (inputs.size() > 2 && inputs[2] && !GetScalarInitializerValue(inputs[2], max_val)) {
+      return false;
+    }
+    activation = Activation{Activation::Kind::kClip, min_val, max_val};
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+bool LookupPointwiseOp(const std::string& op_type, PointwiseFunc& func, size_t& arity) {
+  for (const auto& def : kPointwiseOps) {
+    if (op_type == def.op_type) {
+      func = def.func;
+      arity = def.arity;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ParsePointwiseOp(Ort::ConstNode node, PointwiseFunc& func, float& alpha, float& beta) {
+  size_t arity = 0;
+  if (!node.GetDomain().empty() || !LookupPointwiseOp(node.GetOperatorType(), func, arity)) {
+    return false;
+  }
+
+  alpha = 0.0f;
+  beta = 0.0f;
+  if (func == PointwiseFunc::kLeakyRelu || func == PointwiseFunc::kClip) {
+    // Same parameters as the fused epilogue, including Clip's constant min/max inputs
+    Activation activation;
+    if (!ParseActivation(node, activation)) {
+      return false;
+    }
+    alpha = activation.alpha;
+    beta = activation.beta;
+  } else if (func == PointwiseFunc::kGelu) {
+    std::string approximate = GetStringAttrOrDefault(node, "approximate", "none");
+    if (approximate == "tanh") {
+      func = PointwiseFunc::kGeluTanh;
+    } else if (approximate != "none") {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ResolvePointwiseParams(const PointwiseOpInfo& info, PointwiseParams& params) {
+  std::vector<int64_t> a_strides;
+  std::vector<int64_t> b_strides(info.y_shape.size(), 0);  // A unary op reads no B
+  const bool binary = info.inputs.size() > 1;
+  if (!GetBroadcastStrides(info.a_shape, info.y_shape, a_strides) ||
+      (binary && !GetBroadcastStrides(info.b_shape, info.y_shape, b_strides))) {
+    return false;
+  }
+
+  std::vector<int64_t> dims;
+  std::vector<int64_t> merged_a;
+  std::vector<int64_t> merged_b;
+  params.count = 1;
+  for (size_t i = 0; i < info.y_shape.size(); ++i) {
+    const int64_t dim = info.y_shape[i];
+    params.count *= dim;
+    if (dim == 1) {
+      continue;
+    }
+    if (!dims.empty() && merged_a.back() == a_strides[i] * dim && merged_b.back() == b_strides[i] * dim) {
+      dims.back() *= dim;
+      merged_a.back() = a_strides[i];
+      merged_b.back() = b_strides[i];
+    } else {
+      dims.push_back(dim);
+      merged_a.push_back(a_strides[i]);
+      merged_b.push_back(b_strides[i]);
+    }
+  }
+
+  params.func = info.func;
+  params.alpha = info.alpha;
+  params.beta = info.beta;
+
+  // A single dim that every input walks contiguously needs no index arithmetic at all
+  const bool contiguous = dims.empty() || (dims.size() == 1 && merged_a[0] == 1 && (!binary || merged_b[0] == 1));
+  if (contiguous) {
+    params.rank = 0;
+    return true;
+  }
+  if (dims.size() > static_cast<size_t>(PointwiseParams::kMaxRank)) {
+    return false;
+  }
+  params.rank = static_cast<int>(dims.size());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    params.y_dims[i] = dims[i];
+    params.a_strides[i] = merged_a[i];
+    params.b_strides[i] = merged_b[i];
+  }
+  return true;
+}
+
+PointwiseFunc ToPointwiseFunc(Activation::Kind kind) {
+  switch (kind) {
+    case Activation::Kind::kLeakyRelu:
+      return PointwiseFunc::kLeakyRelu;
+    case Activation::Kind::kSigmoid:
+      return PointwiseFunc::kSigmoid;
+    case Activation::Kind::kClip:
+      return PointwiseFunc::kClip;
+    case Activation::Kind::kRelu:
+    case Activation::Kind::kNone:
+      break;
+  }
+  return PointwiseFunc::kRelu;
+}
+
+std::vector<Ort::ConstNode> ConvFusion::Nodes() const {
+  std::vector<Ort::ConstNode> nodes{conv};
+  if (batch_norm) {
+    nodes.push_back(batch_norm);
+  }
+  if (bias_add) {
+    nodes.push_back(bias_add);
+  }
+  if (activation) {
+    nodes.push_back(activation);
+  }
+  return nodes;
+}
+
+bool ResolveConvPads(Ort::ConstNode conv, const std::vector<int64_t>& x_shape, const std::vector<int64_t>& w_shape,
+                     std::vector<int64_t>& pads) {
+  return ResolveWindowPads(conv, x_shape, std::vector<int64_t>(w_shape.begin() + 2, w_shape.end()), pads);
+}
+
+bool ResolvePoolPads(Ort::ConstNode pool, const std::vector<int64_t>& x_shape, std::vector<int64_t>& pads) {
+  std::vector<int64_t> kernel_shape = GetIntsAttrOrDefault(pool, "kernel_shape", {});
+  if (kernel_shape.size() + 2 != x_shape.size()) {
+    return false;
+  }
+  return ResolveWindowPads(pool, x_shape, kernel_shape, pads);
+}
+
+bool ResolveConvTransposePads(Ort::ConstNode conv_transpose, const std::vector<int64_t>& x_shape,
+                              const std::vector<int64_t>& w_shape, std::vector<int64_t>& pads,
+                              std::vector<int64_t>& output_padding) {
+  size_t spatial_dims = x_shape.size() - 2;
+  std::vector<int64_t> strides =
+      GetIntsAttrOrDefault(conv_transpose, "strides", std::vector<int64_t>(spatial_dims, 1));
+  std::vector<int64_t> dilations =
+      GetIntsAttrOrDefault(conv_transpose, "dilations", std::vector<int64_t>(spatial_dims, 1));
+  output_padding = GetIntsAttrOrDefault(conv_transpose, "output_padding", std::vector<int64_t>(spatial_dims, 0));
+  std::vector<int64_t> output_shape = GetIntsAttrOrDefault(conv_transpose, "output_shape", {});
+  std::string auto_pad = GetStringAttrOrDefault(conv_transpose, "auto_pad", "NOTSET");
+  if (output_padding.size() != spatial_dims) {
+    return false;
+  }
+
+  if (output_shape.empty() && auto_pad == "NOTSET") {
+    pads = GetIntsAttrOrDefault(conv_transpose, "pads", std::vector<int64_t>(spatial_dims * 2, 0));
+    return pads.size() == spatial_dims * 2;
+  }
+
+  pads.assign(spatial_dims * 2, 0);
+  if (output_shape.empty() && auto_pad == "VALID") {
+    return true;
+  }
+  if (output_shape.empty() && auto_pad != "SAME_UPPER" && auto_pad != "SAME_LOWER") {
+    return false;
+  }
+  if (output_shape.size() == spatial_dims + 2) {
+    output_shape.erase(output_shape.begin(), output_shape.begin() + 2);  // Given with N and C
+  }
+  if (!output_shape.empty() && output_shape.size() != spatial_dims) {
+    return false;
+  }
+
+  // The full transposed output is cropped by `total` elements to reach the requested size (the explicit
+  // output_shape, or input * stride for SAME). An odd total is split the way ONNX Runtime's own
+  // ConvTranspose does it: the extra element is cropped from the beginning for SAME_UPPER and from the
+  // end otherwise.
+  for (size_t i = 0; i < spatial_dims; ++i) {
+    int64_t input = x_shape[i + 2];
+    int64_t kernel = (w_shape[i + 2] - 1) * dilations[i] + 1;
+    int64_t output = output_shape.empty() ? input * strides[i] : output_shape[i];
+    int64_t total = strides[i] * (input - 1) + output_padding[i] + kernel - output;
+    if (total < 0) {
+      return false;
+    }
+    int64_t small_half = total / 2;
+    pads[i] = auto_pad == "SAME_UPPER" ? total - small_half : small_half;
+    pads[i + spatial_dims] = total - pads[i];
+  }
+  return true;
+}
+
+ConvFusion MatchConvFusion(Ort::ConstNode conv) {
+  ConvFusion fusion;
+  fusion.conv = conv;
+
+  Ort::ConstValueInfo output = conv.GetOutputs()[0];
+  ONNXTensorElementDataType dtype = GetTensorElementType(output);
+  auto y_shape = GetTensorShape(output);
+  if (!y_shape.has_value() || y_shape->size() < 2) {
+    return fusion;
+  }
+
+  Ort::ConstNode next = GetSoleConsumer(output);
+  if (!next) {
+    return fusion;
+  }
+
+  if (IsFoldableBatchNorm(next, conv, (*y_shape)[1])) {
+    fusion.batch_norm = next;
+    output = next.GetOutputs()[0];
+    next = GetSoleConsumer(output);
+    if (!next) {
+      return fusion;
+    }
+  }
+
+  // A Conv that already has a bias input keeps any following Add unfused, unless its bias is folded anyway
+  Ort::ConstValueInfo bias{nullptr};
+  if ((fusion.batch_norm || conv.GetInputs().size() < 3) && IsPerChannelBiasAdd(next, output, (*y_shape)[1], bias)) {
+    fusion.bias_add = next;
+    output = next.GetOutputs()[0];
+    next = GetSoleConsumer(output);
+    if (!next) {
+      return fusion;
+    }
+  }
+
+  if (IsFusableActivation(next, output, dtype)) {
+    fusion.activation = next;
+  }
+
+  return fusion;
+}
+
+std::unique_ptr<ConvOpInfo> CreateConvOpInfo(const ConvFusion& fusion, bool own_constant_weights) {
+  Ort::ConstNode conv = fusion.conv;
+  std::vector<Ort::ConstValueInfo> inputs = conv.GetInputs();
+  std::vector<Ort::ConstValueInfo> outputs = conv.GetOutputs();
+  HIPDNN_EP_ENFORCE(inputs.size() >= 2 && outputs.size() == 1,
+                    "Conv node " << conv.GetName() << " has unexpected arity");
+
+  auto info = std::make_unique<ConvOpInfo>();
+  info->op_type = conv.GetOperatorType();
+  info->transposed = info->op_type == "ConvTranspose";
+  info->node_name = conv.GetName();
+  info->inputs = {inputs[0].GetName(), inputs[1].GetName()};
+
+  auto x_shape = GetTensorShape(inputs[0]);
+  auto w_shape = GetTensorShape(inputs[1]);
+  auto y_shape = GetTensorShape(outputs[0]);
+  HIPDNN_EP_ENFORCE(x_shape.has_value() && w_shape.has_value() && y_shape.has_value(),
+                    "Conv node " << conv.GetName() << " must have static shapes");
+  info->x_shape = *x_shape;
+  info->w_shape = *w_shape;
+  info->y_shape = *y_shape;
+  info->dtype = GetTensorElementType(inputs[0]);
+
+  size_t spatial_dims = info->x_shape.size() - 2;
+  info->strides = GetIntsAttrOrDefault(conv, "strides", std::vector<int64_t>(spatial_dims, 1));
+  info->dilations = GetIntsAttrOrDefault(conv, "dilations", std::vector<int64_t>(spatial_dims, 1));
+  info->group = GetIntAttrOrDefault(conv, "group", 1);
+  if (!info->transposed) {
+    HIPDNN_EP_ENFORCE(ResolveConvPads(conv, info->x_shape, info->w_shape, info->pads),
+                      "Conv node " << conv.GetName() << " has an unsupported auto_pad");
+    info->output_padding.assign(spatial_dims, 0);
+  } else {
+    HIPDNN_EP_ENFORCE(ResolveConvTransposePads(conv, info->x_shape, info->w_shape, info->pads, info->output_padding),
+                      "ConvTranspose node " << conv.GetName() << " has unsupported padding");
+    // MIOpen crops both ends equally and appends output padding at the end, so cropping less at the
+    // end is the same as cropping the begin amount and padding the difference back
+    for (size_t i = 0; i < spatial_dims; ++i) {
+      int64_t& end = info->pads[i + spatial_dims];
+      info->output_padding[i] += info->pads[i] - end;
+      end = info->pads[i];
+    }
+  }
+
+  Ort::ConstValueInfo output = outputs[0];
+  Ort::ConstValueInfo bias{nullptr};
+  if (fusion.batch_norm) {
+    FoldBatchNorm(fusion, *info);
+    output = fusion.bias_add ? fusion.bias_add.GetOutputs()[0] : fusion.batch_norm.GetOutputs()[0];
+  } else if (inputs.size() >= 3 && inputs[2]) {
+    bias = inputs[2];
+  } else if (fusion.bias_add) {
+    std::vector<Ort::ConstValueInfo> add_inputs = fusion.bias_add.GetInputs();
+    bias = add_inputs[0].GetName() == output.GetName() ? add_inputs[1] : add_inputs[0];
+    output = fusion.bias_add.GetOutputs()[0];
+  }
+  if (bias) {
+    info->has_bias = true;
+    info->inputs.push_back(bias.GetName());
+  }
+
+  if (own_constant_weights && !info->HasConstantWeights()) {
+    TakeConstantWeights(inputs[1], bias, *info);
+  }
+
+  if (fusion.activation) {
+    HIPDNN_EP_ENFORCE(ParseActivation(fusion.activation, info->activation),
+                      "Unsupported activation " << fusion.activation.GetOperatorType());
+    output = fusion.activation.GetOutputs()[0];
+  }
+
+  info->outputs = {output.GetName()};
+  return info;
+}
+
+std::unique_ptr<PoolOpInfo> CreatePoolOpInfo(Ort::ConstNode pool) {
+  std::vector<Ort::ConstValueInfo> inputs = pool.GetInputs();
+  std::vector<Ort::ConstValueInfo> outputs = pool.GetOutputs();
+  HIPDNN_EP_ENFORCE(inputs.size() == 1 && !outputs.empty(),
+                    pool.GetOperatorType() << " node " << pool.GetName() << " has unexpected arity");
+
+  auto info = std::make_unique<PoolOpInfo>();
+  info->op_type = pool.GetOperatorType();
+  info->node_name = pool.GetName();
+  info->inputs = {inputs[0].GetName()};
+  info->outputs = {outputs[0].GetName()};
+  info->dtype = GetTensorElementType(inputs[0]);
+
+  auto x_shape = GetTensorShape(inputs[0]);
+  auto y_shape = GetTensorShape(outputs[0]);
+  HIPDNN_EP_ENFORCE(x_shape.has_value() && y_shape.has_value() && x_shape->size() >= 3,
+                    info->op_type << " node " << pool.GetName() << " must have static shapes");
+  info->x_shape = *x_shape;
+  info->y_shape = *y_shape;
+
+  size_t spatial_dims = info->x_shape.size() - 2;
+  if (info->op_type == "GlobalMaxPool" || info->op_type == "GlobalAveragePool") {
+    // One window covering every spatial dim
+    info->mode = info->op_type == "GlobalMaxPool" ? PoolOpInfo::Mode::kMax : PoolOpInfo::Mode::kAverage;
+    info->kernel_shape.assign(info->x_shape.begin() + 2, info->x_shape.end());
+    info->pads.assign(spatial_dims * 2, 0);
+    info->strides.assign(spatial_dims, 1);
+    return info;
+  }
+
+  if (info->op_type == "MaxPool") {
+    info->mode = PoolOpInfo::Mode::kMax;
+  } else {
+    info->mode = GetIntAttrOrDefault(pool, "count_include_pad", 0) != 0 ? PoolOpInfo::Mode::kAverageIncludePad
+                                                                         : PoolOpInfo::Mode::kAverage;
+  }
+  info->kernel_shape = GetIntsAttrOrDefault(pool, "kernel_shape", {});
+  info->strides = GetIntsAttrOrDefault(pool, "strides", std::vector<int64_t>(spatial_dims, 1));
+  HIPDNN_EP_ENFORCE(ResolvePoolPads(pool, info->x_shape, info->pads),
+                    info->op_type << " node " << pool.GetName() << " has unsupported padding");
+  return info;
+}
+
+std::unique_ptr<PointwiseOpInfo> CreatePointwiseOpInfo(Ort::ConstNode node) {
+  auto info = std::make_unique<PointwiseOpInfo>();
+  info->op_type = node.GetOperatorType();
+  info->node_name = node.GetName();
+
+  size_t arity = 0;
+  HIPDNN_EP_ENFORCE(LookupPointwiseOp(info->op_type, info->func, arity) &&
+                        ParsePointwiseOp(node, info->func, info->alpha, info->beta),
+                    info->op_type << " node " << node.GetName() << " has non-constant parameters");
+
+  std::vector<Ort::ConstValueInfo> inputs = node.GetInputs();
+  std::vector<Ort::ConstValueInfo> outputs = node.GetOutputs();
+  HIPDNN_EP_ENFORCE(inputs.size() >= arity && outputs.size() == 1,
+                    info->op_type << " node " << node.GetName() << " has unexpected arity");
+
+  auto a_shape = GetTensorShape(inputs[0]);
+  auto y_shape = GetTensorShape(outputs[0]);
+  HIPDNN_EP_ENFORCE(a_shape.has_value() && y_shape.has_value(),
+                    info->op_type << " node " << node.GetName() << " must have static shapes");
+  info->a_shape = *a_shape;
+  info->y_shape = *y_shape;
+  info->inputs = {inputs[0].GetName()};
+  if (arity == 2) {
+    auto b_shape = GetTensorShape(inputs[1]);
+    HIPDNN_EP_ENFORCE(b_shape.has_value(), info->op_type << " node " << node.GetName() << " must have static shapes");
+    info->b_shape = *b_shape;
+    info->inputs.push_back(inputs[1].GetName());
+  }
+  info->outputs = {outputs[0].GetName()};
+  info->dtype = GetTensorElementType(outputs[0]);
+  return info;
+}
+
+std::vector<Ort::ConstNode> MatMulFusion::Nodes() const {
+  std::vector<Ort::ConstNode> nodes{matmul};
+  if (bias_add) {
+    nodes.push_back(bias_add);
+  }
+  if (activation) {
+    nodes.push_back(activation);
+  }
+  return nodes;
+}
+
+bool ResolveMatMulShape(const std::vector<int64_t>& a_shape, const std::vector<int64_t>& b_shape,
+                        MatMulShape& shape) {
+  if (a_shape.empty() || b_shape.empty()) {
+    return false;
+  }
+  for (int64_t dim : a_shape) {
+    if (dim < 1) {
+      return false;
+    }
+  }
+  for (int64_t dim : b_shape) {
+    if (dim < 1) {
+      return false;
+    }
+  }
+
+  // A 1-D A is a [1, K] row and a 1-D B a [K, 1] column; the extra dim is dropped from the output
+  std::vector<int64_t> a = a_shape;
+  std::vector<int64_t> b = b_shape;
+  if (a.size() == 1) {
+    a.insert(a.begin(), 1);
+  }
+  if (b.size() == 1) {
+    b.push_back(1);
+  }
+
+  shape.m = a[a.size() - 2];
+  shape.k = a[a.size() - 1];
+  shape.n = b[b.size() - 1];
+  if (b[b.size() - 2] != shape.k) {
+    return false;
+  }
+
+  // Broadcast the batch dims, right-aligned
+  std::vector<int64_t> a_batch(a.begin(), a.end() - 2);
+  std::vector<int64_t> b_batch(b.begin(), b.end() - 2);
+  size_t batch_rank = std::max(a_batch.size(), b_batch.size());
+  a_batch.insert(a_batch.begin(), batch_rank - a_batch.size(), 1);
+  b_batch.insert(b_batch.begin(), batch_rank - b_batch.size(), 1);
+
+  int64_t a_count = 1;
+  int64_t b_count = 1;
+  int64_t batch_count = 1;
+  for (size_t i = 0; i < batch_rank; ++i) {
+    if (a_batch[i] != b_batch[i] && a_batch[i] != 1 && b_batch[i] != 1) {
+      return false;
+    }
+    a_count *= a_batch[i];
+    b_count *= b_batch[i];
+    batch_count *= std::max(a_batch[i], b_batch[i]);
+  }
+
+  // A strided batch can only repeat a whole operand (stride 0), not broadcast some of its batch dims
+  shape.a_batched = a_count > 1;
+  shape.b_batched = b_count > 1;
+  if ((shape.a_batched && a_count != batch_count) || (shape.b_batched && b_count != batch_count)) {
+    return false;
+  }
+
+  // The rows of every A batch are contiguous, so against a shared B they form one taller A
+  if (shape.a_batched && !shape.b_batched) {
+    shape.m *= batch_count;
+    shape.batch_count = 1;
+    shape.a_batched = false;
+  } else {
+    shape.batch_count = batch_count;
+  }
+  return true;
+}
+
+bool ResolveGemmShape(Ort::ConstNode gemm, MatMulShape& shape, MatMulOpInfo::Addend& addend) {
+  std::vector<Ort::ConstValueInfo> inputs = gemm.GetInputs();
+  if (inputs.size() < 2) {
+    return false;
+  }
+
+  auto a_shape = GetTensorShape(inputs[0]);
+  auto b_shape = GetTensorShape(inputs[1]);
+  if (!a_shape.has_value() || !b_shape.has_value() || a_shape->size() != 2 || b_shape->size() != 2) {
+    return false;
+  }
+
+  bool trans_a = GetIntAttrOrDefault(gemm, "transA", 0) != 0;
+  bool trans_b = GetIntAttrOrDefault(gemm, "transB", 0) != 0;
+  shape = MatMulShape{};
+  shape.m = trans_a ? (*a_shape)[1] : (*a_shape)[0];
+  shape.k = trans_a ? (*a_shape)[0] : (*a_shape)[1];
+  shape.n = trans_b ? (*b_shape)[0] : (*b_shape)[1];
+  if ((trans_b ? (*b_shape)[1] : (*b_shape)[0]) != shape.k || shape.m < 1 || shape.n < 1 || shape.k < 1) {
+    return false;
+  }
+
+  addend = MatMulOpInfo::Addend::kNone;
+  float beta = GetFloatAttrOrDefault(gemm, "beta", 1.0f);
+  if (inputs.size() < 3 || !inputs[2] || beta == 0.0f) {
+    return true;
+  }
+
+  auto c_shape = GetTensorShape(inputs[2]);
+  if (!c_shape.has_value()) {
+    return false;
+  }
+  const std::vector<int64_t>& c = *c_shape;
+  if (c.size() == 2 && c[0] == shape.m && c[1] == shape.n) {
+    addend = MatMulOpInfo::Addend::kMatrix;
+  } else if (beta == 1.0f && ((c.size() == 1 && c[0] == shape.n) ||
+                              (c.size() == 2 && c[0] == 1 && c[1] == shape.n))) {
+    addend = MatMulOpInfo::Addend::kBias;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+MatMulFusion MatchMatMulFusion(Ort::ConstNode matmul) {
+  MatMulFusion fusion;
+  fusion.matmul = matmul;
+
+  Ort::ConstValueInfo output = matmul.GetOutputs()[0];
+  ONNXTensorElementDataType dtype = GetTensorElementType(output);
+
+  Ort::ConstNode next = GetSoleConsumer(output);
+  if (!next) {
+    return fusion;
+  }
+
+  // A Gemm that already has a C input keeps any following Add unfused
+  std::vector<Ort::ConstValueInfo> inputs = matmul.GetInputs();
+  bool has_c = inputs.size() >= 3 && inputs[2];
+  Ort::ConstValueInfo bias{nullptr};
+  if (!has_c && IsRowBiasAdd(next, output, bias)) {
+    fusion.bias_add = next;
+    output = next.GetOutputs()[0];
+    next = GetSoleConsumer(output);
+    if (!next) {
+      return fusion;
+    }
+  }
+
+  if (IsFusableActivation(next, output, dtype)) {
+    fusion.activation = next;
+  }
+
+  return fusion;
+}
+
+std::unique_ptr<MatMulOpInfo> CreateMatMulOpInfo(const MatMulFusion& fusion) {
+  Ort::ConstNode matmul = fusion.matmul;
+  std::vector<Ort::ConstValueInfo> inputs = matmul.GetInputs();
+  std::vector<Ort::ConstValueInfo> outputs = matmul.GetOutputs();
+  HIPDNN_EP_ENFORCE(inputs.size() >= 2 && outputs.size() == 1,
+                    matmul.GetOperatorType() << " node " << matmul.GetName() << " has unexpected arity");
+
+  auto info = std::make_unique<MatMulOpInfo>();
+  info->op_type = matmul.GetOperatorType();
+  info->node_name = matmul.GetName();
+  info->inputs = {inputs[0].GetName(), inputs[1].GetName()};
+  info->dtype = GetTensorElementType(inputs[0]);
+
+  auto y_shape = GetTensorShape(outputs[0]);
+  HIPDNN_EP_ENFORCE(y_shape.has_value(), info->op_type << " node " << matmul.GetName() << " must have static shapes");
+  info->y_shape = *y_shape;
+
+  MatMulShape shape;
+  if (info->op_type == "Gemm") {
+    HIPDNN_EP_ENFORCE(ResolveGemmShape(matmul, shape, info->addend),
+                      "Gemm node " << matmul.GetName() << " has unsupported shapes");
+    info->trans_a = GetIntAttrOrDefault(matmul, "transA", 0) != 0;
+    info->trans_b = GetIntAttrOrDefault(matmul, "transB", 0) != 0;
+    info->alpha = GetFloatAttrOrDefault(matmul, "alpha", 1.0f);
+    if (info->addend != MatMulOpInfo::Addend::kNone) {
+      info->beta = GetFloatAttrOrDefault(matmul, "beta", 1.0f);
+      info->inputs.push_back(inputs[2].GetName());
+    }
+  } else {
+    auto a_shape = GetTensorShape(inputs[0]);
+    auto b_shape = GetTensorShape(inputs[1]);
+    HIPDNN_EP_ENFORCE(a_shape.has_value() && b_shape.has_value() && ResolveMatMulShape(*a_shape, *b_shape, shape),
+                      "MatMul node " << matmul.GetName() << " has unsupported shapes");
+  }
+  info->m = shape.m;
+  info->n = shape.n;
+  info->k = shape.k;
+  info->batch_count = shape.batch_count;
+  info->a_batched = shape.a_batched;
+  info->b_batched = shape.b_batched;
+
+  Ort::ConstValueInfo output = outputs[0];
+  if (fusion.bias_add) {
+    std::vector<Ort::ConstValueInfo> add_inputs = fusion.bias_add.GetInputs();
+    Ort::ConstValueInfo bias = add_inputs[0].GetName() == output.GetName() ? add_inputs[1] : add_inputs[0];
+    info->addend = MatMulOpInfo::Addend::kBias;
+    info->inputs.push_back(bias.GetName());
+    output = fusion.bias_add.GetOutputs()[0];
+  }
+
+  if (fusion.activation) {
+    HIPDNN_EP_ENFORCE(ParseActivation(fusion.activation, info->activation),
+                      "Unsupported activation " << fusion.activation.GetOperatorType());
+    output = fusion.activation.GetOutputs()[0];
+  }
+
+  info->outputs = {output.GetName()};
+  return info;
+}
+
+void OpInfo::Serialize(ContextWriter& writer) const {
+  writer.Write(node_name);
+  writer.Write(static_cast<uint64_t>(inputs.size()));
+  for (const auto& name : inputs) {
+    writer.Write(name);
+  }
+  writer.Write(static_cast<uint64_t>(outputs.size()));
+  for (const auto& name : outputs) {
+    writer.Write(name);
+  }
+}
+
+bool OpInfo::Deserialize(ContextReader& reader) {
+  uint64_t num_inputs = 0;
+  uint64_t num_outputs = 0;
+  if (!reader.Read(node_name) || !reader.Read(num_inputs)) {
+    return false;
+  }
+  inputs.resize(num_inputs);
+  for (auto& name : inputs) {
+    if (!reader.Read(name)) {
+      return false;
+    }
+  }
+  if (!reader.Read(num_outputs)) {
+    return false;
+  }
+  outputs.resize(num_outputs);
+  for (auto& name : outputs) {
+    if (!reader.Read(name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ConvOpInfo::Serialize(ContextWriter& writer) const {
+  OpInfo::Serialize(writer);
+  writer.Write(static_cast<int64_t>(transposed));
+  writer.Write(pads).Write(strides).Write(dilations).Write(output_padding).Write(group);
+  writer.Write(x_shape).Write(w_shape).Write(y_shape).Write(static_cast<int64_t>(dtype));
+  writer.Write(static_cast<int64_t>(has_bias));
+  writer.Write(static_cast<int64_t>(activation.kind)).Write(activation.alpha).Write(activation.beta);
+  writer.Write(constant_weights).Write(constant_bias);
+}
+
+bool ConvOpInfo::Deserialize(ContextReader& reader) {
+  int64_t transposed_value = 0;
+  int64_t dtype_value = 0;
+  int64_t has_bias_value = 0;
+  int64_t activation_kind = 0;
+  bool ok = OpInfo::Deserialize(reader) &&
+            reader.Read(transposed_value) && reader.Read(pads) && reader.Read(strides) &&
+            reader.Read(dilations) && reader.Read(output_padding) && reader.Read(group) &&
+            reader.Read(x_shape) && reader.Read(w_shape) && reader.Read(y_shape) && reader.Read(dtype_value) &&
+            reader.Read(has_bias_value) &&
+            reader.Read(activation_kind) && reader.Read(activation.alpha) && reader.Read(activation.beta) &&
+            reader.Read(constant_weights) && reader.Read(constant_bias);
+  if (!ok || activation_kind < 0 || activation_kind > static_cast<int64_t>(Activation::Kind::kClip)) {
+    return false;
+  }
+
+  transposed = transposed_value != 0;
+  op_type = transposed ? "ConvTranspose" : "Conv";
+  dtype = static_cast<ONNXTensorElementDataType>(dtype_value);
+  has_bias = has_bias_value != 0;
+  activation.kind = static_cast<Activation::Kind>(activation_kind);
+  return true;
+}
+
+void PoolOpInfo::Serialize(ContextWriter& writer) const {
+  OpInfo::Serialize(writer);
+  writer.Write(static_cast<int64_t>(mode)).Write(kernel_shape).Write(pads).Write(strides);
+  writer.Write(x_shape).Write(y_shape).Write(static_cast<int64_t>(dtype));
+}
+
+bool PoolOpInfo::Deserialize(ContextReader& reader) {
+  int64_t mode_value = 0;
+  int64_t dtype_value = 0;
+  bool ok = OpInfo::Deserialize(reader) &&
+            reader.Read(mode_value) && reader.Read(kernel_shape) && reader.Read(pads) && reader.Read(strides) &&
+            reader.Read(x_shape) && reader.Read(y_shape) && reader.Read(dtype_value);
+  if (!ok || mode_value < 0 || mode_value > static_cast<int64_t>(Mode::kAverageIncludePad)) {
+    return false;
+  }
+
+  mode = static_cast<Mode>(mode_value);
+  dtype = static_cast<ONNXTensorElementDataType>(dtype_value);
+  return true;
+}
+
+void PointwiseOpInfo::Serialize(ContextWriter& writer) const {
+  OpInfo::Serialize(writer);
+  writer.Write(static_cast<int64_t>(func)).Write(alpha).Write(beta);
+  writer.Write(a_shape).Write(b_shape).Write(y_shape).Write(static_cast<int64_t>(dtype));
+}
+
+bool PointwiseOpInfo::Deserialize(ContextReader& reader) {
+  int64_t func_value = 0;
+  int64_t dtype_value = 0;
+  bool ok = OpInfo::Deserialize(reader) &&
+            reader.Read(func_value) && reader.Read(alpha) && reader.Read(beta) &&
+            reader.Read(a_shape) && reader.Read(b_shape) && reader.Read(y_shape) && reader.Read(dtype_value);
+  if (!ok || func_value < 0 || func_value >= static_cast<int64_t>(PointwiseFunc::kCount)) {
+    return false;
+  }
+
+  func = static_cast<PointwiseFunc>(func_value);
+  dtype = static_cast<ONNXTensorElementDataType>(dtype_value);
+  return true;
+}
+
+void MatMulOpInfo::Serialize(ContextWriter& writer) const {
+  OpInfo::Serialize(writer);
+  writer.Write(m).Write(n).Write(k).Write(batch_count);
+  writer.Write(static_cast<int64_t>(a_batched)).Write(static_cast<int64_t>(b_batched));
+  writer.Write(static_cast<int64_t>(trans_a)).Write(static_cast<int64_t>(trans_b));
+  writer.Write(alpha).Write(beta).Write(static_cast<int64_t>(addend));
+  writer.Write(y_shape).Write(static_cast<int64_t>(dtype));
+  writer.Write(static_cast<int64_t>(activation.kind)).Write(activation.alpha).Write(activation.beta);
+}
+
+bool MatMulOpInfo::Deserialize(ContextReader& reader) {
+  int64_t a_batched_value = 0;
+  int64_t b_batched_value = 0;
+  int64_t trans_a_value = 0;
+  int64_t trans_b_value = 0;
+  int64_t addend_value = 0;
+  int64_t dtype_value = 0;
+  int64_t activation_kind = 0;
+  bool ok = OpInfo::Deserialize(reader) &&
+            reader.Read(m) && reader.Read(n) && reader.Read(k) && reader.Read(batch_count) &&
+            reader.Read(a_batched_value) && reader.Read(b_batched_value) &&
+            reader.Read(trans_a_value) && reader.Read(trans_b_value) &&
+            reader.Read(alpha) && reader.Read(beta) && reader.Read(addend_value) &&
+            reader.Read(y_shape) && reader.Read(dtype_value) &&
+            reader.Read(activation_kind) && reader.Read(activation.alpha) && reader.Read(activation.beta);
+  if (!ok || addend_value < 0 || addend_value > static_cast<int64_t>(Addend::kMatrix) ||
+      activation_kind < 0 || activation_kind > static_cast<int64_t>(Activation::Kind::kClip)) {
+    return false;
+  }
+
+  a_batched = a_batched_value != 0;
+  b_batched = b_batched_value != 0;
+  trans_a = trans_a_value != 0;
+  trans_b = trans_b_value != 0;
+  addend = static_cast<Addend>(addend_value);
+  dtype = static_cast<ONNXTensorElementDataType>(dtype_value);
+  activation.kind = static_cast<Activation::Kind>(activation_kind);
+  return true;
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,117 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/pinned_buffer_pool.h"
+
+#include <algorithm>
+
+namespace hipdnn_ep {
+
+namespace {
+
+void FreeBuffer(PinnedBufferPool::Buffer& buffer) {
+  if (buffer.event != nullptr) {
+    hipEventSynchronize(buffer.event);
+    hipEventDestroy(buffer.event);
+  }
+  hipHostFree(buffer.ptr);
+}
+
+}  // namespace
+
+bool IsPinnedHostMemory(const void* ptr) {
+  hipPointerAttribute_t attributes{};
+  if (hipPointerGetAttributes(&attributes, ptr) != hipSuccess) {
+    // Unknown (pageable) pointers are reported as an error on some HIP versions
+    hipGetLastError();
+    return false;
+  }
+  return attributes.type == hipMemoryTypeHost;
+}
+
+PinnedBufferPool::~PinnedBufferPool() {
+  for (auto& buffer : free_buffers_) {
+    FreeBuffer(buffer);
+  }
+}
+
+hipError_t PinnedBufferPool::Acquire(size_t size, Buffer& buffer) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Smallest idle buffer that fits and that no stream is still reading or writing
+    auto best = free_buffers_.end();
+    for (auto it = free_buffers_.begin(); it != free_buffers_.end(); ++it) {
+      if (it->size >= size && (best == free_buffers_.end() || it->size < best->size) &&
+          (it->event == nullptr || hipEventQuery(it->event) == hipSuccess)) {
+        best = it;
+      }
+    }
+
+    if (best != free_buffers_.end()) {
+      buffer = *best;
+      free_buffers_.erase(best);
+      return hipSuccess;
+    }
+  }
+
+  Buffer new_buffer;
+  new_buffer.size = (std::max<size_t>(size, 1) + kGranularity - 1) / kGranularity * kGranularity;
+  hipError_t err = hipHostMalloc(&new_buffer.ptr, new_buffer.size, hipHostMallocDefault);
+  if (err != hipSuccess) {
+    return err;
+  }
+
+  err = hipEventCreateWithFlags(&new_buffer.event, hipEventDisableTiming);
+  if (err != hipSuccess) {
+    hipHostFree(new_buffer.ptr);
+    return err;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    allocated_bytes_ += new_buffer.size;
+  }
+
+  buffer = new_buffer;
+  return hipSuccess;
+}
+
+hipError_t PinnedBufferPool::Release(Buffer buffer, hipStream_t stream) {
+  hipError_t err = hipEventRecord(buffer.event, stream);
+  if (err != hipSuccess) {
+    // Without a recorded event reuse can't be proven safe; drop the buffer once the stream drains
+    hipStreamSynchronize(stream);
+    FreeBuffer(buffer);
+    std::lock_guard<std::mutex> lock(mutex_);
+    allocated_bytes_ -= buffer.size;
+    return err;
+  }
+
+  // Trim the cache, oldest buffers first, when a burst of large copies grew it. The trimmed buffers are
+  // freed after unlocking, since freeing waits for their last use on the GPU.
+  std::vector<Buffer> trimmed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_buffers_.push_back(buffer);
+    size_t num_trimmed = 0;
+    while (allocated_bytes_ > kMaxCachedBytes && free_buffers_.size() - num_trimmed > 1) {
+      allocated_bytes_ -= free_buffers_[num_trimmed].size;
+      ++num_trimmed;
+    }
+    trimmed.assign(free_buffers_.begin(), free_buffers_.begin() + num_trimmed);
+    free_buffers_.erase(free_buffers_.begin(), free_buffers_.begin() + num_trimmed);
+  }
+
+  for (auto& old_buffer : trimmed) {
+    FreeBuffer(old_buffer);
+  }
+  return hipSuccess;
+}
+
+size_t PinnedBufferPool::AllocatedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocated_bytes_;
+}
+
+}  // namespace hipdnn_ep
@@ -0,0 +1,35 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/pointwise_op.h"
+#include "hipdnn_ep/miopen_utils.h"
+
+namespace hipdnn_ep {
+
+PointwiseOp::PointwiseOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<PointwiseOpInfo> info)
+    : Op(std::move(info)), ort_api_(ort_api), logger_(logger) {
+}
+
+OrtStatus* PointwiseOp::Compile() {
+  const PointwiseOpInfo& info = PointwiseInfo();
+  if (!ResolvePointwiseParams(info, params_)) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Unsupported broadcast of the inputs to the output shape, node: "
+                                            << info.node_name);
+  }
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << ": " << params_.count << " elements, broadcast rank "
+                   << params_.rank);
+
+  return nullptr;
+}
+
+OrtStatus* PointwiseOp::Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                                const std::vector<void*>& outputs) const {
+  const bool fp16 = PointwiseInfo().dtype == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+  const void* b = inputs.size() > 1 ? inputs[1] : nullptr;
+  HIP_RETURN_IF_ERROR(ort_api_, LaunchPointwise(params_, fp16, inputs[0], b, outputs[0], ctx.stream));
+  return nullptr;
+}
+
+}  // namespace hipdnn_ep
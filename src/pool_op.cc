@@ -0,0 +1,92 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/pool_op.h"
+#include "hipdnn_ep/miopen_utils.h"
+
+namespace hipdnn_ep {
+
+PoolOp::PoolOp(const OrtApi& ort_api, const OrtLogger& logger, std::unique_ptr<PoolOpInfo> info)
+    : Op(std::move(info)), ort_api_(ort_api), logger_(logger) {
+}
+
+PoolOp::~PoolOp() {
+  if (x_desc_) miopenDestroyTensorDescriptor(x_desc_);
+  if (y_desc_) miopenDestroyTensorDescriptor(y_desc_);
+  if (pool_desc_) miopenDestroyPoolingDescriptor(pool_desc_);
+}
+
+OrtStatus* PoolOp::Compile() {
+  const PoolOpInfo& info = PoolInfo();
+
+  const size_t rank = info.x_shape.size();
+  if (rank < 3 || rank > 5 || info.y_shape.size() != rank || info.kernel_shape.size() != rank - 2) {
+    RETURN_ERROR(ort_api_, ORT_EP_FAIL, "Only 1D, 2D and 3D pooling are supported, node: " << info.node_name);
+  }
+
+  LOG(ort_api_, logger_, VERBOSE,
+      info.op_type << " " << info.node_name << ": mode " << static_cast<int>(info.mode) << ", kernel rank "
+                   << info.kernel_shape.size());
+
+  std::vector<int64_t> x_shape = info.x_shape;
+  std::vector<int64_t> y_shape = info.y_shape;
+  std::vector<int64_t> kernel = info.kernel_shape;
+  std::vector<int64_t> pads(info.pads.begin(), info.pads.begin() + (rank - 2));
+  std::vector<int64_t> strides = info.strides;
+  if (rank == 3) {
+    // MIOpen has no 1D pooling: run it as 2D over an [N, C, 1, W] view of the same memory
+    x_shape.insert(x_shape.begin() + 2, 1);
+    y_shape.insert(y_shape.begin() + 2, 1);
+    kernel.insert(kernel.begin(), 1);
+    pads.insert(pads.begin(), 0);
+    strides.insert(strides.begin(), 1);
+  }
+
+  miopenDataType_t data_type = ToMIOpenDataType(info.dtype);
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&x_desc_));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreateTensorDescriptor(&y_desc_));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, SetPackedTensorDescriptor(x_desc_, data_type, x_shape));
+  // The output is described with the node's shape rather than MIOpen's floor-mode size, so ceil_mode
+  // outputs get their extra (partial) window
+  MIOPEN_RETURN_IF_ERROR(ort_api_, SetPackedTensorDescriptor(y_desc_, data_type, y_shape));
+
+  // MIOpen pads both ends equally, so only the begin pads are used. Its average modes clip each window
+  // to the padded input, and the exclusive one further to the input itself, as ONNX does.
+  miopenPoolingMode_t mode = miopenPoolingMax;
+  if (info.mode == PoolOpInfo::Mode::kAverage) {
+    mode = miopenPoolingAverage;
+  } else if (info.mode == PoolOpInfo::Mode::kAverageIncludePad) {
+    mode = miopenPoolingAverageInclusive;
+  }
+  std::vector<int> window(kernel.begin(), kernel.end());
+  std::vector<int> pool_pads(pads.begin(), pads.end());
+  std::vector<int> pool_strides(strides.begin(), strides.end());
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenCreatePoolingDescriptor(&pool_desc_));
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenSetNdPoolingDescriptor(
+      pool_desc_, mode, static_cast<int>(window.size()), window.data(), pool_pads.data(), pool_strides.data()));
+
+  return nullptr;
+}
+
+OrtStatus* PoolOp::Execute(const ExecutionContext& ctx, const std::vector<const void*>& inputs,
+                           const std::vector<void*>& outputs) const {
+  // Inference only: no max indices are kept for a backward pass, so no workspace is needed
+  float alpha = 1.0f;
+  float beta = 0.0f;
+  MIOPEN_RETURN_IF_ERROR(ort_api_, miopenPoolingForward(
+      ctx.miopen_handle,
+      pool_desc_,
+      &alpha,
+      x_desc_,
+      inputs[0],
+      &beta,
+      y_desc_,
+      outputs[0],
+      false,  // do_backward
+      nullptr,
+      0));
+
+  return nullptr;
+}
+
+}  // namespace hipdnn_ep
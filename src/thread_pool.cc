@@ -0,0 +1,126 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/thread_pool.h"
+
+#include <algorithm>
+
+namespace hipdnn_ep {
+
+namespace {
+
+// Chunks per thread: enough for threads that finish early to pick up the slack of slower ones
+constexpr int64_t kChunksPerThread = 4;
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) {
+    workers_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::ParallelFor(int64_t n, int64_t grain, const std::function<void(int64_t, int64_t)>& fn) {
+  if (n <= 0) {
+    return;
+  }
+
+  grain = std::max<int64_t>(grain, 1);
+  const int64_t max_chunks = static_cast<int64_t>(NumThreads()) * kChunksPerThread;
+  const int64_t num_chunks = std::min((n + grain - 1) / grain, max_chunks);
+  if (num_chunks <= 1 || workers_.empty()) {
+    fn(0, n);
+    return;
+  }
+
+  Job job;
+  job.fn = &fn;
+  job.n = n;
+  job.chunk_size = (n + num_chunks - 1) / num_chunks;
+  job.num_chunks = (n + job.chunk_size - 1) / job.chunk_size;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(&job);
+  }
+  work_cv_.notify_all();
+
+  RunChunks(job);
+
+  // Every chunk is claimed; wait for the workers still running one. Once dequeued no worker can join.
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = std::find(jobs_.begin(), jobs_.end(), &job);
+  if (it != jobs_.end()) {
+    jobs_.erase(it);
+  }
+  done_cv_.wait(lock, [&job]() { return job.active_workers == 0; });
+
+  // Workers store the error before leaving the job under mutex_, so it is visible here
+  if (job.error) {
+    std::rethrow_exception(job.error);
+  }
+}
+
+void ThreadPool::RunChunks(Job& job) {
+  for (;;) {
+    const int64_t chunk = job.next_chunk.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= job.num_chunks) {
+      return;
+    }
+    const int64_t begin = chunk * job.chunk_size;
+    try {
+      (*job.fn)(begin, std::min(begin + job.chunk_size, job.n));
+    } catch (...) {
+      // An exception must not escape a worker thread; hand the first one to ParallelFor's caller and
+      // skip the remaining chunks
+      if (!job.failed.exchange(true)) {
+        job.error = std::current_exception();
+      }
+      job.next_chunk.store(job.num_chunks, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+
+void ThreadPool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    work_cv_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+    if (stop_) {
+      return;
+    }
+
+    Job* job = jobs_.front();
+    ++job->active_workers;
+    lock.unlock();
+
+    RunChunks(*job);
+
+    lock.lock();
+    // The job has no chunks left, so stop offering it to other workers
+    auto it = std::find(jobs_.begin(), jobs_.end(), job);
+    if (it != jobs_.end()) {
+      jobs_.erase(it);
+    }
+    if (--job->active_workers == 0) {
+      done_cv_.notify_all();
+    }
+  }
+}
+
+}  // namespace hipdnn_ep
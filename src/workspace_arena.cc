@@ -0,0 +1,168 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+#include "hipdnn_ep/workspace_arena.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace hipdnn_ep {
+
+//
+// WorkspaceArena::Lease
+//
+
+WorkspaceArena::Lease::~Lease() {
+  Reset();
+}
+
+WorkspaceArena::Lease::Lease(Lease&& other) noexcept
+    : arena_(std::exchange(other.arena_, nullptr)),
+      stream_(std::exchange(other.stream_, nullptr)),
+      ptr_(std::exchange(other.ptr_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+WorkspaceArena::Lease& WorkspaceArena::Lease::operator=(Lease&& other) noexcept {
+  if (this != &other) {
+    Reset();
+    arena_ = std::exchange(other.arena_, nullptr);
+    stream_ = std::exchange(other.stream_, nullptr);
+    ptr_ = std::exchange(other.ptr_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+void WorkspaceArena::Lease::Reset() {
+  if (arena_ != nullptr && ptr_ != nullptr) {
+    arena_->Release(stream_, Buffer{ptr_, size_});
+  }
+  arena_ = nullptr;
+  ptr_ = nullptr;
+  size_ = 0;
+}
+
+//
+// WorkspaceArena
+//
+
+WorkspaceArena::~WorkspaceArena() {
+  for (RetiredBuffer& retired : retired_buffers_) {
+    hipEventSynchronize(retired.fence);
+    hipEventDestroy(retired.fence);
+    hipFree(retired.buffer.ptr);
+  }
+  for (auto& [stream, buffers] : free_buffers_) {
+    for (const Buffer& buffer : buffers) {
+      hipFree(buffer.ptr);
+    }
+  }
+}
+
+void WorkspaceArena::Reserve(size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  reserved_size_ = std::max(reserved_size_, size);
+}
+
+hipError_t WorkspaceArena::Acquire(hipStream_t stream, size_t size, Lease& lease) {
+  if (size == 0) {
+    lease = Lease();
+    return hipSuccess;
+  }
+
+  Buffer buffer;
+  hipError_t err = AcquireBuffer(stream, size, buffer);
+  if (err != hipSuccess) {
+    return err;
+  }
+
+  // Assigned outside the lock: dropping a previous lease returns its buffer to the arena
+  lease = Lease(this, stream, buffer.ptr, buffer.size);
+  return hipSuccess;
+}
+
+hipError_t WorkspaceArena::AcquireBuffer(hipStream_t stream, size_t size, Buffer& buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FreeCompletedRetired();
+  std::vector<Buffer>& buffers = free_buffers_[stream];
+
+  // Smallest free buffer on this stream that is big enough
+  auto best = buffers.end();
+  for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+    if (it->size >= size && (best == buffers.end() || it->size < best->size)) {
+      best = it;
+    }
+  }
+  if (best != buffers.end()) {
+    buffer = *best;
+    buffers.erase(best);
+    return hipSuccess;
+  }
+
+  if (!buffers.empty()) {
+    // All free buffers are too small: replace the largest instead of growing the arena.
+    // Earlier kernels on this stream may still be using it, so it is freed later.
+    auto largest = std::max_element(buffers.begin(), buffers.end(),
+                                    [](const Buffer& a, const Buffer& b) { return a.size < b.size; });
+    hipError_t err = Retire(stream, *largest);
+    if (err != hipSuccess) {
+      return err;
+    }
+    buffers.erase(largest);
+  }
+
+  size_t new_size = std::max(size, reserved_size_);
+  hipError_t err = hipMalloc(&buffer.ptr, new_size);
+  if (err != hipSuccess) {
+    buffer = Buffer{};
+    return err;
+  }
+  buffer.size = new_size;
+  allocated_bytes_ += new_size;
+  return hipSuccess;
+}
+
+hipError_t WorkspaceArena::Retire(hipStream_t stream, const Buffer& buffer) {
+  // The fence follows all work enqueued on the stream so far, which includes every use of the buffer
+  hipEvent_t fence = nullptr;
+  if (hipEventCreateWithFlags(&fence, hipEventDisableTiming) == hipSuccess) {
+    if (hipEventRecord(fence, stream) == hipSuccess) {
+      retired_buffers_.push_back({buffer, fence});
+      return hipSuccess;
+    }
+    hipEventDestroy(fence);
+  }
+
+  // Without a fence the only way to know the buffer is idle is to drain the stream
+  hipError_t err = hipStreamSynchronize(stream);
+  if (err != hipSuccess) {
+    return err;
+  }
+  hipFree(buffer.ptr);
+  allocated_bytes_ -= buffer.size;
+  return hipSuccess;
+}
+
+void WorkspaceArena::FreeCompletedRetired() {
+  auto completed = std::partition(retired_buffers_.begin(), retired_buffers_.end(), [](const RetiredBuffer& retired) {
+    return hipEventQuery(retired.fence) != hipSuccess;
+  });
+  for (auto it = completed; it != retired_buffers_.end(); ++it) {
+    hipEventDestroy(it->fence);
+    hipFree(it->buffer.ptr);
+    allocated_bytes_ -= it->buffer.size;
+  }
+  retired_buffers_.erase(completed, retired_buffers_.end());
+}
+
+void WorkspaceArena::Release(hipStream_t stream, Buffer buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_buffers_[stream].push_back(buffer);
+}
+
+size_t WorkspaceArena::AllocatedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocated_bytes_;
+}
+
+}  // namespace hipdnn_ep
@@ -2,7 +2,7 @@
 # Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
 # Licensed under the MIT License.
 
-"""Generate a simple Conv ONNX model for testing."""
+"""Generate a simple Conv ONNX model (optionally followed by a bias Add and an activation) for testing."""
 
 import numpy as np
 
@@ -18,6 +18,8 @@ def create_conv_model(
     batch=1,
     in_channels=1,
     out_channels=1,
+    spatial_dims=2,
+    depth=8,
     height=8,
     width=8,
     kernel_h=3,
@@ -26,17 +28,59 @@ def create_conv_model(
     pad_w=1,
     stride_h=1,
     stride_w=1,
+    dilation_h=1,
+    dilation_w=1,
+    auto_pad=None,
+    group=1,
+    transpose=False,
+    output_padding=0,
     use_bias=False,
+    batch_norm=False,
+    bias_add=False,
+    reshaped_add=False,
+    activation=None,
+    num_layers=1,
+    pool=False,
     output_file="conv_test.onnx"
 ):
-    """Create a simple Conv model with optional bias."""
+    """Create a simple Conv model with optional bias.
+
+    bias_add puts the bias in a separate Add of a [1, C, 1, 1] constant instead of the Conv's B input,
+    and activation ('relu', 'leakyrelu', 'sigmoid' or 'clip') appends that node, so the model exercises
+    the EP's Conv + bias + activation fusion. batch_norm puts an inference-mode BatchNormalization with
+    random statistics right after each Conv, which the EP folds into the Conv's weights. num_layers > 1
+    stacks further out_channels -> out_channels layers (weights W1, W2, ...) on top, so the model exercises
+    multi-node partitions. group > 1 makes
+    every layer a grouped convolution (depthwise when group == in_channels == out_channels). auto_pad
+    ('SAME_UPPER', 'SAME_LOWER' or 'VALID') replaces the explicit pads. spatial_dims 1 builds a Conv1d
+    over [N, C, width] using the *_w settings, and 3 a Conv3d over [N, C, depth, height, width] that
+    uses the *_h settings for depth as well. transpose builds ConvTranspose layers instead, with
+    output_padding extra outputs at the end of every spatial dim. pool appends a ceil_mode MaxPool, a
+    padded count_include_pad AveragePool and a GlobalAveragePool after the last layer. reshaped_add adds a
+    flat constant that a Reshape brings to the output shape instead, so a node the EP leaves to ORT feeds
+    the Add from outside the Conv -> Add partition.
+    """
+
+    # Per spatial dim settings
+    if spatial_dims == 1:
+        sizes, kernel, pads, strides, dilations = [width], [kernel_w], [pad_w], [stride_w], [dilation_w]
+    elif spatial_dims == 2:
+        sizes, kernel, pads, strides, dilations = (
+            [height, width], [kernel_h, kernel_w], [pad_h, pad_w], [stride_h, stride_w], [dilation_h, dilation_w])
+    else:
+        sizes, kernel, pads, strides, dilations = (
+            [depth, height, width], [kernel_h, kernel_h, kernel_w], [pad_h, pad_h, pad_w],
+            [stride_h, stride_h, stride_w], [dilation_h, dilation_h, dilation_w])
+    if auto_pad == 'VALID':
+        pads = [0] * spatial_dims
 
     # Input
     X = helper.make_tensor_value_info('X', TensorProto.FLOAT,
-                                       [batch, in_channels, height, width])
+                                       [batch, in_channels] + sizes)
 
     # Weight (as initializer with random values)
-    W_shape = [out_channels, in_channels, kernel_h, kernel_w]
+    # Conv weights are [C_out, C_in / group, k...], ConvTranspose weights [C_in, C_out / group, k...]
+    W_shape = ([in_channels, out_channels // group] if transpose else [out_channels, in_channels // group]) + kernel
     W_data = np.random.randn(*W_shape).astype(np.float32)
     W = helper.make_tensor('W', TensorProto.FLOAT, W_shape, W_data.flatten().tolist())
 
@@ -44,32 +88,122 @@ def create_conv_model(
     B_data = None
     initializers = [W]
     conv_inputs = ['X', 'W']
-    if use_bias:
-        B_shape = [out_channels]
+    if use_bias or bias_add:
+        B_shape = [1, out_channels] + [1] * spatial_dims if bias_add else [out_channels]
         B_data = np.random.randn(*B_shape).astype(np.float32)
         B = helper.make_tensor('B', TensorProto.FLOAT, B_shape, B_data.flatten().tolist())
         initializers.append(B)
-        conv_inputs.append('B')
+        if not bias_add:
+            conv_inputs.append('B')
 
     # Output shape
-    out_h = (height + 2 * pad_h - kernel_h) // stride_h + 1
-    out_w = (width + 2 * pad_w - kernel_w) // stride_w + 1
+    out_sizes = list(sizes)
+    for _ in range(num_layers):
+        for i in range(spatial_dims):
+            eff_kernel = (kernel[i] - 1) * dilations[i] + 1
+            if transpose and auto_pad in ('SAME_UPPER', 'SAME_LOWER'):
+                out_sizes[i] = out_sizes[i] * strides[i]
+            elif transpose:
+                out_sizes[i] = strides[i] * (out_sizes[i] - 1) + output_padding + eff_kernel - 2 * pads[i]
+            elif auto_pad in ('SAME_UPPER', 'SAME_LOWER'):
+                out_sizes[i] = (out_sizes[i] + strides[i] - 1) // strides[i]
+            else:
+                out_sizes[i] = (out_sizes[i] + 2 * pads[i] - eff_kernel) // strides[i] + 1
+    if pool:
+        out_sizes = [1] * spatial_dims  # The pooling tail ends in a GlobalAveragePool
     Y = helper.make_tensor_value_info('Y', TensorProto.FLOAT,
-                                       [batch, out_channels, out_h, out_w])
-
-    # Conv node
-    conv_node = helper.make_node(
-        'Conv',
-        inputs=conv_inputs,
-        outputs=['Y'],
-        kernel_shape=[kernel_h, kernel_w],
-        pads=[pad_h, pad_w, pad_h, pad_w],
-        strides=[stride_h, stride_w],
-    )
+                                       [batch, out_channels] + out_sizes)
+
+    if reshaped_add:
+        assert num_layers == 1 and not (use_bias or bias_add), "reshaped_add is a single layer without bias"
+        B_shape = [batch * out_channels * int(np.prod(out_sizes))]
+        B_data = np.random.randn(*B_shape).astype(np.float32)
+        initializers.append(helper.make_tensor('B', TensorProto.FLOAT, B_shape, B_data.tolist()))
+        initializers.append(helper.make_tensor('B_target_shape', TensorProto.INT64, [2 + spatial_dims],
+                                               [batch, out_channels] + out_sizes))
+
+    # Each layer is a Conv node, followed by the optional epilogue nodes
+    epilogue = []
+    if batch_norm:
+        epilogue.append(('BatchNormalization', [], {'epsilon': 1e-5}))
+    if bias_add or reshaped_add:
+        epilogue.append(('Add', ['B'], {}))
+    if activation == 'relu':
+        epilogue.append(('Relu', [], {}))
+    elif activation == 'leakyrelu':
+        epilogue.append(('LeakyRelu', [], {'alpha': 0.1}))
+    elif activation == 'sigmoid':
+        epilogue.append(('Sigmoid', [], {}))
+    elif activation == 'clip':
+        # Relu6, with min/max as constant inputs (opset 11+)
+        initializers.append(helper.make_tensor('clip_min', TensorProto.FLOAT, [], [0.0]))
+        initializers.append(helper.make_tensor('clip_max', TensorProto.FLOAT, [], [6.0]))
+        epilogue.append(('Clip', ['clip_min', 'clip_max'], {}))
+
+    nodes = []
+    for layer in range(num_layers):
+        suffix = str(layer) if layer > 0 else ''
+        last_layer = layer == num_layers - 1
+        if layer > 0:
+            layer_w_shape = [out_channels, out_channels // group] + kernel
+            initializers.append(helper.make_tensor(
+                f'W{suffix}', TensorProto.FLOAT, layer_w_shape,
+                np.random.randn(*layer_w_shape).astype(np.float32).flatten().tolist()))
+            conv_inputs = [prev_output, f'W{suffix}']
+            if use_bias or bias_add:
+                initializers.append(helper.make_tensor(
+                    f'B{suffix}', TensorProto.FLOAT, B_shape,
+                    np.random.randn(*B_shape).astype(np.float32).flatten().tolist()))
+                if not bias_add:
+                    conv_inputs.append(f'B{suffix}')
+
+        conv_output = 'Y' if last_layer and not epilogue and not pool else f'conv{suffix}_out'
+        padding = {'auto_pad': auto_pad} if auto_pad else {'pads': pads + pads}
+        if transpose:
+            padding['output_padding'] = [output_padding] * spatial_dims
+        nodes.append(helper.make_node(
+            'ConvTranspose' if transpose else 'Conv',
+            inputs=conv_inputs,
+            outputs=[conv_output],
+            kernel_shape=kernel,
+            strides=strides,
+            dilations=dilations,
+            group=group,
+            **padding,
+        ))
+
+        prev_output = conv_output
+        for i, (op_type, extra_inputs, attrs) in enumerate(epilogue):
+            if op_type == 'Add' and reshaped_add:
+                nodes.append(helper.make_node('Reshape', inputs=['B', 'B_target_shape'], outputs=['B_reshaped']))
+                extra_inputs = ['B_reshaped']
+            elif op_type == 'Add':
+                extra_inputs = [f'B{suffix}']
+            elif op_type == 'BatchNormalization':
+                extra_inputs = [f'bn{suffix}_{name}' for name in ('scale', 'B', 'mean', 'var')]
+                for name in extra_inputs:
+                    # Variances must be positive; scale, shift and mean may be anything
+                    values = np.random.randn(out_channels).astype(np.float32)
+                    if name.endswith('_var'):
+                        values = np.abs(values) + 0.5
+                    initializers.append(helper.make_tensor(name, TensorProto.FLOAT, [out_channels], values.tolist()))
+            last_node = last_layer and i == len(epilogue) - 1 and not pool
+            output = 'Y' if last_node else f'{op_type.lower()}{suffix}_out'
+            nodes.append(helper.make_node(op_type, inputs=[prev_output] + extra_inputs, outputs=[output], **attrs))
+            prev_output = output
+
+    if pool:
+        nodes.append(helper.make_node('MaxPool', inputs=[prev_output], outputs=['maxpool_out'],
+                                      kernel_shape=[3] * spatial_dims, strides=[2] * spatial_dims,
+                                      pads=[1] * (2 * spatial_dims), ceil_mode=1))
+        nodes.append(helper.make_node('AveragePool', inputs=['maxpool_out'], outputs=['averagepool_out'],
+                                      kernel_shape=[2] * spatial_dims, pads=[1] * (2 * spatial_dims),
+                                      count_include_pad=1))
+        nodes.append(helper.make_node('GlobalAveragePool', inputs=['averagepool_out'], outputs=['Y']))
 
     # Graph
     graph = helper.make_graph(
-        [conv_node],
+        nodes,
         'conv_test',
         [X],  # inputs
         [Y],  # outputs
@@ -84,18 +218,28 @@ def create_conv_model(
     onnx.checker.check_model(model)
     onnx.save(model, output_file)
     print(f"Saved model to {output_file}")
-    print(f"  Input shape: [{batch}, {in_channels}, {height}, {width}]")
+    print(f"  Input shape: {[batch, in_channels] + sizes}")
     print(f"  Weight shape: {W_shape}")
-    if use_bias:
-        print(f"  Bias shape: [{out_channels}]")
-    print(f"  Output shape: [{batch}, {out_channels}, {out_h}, {out_w}]")
+    if group > 1:
+        print(f"  Group: {group}")
+    if use_bias or bias_add or reshaped_add:
+        print(f"  Bias shape: {B_shape}")
+    if batch_norm:
+        print("  BatchNormalization: yes")
+    if activation:
+        print(f"  Activation: {activation}")
+    if num_layers > 1:
+        print(f"  Layers: {num_layers}")
+    if pool:
+        print("  Pooling: MaxPool, AveragePool, GlobalAveragePool")
+    print(f"  Output shape: {[batch, out_channels] + out_sizes}")
 
     # Also save weights for reference comparison
     np.save(output_file.replace('.onnx', '_weights.npy'), W_data)
     print(f"Saved weights to {output_file.replace('.onnx', '_weights.npy')}")
 
     # Save bias if present
-    if use_bias and B_data is not None:
+    if B_data is not None:
         np.save(output_file.replace('.onnx', '_bias.npy'), B_data)
         print(f"Saved bias to {output_file.replace('.onnx', '_bias.npy')}")
 
@@ -109,18 +253,37 @@ if __name__ == "__main__":
     parser.add_argument("--batch", type=int, default=1)
     parser.add_argument("--in-channels", type=int, default=1)
     parser.add_argument("--out-channels", type=int, default=1)
+    parser.add_argument("--spatial-dims", type=int, choices=[1, 2, 3], default=2,
+                        help="1 for Conv1d, 2 for Conv2d, 3 for Conv3d")
+    parser.add_argument("--depth", type=int, default=8)
     parser.add_argument("--height", type=int, default=8)
     parser.add_argument("--width", type=int, default=8)
     parser.add_argument("--kernel", type=int, default=3)
     parser.add_argument("--pad", type=int, default=1)
     parser.add_argument("--stride", type=int, default=1)
+    parser.add_argument("--dilation", type=int, default=1)
+    parser.add_argument("--auto-pad", choices=["SAME_UPPER", "SAME_LOWER", "VALID"],
+                        help="Use auto_pad instead of explicit pads")
+    parser.add_argument("--transpose", action="store_true", help="Build ConvTranspose layers")
+    parser.add_argument("--output-padding", type=int, default=0, help="ConvTranspose output_padding")
+    parser.add_argument("--group", type=int, default=1, help="Number of convolution groups")
     parser.add_argument("--bias", action="store_true", help="Include bias in convolution")
+    parser.add_argument("--batch-norm", action="store_true", help="Follow each Conv with a BatchNormalization")
+    parser.add_argument("--bias-add", action="store_true", help="Add the bias with a separate Add node")
+    parser.add_argument("--reshaped-add", action="store_true",
+                        help="Add a full-shape bias produced by a Reshape of a flat constant")
+    parser.add_argument("--activation", choices=["relu", "leakyrelu", "sigmoid", "clip"],
+                        help="Append an activation after the convolution")
+    parser.add_argument("--layers", type=int, default=1, help="Number of stacked Conv layers")
+    parser.add_argument("--pool", action="store_true", help="Append MaxPool, AveragePool and GlobalAveragePool")
     args = parser.parse_args()
 
     create_conv_model(
         batch=args.batch,
         in_channels=args.in_channels,
         out_channels=args.out_channels,
+        spatial_dims=args.spatial_dims,
+        depth=args.depth,
         height=args.height,
         width=args.width,
         kernel_h=args.kernel,
@@ -129,6 +292,18 @@ if __name__ == "__main__":
         pad_w=args.pad,
         stride_h=args.stride,
         stride_w=args.stride,
+        dilation_h=args.dilation,
+        dilation_w=args.dilation,
+        auto_pad=args.auto_pad,
+        group=args.group,
+        transpose=args.transpose,
+        output_padding=args.output_padding,
         use_bias=args.bias,
+        batch_norm=args.batch_norm,
+        bias_add=args.bias_add,
+        reshaped_add=args.reshaped_add,
+        activation=args.activation,
+        num_layers=args.layers,
+        pool=args.pool,
         output_file=args.output
     )
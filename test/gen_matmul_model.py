@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+# Licensed under the MIT License.
+
+"""Generate a simple MatMul or Gemm ONNX model (optionally followed by a bias and an activation) for testing."""
+
+import numpy as np
+
+try:
+    import onnx
+    from onnx import helper, TensorProto
+except ImportError:
+    print("Please install onnx: pip install onnx")
+    exit(1)
+
+
+def create_matmul_model(
+    batch_dims=(),
+    m=8,
+    k=16,
+    n=32,
+    gemm=False,
+    trans_a=False,
+    trans_b=False,
+    alpha=1.0,
+    use_bias=False,
+    activation=None,
+    num_layers=1,
+    output_file="matmul_test.onnx"
+):
+    """Create a MatMul (or Gemm) model multiplying input X by a constant weight W.
+
+    MatMul takes X as [*batch_dims, M, K] and W as [K, N]. gemm builds a Gemm over a 2-D X instead,
+    with trans_a/trans_b storing X as [K, M] and W as [N, K], and alpha scaling the product. use_bias adds
+    an [N] bias: as Gemm's C input, or as a separate Add after a MatMul, so the model exercises the EP's
+    MatMul + bias + activation fusion. activation ('relu', 'leakyrelu', 'sigmoid' or 'clip') appends that
+    node. num_layers > 1 stacks further N -> N layers (weights W1, W2, ...) on top, like an MLP.
+    """
+
+    batch_dims = list(batch_dims)
+    if gemm and batch_dims:
+        raise ValueError("Gemm takes 2-D inputs only")
+
+    # Input
+    X_shape = batch_dims + ([k, m] if trans_a else [m, k])
+    X = helper.make_tensor_value_info('X', TensorProto.FLOAT, X_shape)
+
+    def make_layer_weights(suffix, in_features):
+        shape = [n, in_features] if trans_b else [in_features, n]
+        data = np.random.randn(*shape).astype(np.float32)
+        initializers.append(helper.make_tensor(f'W{suffix}', TensorProto.FLOAT, shape, data.flatten().tolist()))
+        return shape, data
+
+    # Weights and bias (as initializers with random values)
+    initializers = []
+    W_shape, W_data = make_layer_weights('', k)
+    B_data = None
+    if use_bias:
+        B_data = np.random.randn(n).astype(np.float32)
+        initializers.append(helper.make_tensor('B', TensorProto.FLOAT, [n], B_data.tolist()))
+
+    Y_shape = batch_dims + [m, n]
+    Y = helper.make_tensor_value_info('Y', TensorProto.FLOAT, Y_shape)
+
+    # Each layer is a MatMul/Gemm node, followed by the optional epilogue nodes
+    epilogue = []
+    if use_bias and not gemm:
+        epilogue.append(('Add', ['B'], {}))
+    if activation == 'relu':
+        epilogue.append(('Relu', [], {}))
+    elif activation == 'leakyrelu':
+        epilogue.append(('LeakyRelu', [], {'alpha': 0.1}))
+    elif activation == 'sigmoid':
+        epilogue.append(('Sigmoid', [], {}))
+    elif activation == 'clip':
+        # Relu6, with min/max as constant inputs (opset 11+)
+        initializers.append(helper.make_tensor('clip_min', TensorProto.FLOAT, [], [0.0]))
+        initializers.append(helper.make_tensor('clip_max', TensorProto.FLOAT, [], [6.0]))
+        epilogue.append(('Clip', ['clip_min', 'clip_max'], {}))
+
+    nodes = []
+    prev_output = 'X'
+    for layer in range(num_layers):
+        suffix = str(layer) if layer > 0 else ''
+        last_layer = layer == num_layers - 1
+        if layer > 0:
+            make_layer_weights(suffix, n)
+            if use_bias:
+                initializers.append(helper.make_tensor(
+                    f'B{suffix}', TensorProto.FLOAT, [n], np.random.randn(n).astype(np.float32).tolist()))
+
+        op_output = 'Y' if last_layer and not epilogue else f'matmul{suffix}_out'
+        if gemm:
+            # Only the first layer reads the (possibly transposed) input
+            inputs = [prev_output, f'W{suffix}'] + ([f'B{suffix}'] if use_bias else [])
+            nodes.append(helper.make_node(
+                'Gemm', inputs=inputs, outputs=[op_output],
+                transA=int(trans_a and layer == 0), transB=int(trans_b), alpha=alpha))
+        else:
+            nodes.append(helper.make_node('MatMul', inputs=[prev_output, f'W{suffix}'], outputs=[op_output]))
+
+        prev_output = op_output
+        for i, (op_type, extra_inputs, attrs) in enumerate(epilogue):
+            if op_type == 'Add':
+                extra_inputs = [f'B{suffix}']
+            last_node = last_layer and i == len(epilogue) - 1
+            output = 'Y' if last_node else f'{op_type.lower()}{suffix}_out'
+            nodes.append(helper.make_node(op_type, inputs=[prev_output] + extra_inputs, outputs=[output], **attrs))
+            prev_output = output
+
+    # Graph
+    graph = helper.make_graph(
+        nodes,
+        'matmul_test',
+        [X],  # inputs
+        [Y],  # outputs
+        initializers,  # initializers
+    )
+
+    # Model
+    model = helper.make_model(graph, opset_imports=[helper.make_opsetid('', 13)])
+    model.ir_version = 8
+
+    # Validate and save
+    onnx.checker.check_model(model)
+    onnx.save(model, output_file)
+    print(f"Saved model to {output_file}")
+    print(f"  Input shape: {X_shape}")
+    print(f"  Weight shape: {W_shape}")
+    if use_bias:
+        print(f"  Bias shape: {[n]}")
+    if activation:
+        print(f"  Activation: {activation}")
+    if num_layers > 1:
+        print(f"  Layers: {num_layers}")
+    print(f"  Output shape: {Y_shape}")
+
+    # Also save weights for reference comparison
+    np.save(output_file.replace('.onnx', '_weights.npy'), W_data)
+    print(f"Saved weights to {output_file.replace('.onnx', '_weights.npy')}")
+
+    # Save bias if present
+    if B_data is not None:
+        np.save(output_file.replace('.onnx', '_bias.npy'), B_data)
+        print(f"Saved bias to {output_file.replace('.onnx', '_bias.npy')}")
+
+    return model, W_data, B_data
+
+
+if __name__ == "__main__":
+    import argparse
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--output", "-o", default="matmul_test.onnx")
+    parser.add_argument("--batch-dims", type=int, nargs="*", default=[],
+                        help="Leading batch dims of the MatMul input")
+    parser.add_argument("--m", type=int, default=8)
+    parser.add_argument("--k", type=int, default=16)
+    parser.add_argument("--n", type=int, default=32)
+    parser.add_argument("--gemm", action="store_true", help="Build Gemm layers instead of MatMul")
+    parser.add_argument("--trans-a", action="store_true", help="Gemm transA: the input is stored as [K, M]")
+    parser.add_argument("--trans-b", action="store_true", help="Gemm transB: the weights are stored as [N, K]")
+    parser.add_argument("--alpha", type=float, default=1.0, help="Gemm alpha")
+    parser.add_argument("--bias", action="store_true",
+                        help="Add an [N] bias (Gemm's C input, or an Add node after MatMul)")
+    parser.add_argument("--activation", choices=["relu", "leakyrelu", "sigmoid", "clip"],
+                        help="Append an activation after each layer")
+    parser.add_argument("--layers", type=int, default=1, help="Number of stacked layers")
+    args = parser.parse_args()
+
+    create_matmul_model(
+        batch_dims=args.batch_dims,
+        m=args.m,
+        k=args.k,
+        n=args.n,
+        gemm=args.gemm,
+        trans_a=args.trans_a,
+        trans_b=args.trans_b,
+        alpha=args.alpha,
+        use_bias=args.bias,
+        activation=args.activation,
+        num_layers=args.layers,
+        output_file=args.output
+    )
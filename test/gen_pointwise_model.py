@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+# Licensed under the MIT License.
+
+"""Generate a Conv residual block followed by a chain of elementwise ops for testing."""
+
+import numpy as np
+
+try:
+    import onnx
+    from onnx import helper, TensorProto
+except ImportError:
+    print("Please install onnx: pip install onnx")
+    exit(1)
+
+
+def create_pointwise_model(
+    batch=1,
+    channels=4,
+    height=8,
+    width=8,
+    gelu_approximate="none",
+    output_file="pointwise_test.onnx"
+):
+    """Create a model exercising every op of the EP's generic pointwise kernel.
+
+    A 3x3 Conv over X is added back to X (a residual Add of two activations, which can't be fused into
+    the Conv), then runs through LeakyRelu, Tanh, a Mul by a [C, 1, 1] constant, HardSwish, Gelu, a Div
+    by a scalar and Clip; Sigmoid(X) is subtracted at the end. The model uses opset 20 for Gelu, whose
+    approximate attribute is gelu_approximate ('none' or 'tanh').
+    """
+
+    X_shape = [batch, channels, height, width]
+    X = helper.make_tensor_value_info('X', TensorProto.FLOAT, X_shape)
+    Y = helper.make_tensor_value_info('Y', TensorProto.FLOAT, X_shape)
+
+    # Weights, bias and the broadcast operands (as initializers with random values)
+    W_shape = [channels, channels, 3, 3]
+    W_data = np.random.randn(*W_shape).astype(np.float32)
+    B_data = np.random.randn(channels).astype(np.float32)
+    scale_data = np.random.randn(channels, 1, 1).astype(np.float32)
+    initializers = [
+        helper.make_tensor('W', TensorProto.FLOAT, W_shape, W_data.flatten().tolist()),
+        helper.make_tensor('B', TensorProto.FLOAT, [channels], B_data.tolist()),
+        helper.make_tensor('scale', TensorProto.FLOAT, [channels, 1, 1], scale_data.flatten().tolist()),
+        helper.make_tensor('divisor', TensorProto.FLOAT, [], [1.5]),
+        helper.make_tensor('clip_min', TensorProto.FLOAT, [], [-0.5]),
+        helper.make_tensor('clip_max', TensorProto.FLOAT, [], [0.5]),
+    ]
+
+    nodes = [
+        helper.make_node('Conv', inputs=['X', 'W', 'B'], outputs=['conv_out'], kernel_shape=[3, 3],
+                         pads=[1, 1, 1, 1]),
+        helper.make_node('Add', inputs=['conv_out', 'X'], outputs=['add_out']),
+        helper.make_node('LeakyRelu', inputs=['add_out'], outputs=['leakyrelu_out'], alpha=0.1),
+        helper.make_node('Tanh', inputs=['leakyrelu_out'], outputs=['tanh_out']),
+        helper.make_node('Mul', inputs=['tanh_out', 'scale'], outputs=['mul_out']),
+        helper.make_node('HardSwish', inputs=['mul_out'], outputs=['hardswish_out']),
+        helper.make_node('Gelu', inputs=['hardswish_out'], outputs=['gelu_out'], approximate=gelu_approximate),
+        helper.make_node('Div', inputs=['gelu_out', 'divisor'], outputs=['div_out']),
+        helper.make_node('Clip', inputs=['div_out', 'clip_min', 'clip_max'], outputs=['clip_out']),
+        helper.make_node('Sigmoid', inputs=['X'], outputs=['sigmoid_out']),
+        helper.make_node('Sub', inputs=['clip_out', 'sigmoid_out'], outputs=['Y']),
+    ]
+
+    # Graph
+    graph = helper.make_graph(
+        nodes,
+        'pointwise_test',
+        [X],  # inputs
+        [Y],  # outputs
+        initializers,  # initializers
+    )
+
+    # Model
+    model = helper.make_model(graph, opset_imports=[helper.make_opsetid('', 20)])
+    model.ir_version = 9
+
+    # Validate and save
+    onnx.checker.check_model(model)
+    onnx.save(model, output_file)
+    print(f"Saved model to {output_file}")
+    print(f"  Input shape: {X_shape}")
+    print(f"  Weight shape: {W_shape}")
+    print(f"  Gelu approximate: {gelu_approximate}")
+    print(f"  Output shape: {X_shape}")
+
+    # Also save weights and bias for reference comparison
+    np.save(output_file.replace('.onnx', '_weights.npy'), W_data)
+    print(f"Saved weights to {output_file.replace('.onnx', '_weights.npy')}")
+    np.save(output_file.replace('.onnx', '_bias.npy'), B_data)
+    print(f"Saved bias to {output_file.replace('.onnx', '_bias.npy')}")
+
+    return model, W_data, B_data
+
+
+if __name__ == "__main__":
+    import argparse
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--output", "-o", default="pointwise_test.onnx")
+    parser.add_argument("--batch", type=int, default=1)
+    parser.add_argument("--channels", type=int, default=4)
+    parser.add_argument("--height", type=int, default=8)
+    parser.add_argument("--width", type=int, default=8)
+    parser.add_argument("--gelu-approximate", choices=["none", "tanh"], default="none",
+                        help="Gelu's approximate attribute")
+    args = parser.parse_args()
+
+    create_pointwise_model(
+        batch=args.batch,
+        channels=args.channels,
+        height=args.height,
+        width=args.width,
+        gelu_approximate=args.gelu_approximate,
+        output_file=args.output
+    )
@@ -2,10 +2,18 @@
 // Licensed under the MIT License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <vector>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <numeric>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
 
 #ifndef ORT_API_MANUAL_INIT
 #define ORT_API_MANUAL_INIT
@@ -25,11 +33,148 @@
 #define CONV_BIAS_TEST_MODEL_PATH "./conv_bias_test.onnx"
 #endif
 
+#ifndef CONV_ADD_RELU_TEST_MODEL_PATH
+#define CONV_ADD_RELU_TEST_MODEL_PATH "./conv_add_relu_test.onnx"
+#endif
+
+#ifndef CONV_CHAIN_TEST_MODEL_PATH
+#define CONV_CHAIN_TEST_MODEL_PATH "./conv_chain_test.onnx"
+#endif
+
+#ifndef CONV_SIDE_INPUT_TEST_MODEL_PATH
+#define CONV_SIDE_INPUT_TEST_MODEL_PATH "./conv_side_input_test.onnx"
+#endif
+
+#ifndef CONV_DEPTHWISE_TEST_MODEL_PATH
+#define CONV_DEPTHWISE_TEST_MODEL_PATH "./conv_depthwise_test.onnx"
+#endif
+
+#ifndef CONV_DEPTHWISE_LARGE_TEST_MODEL_PATH
+#define CONV_DEPTHWISE_LARGE_TEST_MODEL_PATH "./conv_depthwise_large_test.onnx"
+#endif
+
+#ifndef CONV_DEPTHWISE_CHAIN_TEST_MODEL_PATH
+#define CONV_DEPTHWISE_CHAIN_TEST_MODEL_PATH "./conv_depthwise_chain_test.onnx"
+#endif
+
+#ifndef CONV_GROUPED_TEST_MODEL_PATH
+#define CONV_GROUPED_TEST_MODEL_PATH "./conv_grouped_test.onnx"
+#endif
+
+#ifndef CONV_LARGE_TEST_MODEL_PATH
+#define CONV_LARGE_TEST_MODEL_PATH "./conv_large_test.onnx"
+#endif
+
+#ifndef CONV_WINOGRAD_TEST_MODEL_PATH
+#define CONV_WINOGRAD_TEST_MODEL_PATH "./conv_winograd_test.onnx"
+#endif
+
+#ifndef CONV_DILATED_TEST_MODEL_PATH
+#define CONV_DILATED_TEST_MODEL_PATH "./conv_dilated_test.onnx"
+#endif
+
+#ifndef CONV_SAME_PAD_TEST_MODEL_PATH
+#define CONV_SAME_PAD_TEST_MODEL_PATH "./conv_same_pad_test.onnx"
+#endif
+
+#ifndef CONV_SAME_STRIDE_TEST_MODEL_PATH
+#define CONV_SAME_STRIDE_TEST_MODEL_PATH "./conv_same_stride_test.onnx"
+#endif
+
+#ifndef CONV1D_TEST_MODEL_PATH
+#define CONV1D_TEST_MODEL_PATH "./conv1d_test.onnx"
+#endif
+
+#ifndef CONV3D_TEST_MODEL_PATH
+#define CONV3D_TEST_MODEL_PATH "./conv3d_test.onnx"
+#endif
+
+#ifndef CONV_TRANSPOSE_TEST_MODEL_PATH
+#define CONV_TRANSPOSE_TEST_MODEL_PATH "./conv_transpose_test.onnx"
+#endif
+
+#ifndef CONV_TRANSPOSE_GROUPED_TEST_MODEL_PATH
+#define CONV_TRANSPOSE_GROUPED_TEST_MODEL_PATH "./conv_transpose_grouped_test.onnx"
+#endif
+
+#ifndef CONV_BN_TEST_MODEL_PATH
+#define CONV_BN_TEST_MODEL_PATH "./conv_bn_test.onnx"
+#endif
+
+#ifndef POOL_TEST_MODEL_PATH
+#define POOL_TEST_MODEL_PATH "./pool_test.onnx"
+#endif
+
+#ifndef POINTWISE_TEST_MODEL_PATH
+#define POINTWISE_TEST_MODEL_PATH "./pointwise_test.onnx"
+#endif
+
+#ifndef MATMUL_TEST_MODEL_PATH
+#define MATMUL_TEST_MODEL_PATH "./matmul_test.onnx"
+#endif
+
+#ifndef GEMM_TEST_MODEL_PATH
+#define GEMM_TEST_MODEL_PATH "./gemm_test.onnx"
+#endif
+
+// What a model must show on the HipDNN EP besides outputs that match the CPU EP's
+struct EpExpectation {
+  // Partitions the EP claims, the nodes in them, and the ops its kernels compile those nodes to once the
+  // epilogues are fused into their Conv, MatMul or Gemm
+  size_t partitions{1};
+  size_t nodes{1};
+  size_t ops{1};
+  // Checked on the host backend only: text its compile log must contain, such as the algorithm a Conv runs,
+  // and how many intermediates it keeps in the blocked layout
+  const char* host_log{nullptr};
+  std::optional<size_t> host_blocked;
+  float tolerance{1e-4f};
+  // Nodes the EP doesn't claim run on ORT's CPU EP; otherwise any such node fails the session
+  bool allow_cpu_fallback{false};
+};
+
+// Totals of the EP's partitioning and compile log lines
+struct EpLogSummary {
+  size_t partitions{0};
+  size_t claimed_nodes{0};
+  size_t kernels{0};
+  size_t compiled_nodes{0};
+  size_t ops{0};
+  size_t blocked{0};
+};
+
+EpLogSummary SummarizeEpLog(const std::vector<std::string>& log) {
+  EpLogSummary summary;
+  for (const std::string& line : log) {
+    size_t first = 0;
+    size_t second = 0;
+    size_t third = 0;
+    // ORT may ask for the capability more than once; the last answer is the one it uses
+    const size_t found = line.find("Found ");
+    if (found != std::string::npos &&
+        std::sscanf(line.c_str() + found, "Found %zu supported nodes in %zu partitions", &first, &second) == 2) {
+      summary.claimed_nodes = first;
+      summary.partitions = second;
+    }
+    const size_t compiled = line.find("Compiled ");
+    if (compiled != std::string::npos &&
+        std::sscanf(line.c_str() + compiled,
+                    "Compiled %zu ops from %zu nodes on the %*s backend, intermediates: %*s bytes (%zu blocked)",
+                    &first, &second, &third) == 3) {
+      ++summary.kernels;
+      summary.ops += first;
+      summary.compiled_nodes += second;
+      summary.blocked += third;
+    }
+  }
+  return summary;
+}
+
 class HipDNNConvTest : public ::testing::Test {
  protected:
   void SetUp() override {
     Ort::InitApi(OrtGetApiBase()->GetApi(ORT_API_VERSION));
-    env_ = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "HipDNNConvTest");
+    env_ = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "HipDNNConvTest", RecordLog, this);
 
     // Register EP
     // const char* lib_path = ORT_TSTR_ON_MACRO(HIPDNN_EP_LIB_PATH);
@@ -58,9 +203,124 @@ class HipDNNConvTest : public ::testing::Test {
     env_.reset();
   }
 
+  // Keeps every message for the test to inspect, and prints warnings and errors as ORT's default sink would
+  static void ORT_API_CALL RecordLog(void* param, OrtLoggingLevel severity, const char* /*category*/,
+                                     const char* /*logid*/, const char* /*code_location*/, const char* message) {
+    auto* test = static_cast<HipDNNConvTest*>(param);
+    std::lock_guard<std::mutex> lock(test->log_mutex_);
+    test->log_.emplace_back(message);
+    if (severity >= ORT_LOGGING_LEVEL_WARNING) {
+      std::cerr << message << std::endl;
+    }
+  }
+
+  std::vector<std::string> TakeLog() {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    std::vector<std::string> log;
+    log.swap(log_);
+    return log;
+  }
+
+  // Appends the HipDNN EP to `session_options`. Returns false if no HipDNN device is registered.
+  bool AppendHipDNNEp(Ort::SessionOptions& session_options) {
+    const OrtEpDevice* hipdnn_device = nullptr;
+    for (const auto& device : env_->GetEpDevices()) {
+      if (std::string(device.EpName()) == "HipDNN") {
+        hipdnn_device = static_cast<const OrtEpDevice*>(device);
+        host_backend_ = device.Device().Type() == OrtHardwareDeviceType_CPU;
+        break;
+      }
+    }
+
+    if (hipdnn_device == nullptr) {
+      return false;
+    }
+
+    OrtStatus* status = Ort::GetApi().SessionOptionsAppendExecutionProvider_V2(
+        session_options, *env_, &hipdnn_device, 1, nullptr, nullptr, 0);
+    if (status != nullptr) {
+      std::cout << "Failed to add HipDNN EP: " << Ort::GetApi().GetErrorMessage(status) << std::endl;
+      Ort::GetApi().ReleaseStatus(status);
+      return false;
+    }
+    return true;
+  }
+
+  // Runs a model with a single float input "X" and output "Y" and returns the output values.
+  std::vector<float> RunModel(const ORTCHAR_T* model_path, const Ort::SessionOptions& session_options,
+                              std::vector<float>& input_data, const std::vector<int64_t>& input_shape) {
+    Ort::Session session(*env_, model_path, session_options);
+
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
+        memory_info, input_data.data(), input_data.size(), input_shape.data(), input_shape.size());
+
+    const char* input_names[] = {"X"};
+    const char* output_names[] = {"Y"};
+    auto output_tensors = session.Run(Ort::RunOptions{}, input_names, &input_tensor, 1, output_names, 1);
+
+    const float* output_data = output_tensors[0].GetTensorData<float>();
+    size_t output_size = output_tensors[0].GetTensorTypeAndShapeInfo().GetElementCount();
+    return std::vector<float>(output_data, output_data + output_size);
+  }
+
+  // Runs a model on the CPU EP and on the HipDNN EP and expects matching outputs, and the partitions, fusion
+  // and host algorithms `expect` describes
+  void ExpectMatchesCpu(const ORTCHAR_T* model_path, const std::vector<int64_t>& input_shape,
+                        const EpExpectation& expect) {
+    std::vector<float> input_data(std::accumulate(input_shape.begin(), input_shape.end(), int64_t{1},
+                                                  std::multiplies<int64_t>()));
+    for (size_t i = 0; i < input_data.size(); ++i) {
+      input_data[i] = static_cast<float>(i % 10) / 10.0f - 0.5f;
+    }
+
+    Ort::SessionOptions cpu_options;
+    cpu_options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+    std::vector<float> cpu_output = RunModel(model_path, cpu_options, input_data, input_shape);
+
+    // Verbose, so the log has the EP's compile summary
+    Ort::SessionOptions gpu_options;
+    gpu_options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+    gpu_options.SetLogSeverityLevel(ORT_LOGGING_LEVEL_VERBOSE);
+    if (!expect.allow_cpu_fallback) {
+      gpu_options.AddConfigEntry("session.disable_cpu_ep_fallback", "1");
+    }
+    ASSERT_TRUE(AppendHipDNNEp(gpu_options)) << "No HipDNN device found";
+    TakeLog();
+    std::vector<float> gpu_output = RunModel(model_path, gpu_options, input_data, input_shape);
+    const std::vector<std::string> log = TakeLog();
+
+    ASSERT_EQ(cpu_output.size(), gpu_output.size()) << "Output size mismatch";
+    for (size_t i = 0; i < cpu_output.size(); ++i) {
+      EXPECT_NEAR(cpu_output[i], gpu_output[i], expect.tolerance)
+          << "Mismatch at index " << i << ": CPU=" << cpu_output[i] << ", GPU=" << gpu_output[i];
+    }
+
+    const EpLogSummary summary = SummarizeEpLog(log);
+    EXPECT_EQ(summary.partitions, expect.partitions);
+    EXPECT_EQ(summary.kernels, expect.partitions);
+    EXPECT_EQ(summary.claimed_nodes, expect.nodes);
+    EXPECT_EQ(summary.compiled_nodes, expect.nodes);
+    EXPECT_EQ(summary.ops, expect.ops) << "Ops left after fusing the epilogues";
+    if (host_backend_) {
+      if (expect.host_log != nullptr) {
+        EXPECT_TRUE(std::any_of(log.begin(), log.end(), [&](const std::string& line) {
+          return line.find(expect.host_log) != std::string::npos;
+        })) << "Host backend didn't log \"" << expect.host_log << "\"";
+      }
+      if (expect.host_blocked.has_value()) {
+        EXPECT_EQ(summary.blocked, *expect.host_blocked) << "Blocked intermediates";
+      }
+    }
+  }
+
   std::unique_ptr<Ort::Env> env_;
+  std::mutex log_mutex_;
+  std::vector<std::string> log_;
   bool ep_available_{false};
   bool model_available_{false};
+  // Set by AppendHipDNNEp when the EP runs on its CPU device (no GPU), i.e. on the host backend
+  bool host_backend_{false};
 };
 
 // Simple reference Conv2D implementation for verification (with optional bias)
@@ -407,3 +667,296 @@ TEST_F(HipDNNConvTest, Conv2DWithBias) {
 
   std::cout << "Max difference between CPU and GPU (with bias): " << max_diff << std::endl;
 }
+
+TEST_F(HipDNNConvTest, ConvAlgoCacheIsPersisted) {
+  ASSERT_TRUE(ep_available_) << "HipDNN EP not available";
+  ASSERT_TRUE(model_available_) << "Conv test model not available at: " << CONV_TEST_MODEL_PATH;
+
+  const std::string cache_path = ::testing::TempDir() + "hipdnn_ep_conv_algo_cache.txt";
+  std::remove(cache_path.c_str());
+
+  const std::vector<int64_t> input_shape = {1, 1, 8, 8};
+  std::vector<float> input_data(64);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = static_cast<float>(i % 10) / 10.0f;
+  }
+
+  // First session runs Find and writes the cache
+  Ort::SessionOptions first_options;
+  first_options.AddConfigEntry("ep.hipdnn.conv_algo_cache_path", cache_path.c_str());
+  ASSERT_TRUE(AppendHipDNNEp(first_options)) << "No HipDNN device found";
+  std::vector<float> first_output = RunModel(ORT_TSTR_ON_MACRO(CONV_TEST_MODEL_PATH), first_options,
+                                             input_data, input_shape);
+  if (host_backend_) {
+    GTEST_SKIP() << "The host backend has no convolution algorithm cache";
+  }
+
+  size_t num_entries = 0;
+  {
+    std::ifstream cache_file(cache_path);
+    ASSERT_TRUE(cache_file.good()) << "Conv algo cache was not written to " << cache_path;
+    std::string line;
+    while (std::getline(cache_file, line)) {
+      if (!line.empty() && line[0] != '#') {
+        ++num_entries;
+      }
+    }
+  }
+  EXPECT_EQ(num_entries, 1u);
+
+  // Second session must be served from the cache and produce identical results
+  Ort::SessionOptions second_options;
+  second_options.AddConfigEntry("ep.hipdnn.conv_algo_cache_path", cache_path.c_str());
+  ASSERT_TRUE(AppendHipDNNEp(second_options)) << "No HipDNN device found";
+  std::vector<float> second_output = RunModel(ORT_TSTR_ON_MACRO(CONV_TEST_MODEL_PATH), second_options,
+                                              input_data, input_shape);
+
+  ASSERT_EQ(first_output.size(), second_output.size());
+  for (size_t i = 0; i < first_output.size(); ++i) {
+    EXPECT_FLOAT_EQ(first_output[i], second_output[i]) << "Mismatch at index " << i;
+  }
+
+  // A cache hit must not append another entry
+  std::ifstream cache_file(cache_path);
+  size_t num_entries_after = 0;
+  std::string line;
+  while (std::getline(cache_file, line)) {
+    if (!line.empty() && line[0] != '#') {
+      ++num_entries_after;
+    }
+  }
+  EXPECT_EQ(num_entries_after, num_entries);
+
+  std::remove(cache_path.c_str());
+}
+
+TEST_F(HipDNNConvTest, EpContextModelRoundTrip) {
+  ASSERT_TRUE(ep_available_) << "HipDNN EP not available";
+  ASSERT_TRUE(model_available_) << "Conv test model not available at: " << CONV_TEST_MODEL_PATH;
+
+  const std::string context_path = ::testing::TempDir() + "hipdnn_ep_conv_ctx.onnx";
+  std::remove(context_path.c_str());
+
+  const std::vector<int64_t> input_shape = {1, 1, 8, 8};
+  std::vector<float> input_data(64);
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    input_data[i] = static_cast<float>(i % 10) / 10.0f;
+  }
+
+  // First session compiles the model and exports the EP context model
+  Ort::SessionOptions export_options;
+  export_options.AddConfigEntry("ep.context_enable", "1");
+  export_options.AddConfigEntry("ep.context_file_path", context_path.c_str());
+  ASSERT_TRUE(AppendHipDNNEp(export_options)) << "No HipDNN device found";
+  std::vector<float> expected = RunModel(ORT_TSTR_ON_MACRO(CONV_TEST_MODEL_PATH), export_options,
+                                         input_data, input_shape);
+
+  std::ifstream context_file(context_path);
+  ASSERT_TRUE(context_file.good()) << "EP context model was not written to " << context_path;
+
+  // Second session loads the pre-compiled kernel from the EPContext node
+  Ort::SessionOptions import_options;
+  ASSERT_TRUE(AppendHipDNNEp(import_options)) << "No HipDNN device found";
+  std::vector<float> output = RunModel(context_path.c_str(), import_options, input_data, input_shape);
+
+  ASSERT_EQ(output.size(), expected.size());
+  for (size_t i = 0; i < output.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], expected[i]) << "Mismatch at index " << i;
+  }
+
+  std::remove(context_path.c_str());
+}
+
+TEST_F(HipDNNConvTest, ConcurrentRunsShareOneSession) {
+  ASSERT_TRUE(ep_available_) << "HipDNN EP not available";
+
+  std::ifstream model_file(CONV_CHAIN_TEST_MODEL_PATH);
+  if (!model_file.good()) {
+    GTEST_SKIP() << "Conv chain test model not available at: " << CONV_CHAIN_TEST_MODEL_PATH;
+  }
+
+  constexpr size_t kNumThreads = 4;
+  constexpr size_t kRunsPerThread = 8;
+  const std::vector<int64_t> input_shape = {1, 2, 8, 8};
+
+  // Each thread uses its own input so that any sharing of intermediates between runs shows up in the outputs
+  std::vector<std::vector<float>> inputs(kNumThreads, std::vector<float>(2 * 8 * 8));
+  std::vector<std::vector<float>> expected(kNumThreads);
+  Ort::SessionOptions cpu_options;
+  cpu_options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    for (size_t i = 0; i < inputs[t].size(); ++i) {
+      inputs[t][i] = static_cast<float>((i + 3 * t) % 10) / 10.0f - 0.5f;
+    }
+    expected[t] = RunModel(ORT_TSTR_ON_MACRO(CONV_CHAIN_TEST_MODEL_PATH), cpu_options, inputs[t], input_shape);
+  }
+
+  Ort::SessionOptions gpu_options;
+  gpu_options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+  gpu_options.AddConfigEntry("session.disable_cpu_ep_fallback", "1");
+  ASSERT_TRUE(AppendHipDNNEp(gpu_options)) << "No HipDNN device found";
+  Ort::Session session(*env_, ORT_TSTR_ON_MACRO(CONV_CHAIN_TEST_MODEL_PATH), gpu_options);
+
+  std::vector<size_t> mismatches(kNumThreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+      const char* input_names[] = {"X"};
+      const char* output_names[] = {"Y"};
+      for (size_t run = 0; run < kRunsPerThread; ++run) {
+        Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
+            memory_info, inputs[t].data(), inputs[t].size(), input_shape.data(), input_shape.size());
+        auto output_tensors = session.Run(Ort::RunOptions{}, input_names, &input_tensor, 1, output_names, 1);
+
+        const float* output_data = output_tensors[0].GetTensorData<float>();
+        for (size_t i = 0; i < expected[t].size(); ++i) {
+          if (std::abs(output_data[i] - expected[t][i]) > 1e-4f) {
+            ++mismatches[t];
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    EXPECT_EQ(mismatches[t], 0u) << "Thread " << t << " produced wrong outputs";
+  }
+}
+
+// A model run by ExpectMatchesCpu, with the gen_*_model.py command that writes it
+struct ModelCase {
+  const char* name;
+  const char* model_path;
+  const char* generate;
+  std::vector<int64_t> input_shape;
+  EpExpectation expect;
+};
+
+const ModelCase kModelCases[] = {
+    // Add and Relu are only supported fused into the Conv, so the session fails unless they are
+    {"ConvAddReluIsFused", CONV_ADD_RELU_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 2 --out-channels 4 --bias-add --activation relu -o conv_add_relu_test.onnx",
+     {1, 2, 8, 8}, {1, 3, 1}},
+    // Conv -> Relu -> Conv -> Relu is one partition whose intermediate stays in the kernel's scratch memory
+    {"ConvChainRunsAsOnePartition", CONV_CHAIN_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 2 --out-channels 4 --bias --activation relu --layers 2"
+     " -o conv_chain_test.onnx",
+     {1, 2, 8, 8}, {1, 4, 2, nullptr, 1}},
+    // The Add's other operand comes from a Reshape left to ORT. It doesn't depend on the Conv, so the Conv,
+    // Add and Relu are still one partition; the Add isn't a constant bias, so it runs as an op of its own.
+    {"SideInputDoesNotSplitPartition", CONV_SIDE_INPUT_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 2 --out-channels 4 --reshaped-add --activation relu"
+     " -o conv_side_input_test.onnx",
+     {1, 2, 8, 8}, {1, 3, 3, nullptr, std::nullopt, 1e-4f, true}},
+    // group == C_in == C_out: every channel is convolved with its own filter
+    {"DepthwiseConv2D", CONV_DEPTHWISE_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 4 --out-channels 4 --group 4 --bias -o conv_depthwise_test.onnx",
+     {1, 4, 8, 8}, {1, 1, 1, "algorithm: depthwise"}},
+    // A 5x5 depthwise Conv + Clip: on the host backend a full and a partial channel block, output rows that are
+    // not a multiple of the kernel's register tile, and the Clip applied in registers
+    {"DepthwiseConv2DLarge", CONV_DEPTHWISE_LARGE_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 20 --out-channels 20 --group 20 --height 30 --width 29 --kernel 5 --pad 2"
+     " --bias --activation clip -o conv_depthwise_large_test.onnx",
+     {1, 20, 30, 29}, {1, 2, 1, "algorithm: depthwise"}},
+    // Three depthwise Conv + Relu layers into the pooling tail. On the host backend all five intermediates are
+    // kept channel-blocked, a full and a partial block of 16, and only the input and output are reordered.
+    {"DepthwiseChainPooling", CONV_DEPTHWISE_CHAIN_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 24 --out-channels 24 --group 24 --height 14 --width 13 --bias"
+     " --activation relu --layers 3 --pool -o conv_depthwise_chain_test.onnx",
+     {1, 24, 14, 13}, {1, 9, 6, "algorithm: depthwise", 5}},
+    // Two groups of 2 input channels, each producing 3 output channels
+    {"GroupedConv2D", CONV_GROUPED_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 4 --out-channels 6 --group 2 --bias -o conv_grouped_test.onnx",
+     {1, 4, 8, 8}, {1, 1, 1, "group: 2, bias: 1, activation: 0, algorithm: gemm"}},
+    // Big enough that the host backend's GEMM convolution splits K (32 * 5 * 5) and the output positions into
+    // several blocks, with partial blocks on every edge
+    {"LargeConv2D", CONV_LARGE_TEST_MODEL_PATH,
+     "gen_conv_model.py --batch 2 --in-channels 32 --out-channels 52 --height 20 --width 20 --kernel 5 --pad 2"
+     " --bias --activation relu -o conv_large_test.onnx",
+     {2, 32, 20, 20}, {1, 2, 1, "algorithm: gemm"}},
+    // A 3x3 stride-1 Conv the host backend runs as Winograd F(4x4, 3x3), with partial 4x4 tiles on the bottom
+    // and right edges. The transforms round differently from direct summation, hence the looser tolerance.
+    {"WinogradConv2D", CONV_WINOGRAD_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 64 --out-channels 48 --height 30 --width 29 --bias --activation relu"
+     " -o conv_winograd_test.onnx",
+     {1, 64, 30, 29}, {1, 2, 1, "algorithm: winograd", std::nullopt, 1e-3f}},
+    // Winograd only takes undilated kernels
+    {"DilatedConv2D", CONV_DILATED_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 2 --out-channels 4 --dilation 2 --pad 2 --bias -o conv_dilated_test.onnx",
+     {1, 2, 8, 8}, {1, 1, 1, "algorithm: gemm"}},
+    // SAME_UPPER with a dilated 3x3 kernel resolves to pads of 2 on every side
+    {"AutoPadSameConv2D", CONV_SAME_PAD_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 2 --out-channels 4 --dilation 2 --auto-pad SAME_UPPER --bias"
+     " -o conv_same_pad_test.onnx",
+     {1, 2, 8, 8}, {1, 1, 1}},
+    // SAME_UPPER with stride 2 over an even extent pads 0 at the top and left and 1 at the bottom and right.
+    // The uneven pads are claimed, with the Relu fused.
+    {"AutoPadSameStridedConv2D", CONV_SAME_STRIDE_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 3 --out-channels 8 --stride 2 --height 10 --width 12 --auto-pad SAME_UPPER"
+     " --bias --activation relu -o conv_same_stride_test.onnx",
+     {1, 3, 10, 12}, {1, 2, 1, "algorithm: gemm"}},
+    {"Conv1D", CONV1D_TEST_MODEL_PATH,
+     "gen_conv_model.py --spatial-dims 1 --in-channels 2 --out-channels 4 --width 16 --bias -o conv1d_test.onnx",
+     {1, 2, 16}, {1, 1, 1, "algorithm: gemm"}},
+    // The [1, C, 1, 1, 1] bias Add and the Relu are fused into the Conv
+    {"Conv3DAddRelu", CONV3D_TEST_MODEL_PATH,
+     "gen_conv_model.py --spatial-dims 3 --in-channels 2 --out-channels 4 --depth 4 --bias-add --activation relu"
+     " -o conv3d_test.onnx",
+     {1, 2, 4, 8, 8}, {1, 3, 1, "algorithm: gemm"}},
+    // Stride 2 with output_padding 1 upsamples 8x8 to 16x16
+    {"ConvTranspose2D", CONV_TRANSPOSE_TEST_MODEL_PATH,
+     "gen_conv_model.py --transpose --in-channels 4 --out-channels 2 --stride 2 --output-padding 1 --bias"
+     " -o conv_transpose_test.onnx",
+     {1, 4, 8, 8}, {1, 1, 1, "algorithm: direct"}},
+    // SAME_UPPER crops the odd padding element from the beginning, which runs as output padding
+    {"GroupedConvTransposeAddRelu", CONV_TRANSPOSE_GROUPED_TEST_MODEL_PATH,
+     "gen_conv_model.py --transpose --in-channels 4 --out-channels 4 --group 2 --stride 2 --auto-pad SAME_UPPER"
+     " --bias-add --activation relu -o conv_transpose_grouped_test.onnx",
+     {1, 4, 8, 8}, {1, 3, 1, "algorithm: direct"}},
+    // BatchNormalization is only supported folded into the Conv
+    {"ConvBatchNormRelu", CONV_BN_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 2 --out-channels 4 --bias --batch-norm --activation relu"
+     " -o conv_bn_test.onnx",
+     {1, 2, 8, 8}, {1, 3, 1}},
+    // MaxPool with ceil_mode (8x8 -> 5x5), AveragePool counting the padding (5x5 -> 6x6), then global. On the
+    // host backend the Conv and both windowed pools write blocked outputs.
+    {"ConvReluPooling", POOL_TEST_MODEL_PATH,
+     "gen_conv_model.py --in-channels 2 --out-channels 4 --bias --activation relu --pool -o pool_test.onnx",
+     {1, 2, 8, 8}, {1, 5, 4, nullptr, 3}},
+    // Residual Add, every activation, and Mul/Div/Sub with [C, 1, 1], scalar and full-shape operands. The Conv
+    // has a bias input and the residual isn't constant, so nothing is fused.
+    {"ResidualPointwiseChain", POINTWISE_TEST_MODEL_PATH, "gen_pointwise_model.py -o pointwise_test.onnx",
+     {1, 4, 8, 8}, {1, 11, 11}},
+    // The batch of X against the shared [K, N] weights runs as one taller GEMM, with Add and Relu as its epilogue
+    {"BatchedMatMulAddRelu", MATMUL_TEST_MODEL_PATH,
+     "gen_matmul_model.py --batch-dims 2 --bias --activation relu --layers 2 -o matmul_test.onnx",
+     {2, 8, 16}, {1, 6, 2}},
+    // Sigmoid has no hipBLASLt epilogue, so on the GPU it runs as a MIOpen activation inside the Gemm's op
+    {"GemmTransposedSigmoid", GEMM_TEST_MODEL_PATH,
+     "gen_matmul_model.py --gemm --trans-a --trans-b --alpha 0.5 --bias --activation sigmoid --layers 2"
+     " -o gemm_test.onnx",
+     {16, 8}, {1, 4, 2}},
+};
+
+class HipDNNModelTest : public HipDNNConvTest, public ::testing::WithParamInterface<ModelCase> {};
+
+TEST_P(HipDNNModelTest, MatchesCpu) {
+  ASSERT_TRUE(ep_available_) << "HipDNN EP not available";
+  const ModelCase& model = GetParam();
+
+  std::ifstream model_file(model.model_path);
+  if (!model_file.good()) {
+    GTEST_SKIP() << "Test model not available at: " << model.model_path << ". Generate it with: python "
+                 << model.generate;
+  }
+
+  const std::basic_string<ORTCHAR_T> model_path(model.model_path, model.model_path + std::strlen(model.model_path));
+  ExpectMatchesCpu(model_path.c_str(), model.input_shape, model.expect);
+}
+
+INSTANTIATE_TEST_SUITE_P(Models, HipDNNModelTest, ::testing::ValuesIn(kModelCases),
+                         [](const ::testing::TestParamInfo<ModelCase>& info) { return std::string(info.param.name); });
@@ -0,0 +1,116 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone HipDataTransfer tests: copies from and to pageable host memory are staged through pinned
+// buffers, and land the same data as copies from pinned memory
+
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "hipdnn_ep/ep_data_transfer.h"
+
+namespace {
+
+class EpDataTransferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int device_count = 0;
+    if (hipGetDeviceCount(&device_count) != hipSuccess || device_count == 0) {
+      GTEST_SKIP() << "No HIP device found";
+    }
+    Ort::InitApi(OrtGetApiBase()->GetApi(ORT_API_VERSION));
+    const OrtApi& ort_api = Ort::GetApi();
+    hipdnn_ep::ApiPtrs api_ptrs{ort_api, *ort_api.GetEpApi(), *ort_api.GetModelEditorApi()};
+
+    // Only verbose tracing uses the logger, and it is off unless a session lowers the severity, so the
+    // transfer never dereferences it
+    const OrtLogger& logger = *reinterpret_cast<const OrtLogger*>(&logger_storage_);
+    transfer_ = std::make_unique<hipdnn_ep::HipDataTransfer>(api_ptrs, logger, nullptr, 0);
+  }
+
+  // Copies `srcs` into `dsts` without a stream, so the copies are complete on return
+  void Copy(std::vector<const OrtValue*> srcs, std::vector<OrtValue*> dsts) {
+    ASSERT_EQ(srcs.size(), dsts.size());
+    Ort::Status status(transfer_->CopyTensors(transfer_.get(), srcs.data(), dsts.data(), nullptr, srcs.size()));
+    ASSERT_TRUE(status.IsOK()) << status.GetErrorMessage();
+  }
+
+  Ort::Value HostTensor(float* data, size_t count) {
+    std::array<int64_t, 1> shape{static_cast<int64_t>(count)};
+    return Ort::Value::CreateTensor<float>(cpu_memory_info_, data, count, shape.data(), shape.size());
+  }
+
+  Ort::Value DeviceTensor(void* data, size_t count) {
+    std::array<int64_t, 1> shape{static_cast<int64_t>(count)};
+    return Ort::Value::CreateTensor(gpu_memory_info_, data, count * sizeof(float), shape.data(), shape.size(),
+                                    ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+  }
+
+  int logger_storage_{0};
+  std::unique_ptr<hipdnn_ep::HipDataTransfer> transfer_;
+  Ort::MemoryInfo cpu_memory_info_{Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)};
+  Ort::MemoryInfo gpu_memory_info_{"HipDNN_GPU", OrtMemoryInfoDeviceType_GPU, 0x1002, 0,
+                                   OrtDeviceMemoryType_DEFAULT, 0, OrtDeviceAllocator};
+};
+
+}  // namespace
+
+TEST_F(EpDataTransferTest, PageableAndPinnedCopiesRoundTrip) {
+  // Larger than one staging granule and not a multiple of it
+  constexpr size_t kCount = (size_t{3} << 20) / sizeof(float) + 5;
+
+  std::vector<float> pageable_in(kCount);
+  std::vector<float> pageable_out(kCount, 0.0f);
+  for (size_t i = 0; i < kCount; ++i) {
+    pageable_in[i] = static_cast<float>(i % 1000) * 0.5f;
+  }
+  ASSERT_FALSE(hipdnn_ep::IsPinnedHostMemory(pageable_in.data()));
+
+  float* pinned_in = nullptr;
+  float* pinned_out = nullptr;
+  ASSERT_EQ(hipHostMalloc(reinterpret_cast<void**>(&pinned_in), kCount * sizeof(float), hipHostMallocDefault),
+            hipSuccess);
+  ASSERT_EQ(hipHostMalloc(reinterpret_cast<void**>(&pinned_out), kCount * sizeof(float), hipHostMallocDefault),
+            hipSuccess);
+  for (size_t i = 0; i < kCount; ++i) {
+    pinned_in[i] = -pageable_in[i];
+    pinned_out[i] = 0.0f;
+  }
+
+  void* device_a = nullptr;
+  void* device_b = nullptr;
+  ASSERT_EQ(hipMalloc(&device_a, kCount * sizeof(float)), hipSuccess);
+  ASSERT_EQ(hipMalloc(&device_b, kCount * sizeof(float)), hipSuccess);
+
+  {
+    Ort::Value host_a = HostTensor(pageable_in.data(), kCount);
+    Ort::Value host_b = HostTensor(pinned_in, kCount);
+    Ort::Value dev_a = DeviceTensor(device_a, kCount);
+    Ort::Value dev_b = DeviceTensor(device_b, kCount);
+    Ort::Value out_a = HostTensor(pageable_out.data(), kCount);
+    Ort::Value out_b = HostTensor(pinned_out, kCount);
+
+    // Both directions in one call each, so the staged copies share the call's final synchronization
+    Copy({host_a, host_b}, {dev_a, dev_b});
+    Copy({dev_a, dev_b}, {out_a, out_b});
+    EXPECT_EQ(pageable_out, pageable_in);
+    for (size_t i = 0; i < kCount; ++i) {
+      ASSERT_EQ(pinned_out[i], -pageable_in[i]) << "Mismatch at index " << i;
+    }
+
+    // A second round trip through the other device buffer reuses the idle staging buffers
+    std::fill(pageable_out.begin(), pageable_out.end(), 0.0f);
+    Copy({host_a}, {dev_b});
+    Copy({dev_b}, {out_a});
+    EXPECT_EQ(pageable_out, pageable_in);
+  }
+
+  hipFree(device_a);
+  hipFree(device_b);
+  hipHostFree(pinned_in);
+  hipHostFree(pinned_out);
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone tests of the EP's log severity gate: messages below the lowest severity of the known loggers
+// are neither formatted nor handed to ORT
+
+#include <gtest/gtest.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "hipdnn_ep/ep_utils.h"
+
+namespace {
+
+// Read before any test can move the gate
+const int kInitialSeverity = hipdnn_ep::g_min_log_severity.load();
+
+struct LoggedMessage {
+  OrtLoggingLevel level;
+  std::string text;
+};
+
+std::vector<LoggedMessage> g_messages;
+OrtLoggingLevel g_logger_severity = ORT_LOGGING_LEVEL_WARNING;
+bool g_fail_severity_query = false;
+
+OrtStatus* ORT_API_CALL LogMessage(const OrtLogger* /*logger*/, OrtLoggingLevel level, const char* message,
+                                   const ORTCHAR_T* /*file_path*/, int /*line_number*/,
+                                   const char* /*func_name*/) noexcept {
+  g_messages.push_back({level, message});
+  return nullptr;
+}
+
+OrtStatus* ORT_API_CALL GetLoggingSeverityLevel(const OrtLogger* /*logger*/, OrtLoggingLevel* level) noexcept {
+  if (g_fail_severity_query) {
+    return Ort::GetApi().CreateStatus(ORT_FAIL, "no severity");
+  }
+  *level = g_logger_severity;
+  return nullptr;
+}
+
+// Streams as a marker and counts how often a message was formatted
+struct FormatCounter {
+  int* count;
+};
+
+std::ostream& operator<<(std::ostream& os, const FormatCounter& counter) {
+  ++*counter.count;
+  return os << "formatted";
+}
+
+class EpLoggingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const OrtApi* ort_api = OrtGetApiBase()->GetApi(ORT_API_VERSION);
+    Ort::InitApi(ort_api);
+
+    // The real API with the logger entry points replaced, so the test sees what the EP hands to ORT
+    api_ = *ort_api;
+    api_.Logger_LogMessage = LogMessage;
+    api_.Logger_GetLoggingSeverityLevel = GetLoggingSeverityLevel;
+
+    g_messages.clear();
+    g_logger_severity = ORT_LOGGING_LEVEL_WARNING;
+    g_fail_severity_query = false;
+    hipdnn_ep::g_min_log_severity = kInitialSeverity;
+  }
+
+  void TearDown() override { hipdnn_ep::g_min_log_severity = kInitialSeverity; }
+
+  const OrtLogger& Logger() const { return *reinterpret_cast<const OrtLogger*>(&logger_storage_); }
+
+  OrtApi api_{};
+  int logger_storage_{0};
+};
+
+}  // namespace
+
+TEST_F(EpLoggingTest, WarningsPassBeforeAnyLoggerIsKnown) {
+  EXPECT_EQ(kInitialSeverity, ORT_LOGGING_LEVEL_WARNING);
+
+  int formatted = 0;
+  LOG(api_, Logger(), INFO, "info " << FormatCounter{&formatted});
+  LOG(api_, Logger(), WARNING, "warning " << FormatCounter{&formatted});
+  LOG(api_, Logger(), ERROR, "error " << FormatCounter{&formatted});
+
+  // The INFO message is dropped without being formatted
+  EXPECT_EQ(formatted, 2);
+  ASSERT_EQ(g_messages.size(), 2u);
+  EXPECT_EQ(g_messages[0].level, ORT_LOGGING_LEVEL_WARNING);
+  EXPECT_EQ(g_messages[0].text, "warning formatted");
+  EXPECT_EQ(g_messages[1].level, ORT_LOGGING_LEVEL_ERROR);
+}
+
+TEST_F(EpLoggingTest, VerboseLoggerOpensGate) {
+  g_logger_severity = ORT_LOGGING_LEVEL_VERBOSE;
+  hipdnn_ep::UpdateMinLogSeverity(api_, Logger());
+  EXPECT_EQ(hipdnn_ep::g_min_log_severity.load(), ORT_LOGGING_LEVEL_VERBOSE);
+
+  LOG(api_, Logger(), VERBOSE, "verbose");
+  ASSERT_EQ(g_messages.size(), 1u);
+  EXPECT_EQ(g_messages[0].level, ORT_LOGGING_LEVEL_VERBOSE);
+}
+
+TEST_F(EpLoggingTest, GateFollowsMostVerboseLogger) {
+  g_logger_severity = ORT_LOGGING_LEVEL_INFO;
+  hipdnn_ep::UpdateMinLogSeverity(api_, Logger());
+  EXPECT_EQ(hipdnn_ep::g_min_log_severity.load(), ORT_LOGGING_LEVEL_INFO);
+
+  // A quieter session logger doesn't hide messages the earlier one wants
+  g_logger_severity = ORT_LOGGING_LEVEL_ERROR;
+  hipdnn_ep::UpdateMinLogSeverity(api_, Logger());
+  EXPECT_EQ(hipdnn_ep::g_min_log_severity.load(), ORT_LOGGING_LEVEL_INFO);
+
+  LOG(api_, Logger(), VERBOSE, "verbose");
+  LOG(api_, Logger(), INFO, "info");
+  ASSERT_EQ(g_messages.size(), 1u);
+  EXPECT_EQ(g_messages[0].text, "info");
+}
+
+TEST_F(EpLoggingTest, UnknownLoggerSeverityOpensGate) {
+  // Without the logger's severity, nothing may be filtered on the EP side
+  g_fail_severity_query = true;
+  hipdnn_ep::UpdateMinLogSeverity(api_, Logger());
+  EXPECT_EQ(hipdnn_ep::g_min_log_severity.load(), ORT_LOGGING_LEVEL_VERBOSE);
+}
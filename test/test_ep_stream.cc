@@ -0,0 +1,173 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone HipSyncStream tests: notifications order consumers after the producer's work, and the
+// session stream is lent to one HipSyncStream at a time
+
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "hipdnn_ep/ep_stream.h"
+
+namespace {
+
+// Host function that holds up its stream until `open` is set
+struct StreamGate {
+  std::atomic<bool> reached{false};
+  std::atomic<bool> open{false};
+
+  static void Wait(void* data) {
+    auto* gate = static_cast<StreamGate*>(data);
+    gate->reached = true;
+    while (!gate->open) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+// Host function that sets a flag, marking how far its stream got
+void SetFlag(void* data) {
+  *static_cast<std::atomic<bool>*>(data) = true;
+}
+
+// Host function that copies the producer's flag at the point its own stream reaches it
+struct FlagObserver {
+  const std::atomic<bool>* flag = nullptr;
+  std::atomic<bool> seen{false};
+  std::atomic<bool> ran{false};
+
+  static void Observe(void* data) {
+    auto* observer = static_cast<FlagObserver*>(data);
+    observer->seen = observer->flag->load();
+    observer->ran = true;
+  }
+};
+
+class EpStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int device_count = 0;
+    if (hipGetDeviceCount(&device_count) != hipSuccess || device_count == 0) {
+      GTEST_SKIP() << "No HIP device found";
+    }
+    const OrtApi& ort_api = *OrtGetApiBase()->GetApi(ORT_API_VERSION);
+    api_ptrs_ = std::make_unique<hipdnn_ep::ApiPtrs>(
+        hipdnn_ep::ApiPtrs{ort_api, *ort_api.GetEpApi(), *ort_api.GetModelEditorApi()});
+    ASSERT_EQ(hipdnn_ep::HipSyncStream::Create(*api_ptrs_, 0, &stream_), nullptr);
+  }
+
+  void TearDown() override {
+    if (notification_ != nullptr) {
+      notification_->Release(notification_);
+    }
+    if (stream_ != nullptr) {
+      stream_->Release(stream_);
+    }
+  }
+
+  hipStream_t HipStream() const { return static_cast<hipStream_t>(stream_->GetHandle(stream_)); }
+
+  std::unique_ptr<hipdnn_ep::ApiPtrs> api_ptrs_;
+  OrtSyncStreamImpl* stream_{nullptr};
+  OrtSyncNotificationImpl* notification_{nullptr};
+};
+
+}  // namespace
+
+TEST_F(EpStreamTest, DeviceWaitOrdersConsumerAfterProducer) {
+  StreamGate gate;
+  std::atomic<bool> produced{false};
+  ASSERT_EQ(hipLaunchHostFunc(HipStream(), StreamGate::Wait, &gate), hipSuccess);
+  ASSERT_EQ(hipLaunchHostFunc(HipStream(), SetFlag, &produced), hipSuccess);
+
+  ASSERT_EQ(stream_->CreateNotification(stream_, &notification_), nullptr);
+  ASSERT_EQ(notification_->Activate(notification_), nullptr);
+
+  // Without a consumer stream the wait lands on the null stream. The producer stream is non-blocking, so only
+  // the event orders the observer after the producer's work.
+  ASSERT_EQ(notification_->WaitOnDevice(notification_, nullptr), nullptr);
+  FlagObserver observer;
+  observer.flag = &produced;
+  ASSERT_EQ(hipLaunchHostFunc(nullptr, FlagObserver::Observe, &observer), hipSuccess);
+
+  // Waiting on the device must not block the host, and the observer stays queued while the producer is held
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+  while (!observer.ran && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(observer.ran);
+  gate.open = true;
+  ASSERT_EQ(hipStreamSynchronize(nullptr), hipSuccess);
+  EXPECT_TRUE(observer.seen);
+}
+
+TEST_F(EpStreamTest, HostWaitReturnsAfterProducerWork) {
+  StreamGate gate;
+  std::atomic<bool> produced{false};
+  ASSERT_EQ(hipLaunchHostFunc(HipStream(), StreamGate::Wait, &gate), hipSuccess);
+  ASSERT_EQ(hipLaunchHostFunc(HipStream(), SetFlag, &produced), hipSuccess);
+
+  ASSERT_EQ(stream_->CreateNotification(stream_, &notification_), nullptr);
+  ASSERT_EQ(notification_->Activate(notification_), nullptr);
+
+  // Work enqueued after Activate is not part of what the notification waits for
+  StreamGate later_gate;
+  ASSERT_EQ(hipLaunchHostFunc(HipStream(), StreamGate::Wait, &later_gate), hipSuccess);
+
+  std::thread opener([&] {
+    while (!gate.reached) {
+      std::this_thread::yield();
+    }
+    gate.open = true;
+  });
+  EXPECT_EQ(notification_->WaitOnHost(notification_), nullptr);
+  EXPECT_TRUE(produced);
+  opener.join();
+
+  later_gate.open = true;
+}
+
+TEST_F(EpStreamTest, SessionRunEndWaitsForStream) {
+  StreamGate gate;
+  std::atomic<bool> done{false};
+  ASSERT_EQ(hipLaunchHostFunc(HipStream(), StreamGate::Wait, &gate), hipSuccess);
+  ASSERT_EQ(hipLaunchHostFunc(HipStream(), SetFlag, &done), hipSuccess);
+
+  std::thread opener([&] {
+    while (!gate.reached) {
+      std::this_thread::yield();
+    }
+    gate.open = true;
+  });
+
+  // Run outputs must be complete when ORT's Run returns
+  EXPECT_EQ(stream_->OnSessionRunEnd(stream_), nullptr);
+  EXPECT_TRUE(done);
+  opener.join();
+}
+
+TEST_F(EpStreamTest, SessionStreamIsLentOnce) {
+  std::shared_ptr<hipdnn_ep::SessionStream> session_stream;
+  ASSERT_EQ(hipdnn_ep::SessionStream::Create(api_ptrs_->ort_api, 0, session_stream), nullptr);
+
+  ASSERT_TRUE(session_stream->TryLend());
+  EXPECT_FALSE(session_stream->TryLend());
+
+  // The borrowing HipSyncStream runs on the session's stream and hands it back when released
+  OrtSyncStreamImpl* borrowed = hipdnn_ep::HipSyncStream::Borrow(*api_ptrs_, session_stream);
+  EXPECT_EQ(borrowed->GetHandle(borrowed), session_stream->Get());
+  borrowed->Release(borrowed);
+
+  EXPECT_TRUE(session_stream->TryLend());
+  session_stream->Return();
+
+  // Releasing the borrower must not have destroyed the stream
+  std::atomic<bool> done{false};
+  ASSERT_EQ(hipLaunchHostFunc(session_stream->Get(), SetFlag, &done), hipSuccess);
+  ASSERT_EQ(hipStreamSynchronize(session_stream->Get()), hipSuccess);
+  EXPECT_TRUE(done);
+}
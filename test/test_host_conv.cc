@@ -0,0 +1,308 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone HostConvOp tests: the Winograd F(4x4, 3x3) and im2col GEMM paths, forced on every GEMM
+// micro-kernel the CPU supports, match direct summation, and so do the GEMM, Winograd and depthwise paths
+// reading or writing the blocked NCHW16c layout with channel counts off the block
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "hipdnn_ep/host_conv_op.h"
+#include "hipdnn_ep/host_layout.h"
+
+namespace {
+
+using hipdnn_ep::Activation;
+
+constexpr int64_t kBlock = hipdnn_ep::kHostBlockChannels;
+
+// A 2D Conv; pads are {top, left, bottom, right}
+struct ConvProblem {
+  const char* name;
+  std::vector<int64_t> x_shape;
+  int64_t c_out;
+  std::vector<int64_t> pads;
+  int64_t group{1};
+  bool has_bias{false};
+  Activation::Kind activation{Activation::Kind::kNone};
+  bool constant_weights{false};
+};
+
+std::vector<float> RandomValues(size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> values(count);
+  for (float& value : values) {
+    value = dist(rng);
+  }
+  return values;
+}
+
+int64_t ElementCount(const std::vector<int64_t>& shape) {
+  int64_t count = 1;
+  for (int64_t dim : shape) {
+    count *= dim;
+  }
+  return count;
+}
+
+// Plain NCHW to NCHW16c, with NaN in the padding lanes past the last channel: no op may read them into a
+// real channel
+std::vector<float> ToBlocked(const std::vector<float>& plain, const std::vector<int64_t>& shape) {
+  const int64_t channels = shape[1];
+  const int64_t plane = ElementCount(shape) / (shape[0] * channels);
+  const int64_t blocks = (channels + kBlock - 1) / kBlock;
+  std::vector<float> blocked(static_cast<size_t>(shape[0] * blocks * kBlock * plane), std::nanf(""));
+  for (int64_t n = 0; n < shape[0]; ++n) {
+    for (int64_t c = 0; c < channels; ++c) {
+      for (int64_t p = 0; p < plane; ++p) {
+        blocked[((n * blocks + c / kBlock) * plane + p) * kBlock + c % kBlock] = plain[(n * channels + c) * plane + p];
+      }
+    }
+  }
+  return blocked;
+}
+
+std::vector<float> FromBlocked(const std::vector<float>& blocked, const std::vector<int64_t>& shape) {
+  const int64_t channels = shape[1];
+  const int64_t plane = ElementCount(shape) / (shape[0] * channels);
+  const int64_t blocks = (channels + kBlock - 1) / kBlock;
+  std::vector<float> plain(static_cast<size_t>(ElementCount(shape)));
+  for (int64_t n = 0; n < shape[0]; ++n) {
+    for (int64_t c = 0; c < channels; ++c) {
+      for (int64_t p = 0; p < plane; ++p) {
+        plain[(n * channels + c) * plane + p] = blocked[((n * blocks + c / kBlock) * plane + p) * kBlock + c % kBlock];
+      }
+    }
+  }
+  return plain;
+}
+
+class HostConvTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Ort::InitApi(OrtGetApiBase()->GetApi(ORT_API_VERSION)); }
+
+  // Runs a 3x3 stride-1 Conv of `problem` with `overrides` and returns Y. X and Y are handed to the op in the
+  // blocked layout when `x_blocked` and `y_blocked` say so; the result is plain either way.
+  std::vector<float> Run(const ConvProblem& problem, const hipdnn_ep::HostConvOverrides& overrides,
+                         bool x_blocked = false, bool y_blocked = false) {
+    auto info = std::make_unique<hipdnn_ep::ConvOpInfo>();
+    info->op_type = "Conv";
+    info->node_name = problem.name;
+    info->x_shape = problem.x_shape;
+    info->w_shape = {problem.c_out, problem.x_shape[1] / problem.group, 3, 3};
+    info->y_shape = {problem.x_shape[0], problem.c_out, problem.x_shape[2] + problem.pads[0] + problem.pads[2] - 2,
+                     problem.x_shape[3] + problem.pads[1] + problem.pads[3] - 2};
+    info->pads = problem.pads;
+    info->strides = {1, 1};
+    info->dilations = {1, 1};
+    info->output_padding = {0, 0};
+    info->group = problem.group;
+    info->has_bias = problem.has_bias;
+    info->activation.kind = problem.activation;
+
+    const std::vector<float> x = RandomValues(static_cast<size_t>(ElementCount(info->x_shape)), 1);
+    const std::vector<float> w = RandomValues(static_cast<size_t>(ElementCount(info->w_shape)), 2);
+    const std::vector<float> b = RandomValues(static_cast<size_t>(problem.c_out), 3);
+    if (problem.constant_weights) {
+      info->constant_weights = w;
+      info->constant_bias = problem.has_bias ? b : std::vector<float>(b.size(), 0.0f);
+    }
+    const std::vector<int64_t> x_shape = info->x_shape;
+    const std::vector<int64_t> y_shape = info->y_shape;
+    std::vector<float> y(static_cast<size_t>(ElementCount(y_shape)), std::nanf(""));
+    if (y_blocked) {
+      y = ToBlocked(y, y_shape);
+    }
+
+    hipdnn_ep::HostConvOp op(Ort::GetApi(), Logger(), std::move(info), thread_pool_);
+    Ort::Status status(op.Compile(overrides));
+    EXPECT_TRUE(status.IsOK()) << status.GetErrorMessage();
+    if (!status.IsOK()) {
+      return {};
+    }
+    EXPECT_EQ(op.GetAlgo(), *overrides.algo);
+    if (x_blocked || y_blocked) {
+      EXPECT_EQ(op.SupportsBlockedLayout(), hipdnn_ep::BlockedLayoutSupport::kIndependent);
+      op.UseBlockedLayout(x_blocked, y_blocked);
+    }
+
+    std::vector<float> workspace(op.WorkspaceSize() / sizeof(float));
+    hipdnn_ep::ExecutionContext ctx;
+    ctx.workspace = workspace.data();
+    const std::vector<float> x_input = x_blocked ? ToBlocked(x, x_shape) : x;
+    status = Ort::Status(
+        op.Execute(ctx, {x_input.data(), w.data(), problem.has_bias ? b.data() : nullptr}, {y.data()}));
+    EXPECT_TRUE(status.IsOK()) << status.GetErrorMessage();
+    return y_blocked ? FromBlocked(y, y_shape) : y;
+  }
+
+  // Only verbose tracing uses the logger, and it is off unless a session lowers the severity
+  const OrtLogger& Logger() const { return *reinterpret_cast<const OrtLogger*>(&logger_storage_); }
+
+  int logger_storage_{0};
+  hipdnn_ep::ThreadPool thread_pool_{4};
+};
+
+// Winograd rounds differently from direct summation, by about 1e-5 relative to the largest output
+void ExpectNear(const std::vector<float>& expected, const std::vector<float>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  float largest = 0.0f;
+  for (float value : expected) {
+    largest = std::max(largest, std::fabs(value));
+  }
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_NEAR(expected[i], actual[i], 1e-4f * largest + 1e-5f) << "index " << i;
+  }
+}
+
+const ConvProblem kWinogradProblems[] = {
+    // Outputs that leave partial 4x4 tiles in both dims, channel counts off every mr and nr
+    {"PartialTiles", {1, 5, 13, 11}, 7, {1, 1, 1, 1}},
+    {"Unpadded", {1, 19, 10, 9}, 21, {0, 0, 0, 0}, 1, true},
+    // More output channels than one Winograd accumulator block, and more tiles than one task's block
+    {"ManyChannels", {1, 35, 30, 29}, 150, {1, 1, 1, 1}, 1, true, Activation::Kind::kRelu},
+    {"Grouped", {2, 6, 9, 14}, 10, {1, 1, 1, 1}, 2, true, Activation::Kind::kRelu},
+    // SAME_UPPER on an even extent pads one more at the end
+    {"AsymmetricPads", {1, 9, 12, 10}, 12, {0, 0, 1, 1}, 1, true},
+    {"ConstantWeights", {2, 17, 7, 8}, 9, {1, 1, 1, 1}, 1, true, Activation::Kind::kNone, true},
+};
+
+class HostConvWinogradTest
+    : public HostConvTest,
+      public ::testing::WithParamInterface<std::tuple<hipdnn_ep::GemmMicroKernel, ConvProblem>> {};
+
+struct BlockedProblem {
+  ConvProblem problem;
+  hipdnn_ep::HostConvAlgo algo;
+};
+
+// Channel counts below one block, past a whole one, and groups that start inside a block
+const BlockedProblem kBlockedProblems[] = {
+    {{"GemmPartialBlock", {2, 7, 9, 11}, 20, {1, 1, 1, 1}, 1, true}, hipdnn_ep::HostConvAlgo::kGemm},
+    {{"GemmGrouped", {1, 24, 8, 10}, 36, {1, 1, 1, 1}, 2, true, Activation::Kind::kRelu},
+     hipdnn_ep::HostConvAlgo::kGemm},
+    {{"WinogradPartialBlock", {1, 33, 10, 9}, 5, {0, 0, 1, 1}, 1, true}, hipdnn_ep::HostConvAlgo::kWinograd},
+    {{"WinogradGrouped", {2, 20, 9, 14}, 12, {1, 1, 1, 1}, 4, true, Activation::Kind::kRelu},
+     hipdnn_ep::HostConvAlgo::kWinograd},
+    {{"DepthwiseBelowBlock", {2, 7, 12, 13}, 7, {1, 1, 1, 1}, 7, true}, hipdnn_ep::HostConvAlgo::kDepthwise},
+    {{"DepthwisePartialBlock", {1, 20, 9, 19}, 20, {1, 1, 1, 1}, 20, true, Activation::Kind::kRelu},
+     hipdnn_ep::HostConvAlgo::kDepthwise},
+    {{"DepthwiseConstantWeights", {1, 35, 6, 8}, 35, {0, 0, 1, 1}, 35, true, Activation::Kind::kNone, true},
+     hipdnn_ep::HostConvAlgo::kDepthwise},
+};
+
+struct LayoutCase {
+  const char* name;
+  bool x_blocked;
+  bool y_blocked;
+};
+
+const LayoutCase kBlockedLayouts[] = {
+    {"BlockedIn", true, false},
+    {"BlockedOut", false, true},
+    {"BlockedInOut", true, true},
+};
+
+class HostConvBlockedLayoutTest
+    : public HostConvTest,
+      public ::testing::WithParamInterface<std::tuple<BlockedProblem, LayoutCase>> {};
+
+}  // namespace
+
+TEST_P(HostConvWinogradTest, MatchesDirectAndGemm) {
+  const hipdnn_ep::GemmMicroKernel& kernel = std::get<0>(GetParam());
+  const ConvProblem& problem = std::get<1>(GetParam());
+
+  const std::vector<float> direct = Run(problem, {hipdnn_ep::HostConvAlgo::kDirect, &kernel});
+  const std::vector<float> gemm = Run(problem, {hipdnn_ep::HostConvAlgo::kGemm, &kernel});
+  const std::vector<float> winograd = Run(problem, {hipdnn_ep::HostConvAlgo::kWinograd, &kernel});
+  ASSERT_FALSE(direct.empty());
+  ExpectNear(direct, gemm);
+  ExpectNear(direct, winograd);
+}
+
+TEST_F(HostConvTest, WinogradRejectsOtherKernels) {
+  auto info = std::make_unique<hipdnn_ep::ConvOpInfo>();
+  info->op_type = "Conv";
+  info->node_name = "Strided";
+  info->x_shape = {1, 4, 8, 8};
+  info->w_shape = {4, 4, 3, 3};
+  info->y_shape = {1, 4, 4, 4};
+  info->pads = {1, 1, 1, 1};
+  info->strides = {2, 2};
+  info->dilations = {1, 1};
+  info->output_padding = {0, 0};
+
+  hipdnn_ep::HostConvOp op(Ort::GetApi(), Logger(), std::move(info), thread_pool_);
+  hipdnn_ep::HostConvOverrides overrides;
+  overrides.algo = hipdnn_ep::HostConvAlgo::kWinograd;
+  Ort::Status status(op.Compile(overrides));
+  EXPECT_FALSE(status.IsOK());
+}
+
+// Every kernel the algorithm can run on, so the 8-lane depthwise kernels cover a block in two passes
+TEST_P(HostConvBlockedLayoutTest, MatchesPlainDirect) {
+  const BlockedProblem& blocked = std::get<0>(GetParam());
+  const LayoutCase& layout = std::get<1>(GetParam());
+
+  const std::vector<float> direct = Run(blocked.problem, {hipdnn_ep::HostConvAlgo::kDirect});
+  ASSERT_FALSE(direct.empty());
+  hipdnn_ep::HostConvOverrides overrides;
+  overrides.algo = blocked.algo;
+  if (blocked.algo == hipdnn_ep::HostConvAlgo::kDepthwise) {
+    for (const auto& kernel : hipdnn_ep::GetDepthwiseKernels()) {
+      SCOPED_TRACE(kernel.isa);
+      overrides.depthwise = &kernel;
+      ExpectNear(direct, Run(blocked.problem, overrides, layout.x_blocked, layout.y_blocked));
+    }
+  } else {
+    for (const auto& kernel : hipdnn_ep::GetGemmMicroKernels()) {
+      SCOPED_TRACE(kernel.isa);
+      overrides.gemm = &kernel;
+      ExpectNear(direct, Run(blocked.problem, overrides, layout.x_blocked, layout.y_blocked));
+    }
+  }
+}
+
+TEST_F(HostConvTest, DirectLoopsStayPlain) {
+  auto info = std::make_unique<hipdnn_ep::ConvOpInfo>();
+  info->op_type = "Conv";
+  info->node_name = "Direct";
+  info->x_shape = {1, 4, 8, 8};
+  info->w_shape = {4, 4, 3, 3};
+  info->y_shape = {1, 4, 8, 8};
+  info->pads = {1, 1, 1, 1};
+  info->strides = {1, 1};
+  info->dilations = {1, 1};
+  info->output_padding = {0, 0};
+
+  hipdnn_ep::HostConvOp op(Ort::GetApi(), Logger(), std::move(info), thread_pool_);
+  hipdnn_ep::HostConvOverrides overrides;
+  overrides.algo = hipdnn_ep::HostConvAlgo::kDirect;
+  Ort::Status status(op.Compile(overrides));
+  ASSERT_TRUE(status.IsOK()) << status.GetErrorMessage();
+  EXPECT_EQ(op.SupportsBlockedLayout(), hipdnn_ep::BlockedLayoutSupport::kNone);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SupportedIsas, HostConvWinogradTest,
+    ::testing::Combine(::testing::ValuesIn(hipdnn_ep::GetGemmMicroKernels()), ::testing::ValuesIn(kWinogradProblems)),
+    [](const ::testing::TestParamInfo<HostConvWinogradTest::ParamType>& info) {
+      return std::string(std::get<0>(info.param).isa) + "_" + std::get<1>(info.param).name;
+    });
+
+INSTANTIATE_TEST_SUITE_P(
+    Layouts, HostConvBlockedLayoutTest,
+    ::testing::Combine(::testing::ValuesIn(kBlockedProblems), ::testing::ValuesIn(kBlockedLayouts)),
+    [](const ::testing::TestParamInfo<HostConvBlockedLayoutTest::ParamType>& info) {
+      return std::string(std::get<0>(info.param).problem.name) + "_" + std::get<1>(info.param).name;
+    });
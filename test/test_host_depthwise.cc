@@ -0,0 +1,200 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone host depthwise tests: every row kernel the CPU supports matches a scalar stencil over output
+// widths off its tile, several kernel sizes, strides and dilations, and propagates NaN through the clamp
+// like the portable kernel
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hipdnn_ep/host_depthwise.h"
+#include "hipdnn_ep/host_layout.h"
+
+namespace {
+
+constexpr int64_t kBlock = hipdnn_ep::kHostBlockChannels;
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+struct StencilProblem {
+  int64_t width;
+  int64_t kh;
+  int64_t kw;
+  int64_t stride_w;
+  int64_t dilation_h;
+  int64_t dilation_w;
+  float lower;
+  float upper;
+
+  std::string Name() const {
+    return "width=" + std::to_string(width) + " k=" + std::to_string(kh) + "x" + std::to_string(kw) +
+           " stride=" + std::to_string(stride_w) + " dilation=" + std::to_string(dilation_h) + "x" +
+           std::to_string(dilation_w) + " clamp=[" + std::to_string(lower) + ", " + std::to_string(upper) + "]";
+  }
+};
+
+// Input, weights and bias of one block of kBlock channels, laid out as DepthwiseRowArgs expects
+struct StencilData {
+  int64_t x_row_stride;
+  std::vector<float> x;
+  std::vector<float> w;
+  std::vector<float> bias;
+};
+
+std::vector<float> RandomValues(size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> values(count);
+  for (float& value : values) {
+    value = dist(rng);
+  }
+  return values;
+}
+
+StencilData MakeData(const StencilProblem& problem, uint32_t seed) {
+  const int64_t x_cols = (problem.width - 1) * problem.stride_w + (problem.kw - 1) * problem.dilation_w + 1;
+  const int64_t x_rows = (problem.kh - 1) * problem.dilation_h + 1;
+  StencilData data;
+  data.x_row_stride = x_cols * kBlock;
+  data.x = RandomValues(static_cast<size_t>(x_rows * data.x_row_stride), seed);
+  data.w = RandomValues(static_cast<size_t>(problem.kh * problem.kw * kBlock), seed + 1);
+  data.bias = RandomValues(static_cast<size_t>(kBlock), seed + 2);
+  return data;
+}
+
+// Scalar stencil, clamped like the portable kernel
+std::vector<float> ReferenceRow(const StencilProblem& problem, const StencilData& data) {
+  std::vector<float> y(static_cast<size_t>(problem.width * kBlock));
+  for (int64_t ow = 0; ow < problem.width; ++ow) {
+    for (int64_t c = 0; c < kBlock; ++c) {
+      double sum = data.bias[c];
+      for (int64_t r = 0; r < problem.kh; ++r) {
+        for (int64_t s = 0; s < problem.kw; ++s) {
+          const int64_t col = ow * problem.stride_w + s * problem.dilation_w;
+          sum += static_cast<double>(data.w[(r * problem.kw + s) * kBlock + c]) *
+                 data.x[r * problem.dilation_h * data.x_row_stride + col * kBlock + c];
+        }
+      }
+      y[ow * kBlock + c] = std::min(std::max(static_cast<float>(sum), problem.lower), problem.upper);
+    }
+  }
+  return y;
+}
+
+// One row on `kernel`, a call per `kernel.lanes` channels of the block as the host convolution does
+std::vector<float> KernelRow(const hipdnn_ep::DepthwiseKernel& kernel, const StencilProblem& problem,
+                             const StencilData& data) {
+  std::vector<float> y(static_cast<size_t>(problem.width * kBlock), std::numeric_limits<float>::quiet_NaN());
+  for (int64_t l0 = 0; l0 < kBlock; l0 += kernel.lanes) {
+    hipdnn_ep::DepthwiseRowArgs args;
+    args.x = data.x.data() + l0;
+    args.x_row_stride = data.x_row_stride;
+    args.w = data.w.data() + l0;
+    args.bias = data.bias.data() + l0;
+    args.y = y.data() + l0;
+    args.position_stride = kBlock;
+    args.width = problem.width;
+    args.kh = problem.kh;
+    args.kw = problem.kw;
+    args.stride_w = problem.stride_w;
+    args.dilation_h = problem.dilation_h;
+    args.dilation_w = problem.dilation_w;
+    args.lower = problem.lower;
+    args.upper = problem.upper;
+    kernel.fn(args);
+  }
+  return y;
+}
+
+// NaN must match NaN; everything else within rounding of the sum
+void ExpectNear(const std::vector<float>& expected, const std::vector<float>& actual, const std::string& problem) {
+  ASSERT_EQ(expected.size(), actual.size()) << problem;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (std::isnan(expected[i])) {
+      ASSERT_TRUE(std::isnan(actual[i])) << problem << ", index " << i << " is " << actual[i];
+    } else {
+      ASSERT_NEAR(expected[i], actual[i], 1e-4f) << problem << ", index " << i;
+    }
+  }
+}
+
+class HostDepthwiseKernelTest : public ::testing::TestWithParam<hipdnn_ep::DepthwiseKernel> {};
+
+}  // namespace
+
+TEST(HostDepthwiseTest, KernelsEndWithPortableOne) {
+  const std::vector<hipdnn_ep::DepthwiseKernel>& kernels = hipdnn_ep::GetDepthwiseKernels();
+  ASSERT_FALSE(kernels.empty());
+  EXPECT_EQ(hipdnn_ep::GetDepthwiseKernel().fn, kernels.front().fn);
+  EXPECT_EQ(std::string(kernels.back().isa), "generic");
+  for (const auto& kernel : kernels) {
+    EXPECT_EQ(kBlock % kernel.lanes, 0) << kernel.isa;
+  }
+}
+
+TEST_P(HostDepthwiseKernelTest, MatchesReferenceWithRemainders) {
+  const hipdnn_ep::DepthwiseKernel& kernel = GetParam();
+  uint32_t seed = 1;
+  // 3x3 and 5x5 take the unrolled paths, the others the generic loop; widths fall on both sides of the
+  // 8-output and 4-output tiles
+  const int64_t kernel_sizes[][2] = {{3, 3}, {5, 5}, {1, 1}, {3, 5}, {7, 7}};
+  for (const auto& size : kernel_sizes) {
+    for (int64_t width : {1, 3, 7, 8, 9, 17, 30}) {
+      for (int64_t stride : {1, 2}) {
+        for (int64_t dilation : {1, 2}) {
+          const StencilProblem problem{width, size[0], size[1], stride, dilation, dilation, -kInfinity, kInfinity};
+          const StencilData data = MakeData(problem, seed);
+          seed += 3;
+          ExpectNear(ReferenceRow(problem, data), KernelRow(kernel, problem, data), problem.Name());
+        }
+      }
+    }
+  }
+}
+
+TEST_P(HostDepthwiseKernelTest, ClampsToReluAndClip) {
+  const hipdnn_ep::DepthwiseKernel& kernel = GetParam();
+  const float bounds[][2] = {{0.0f, kInfinity}, {-0.5f, 0.25f}};
+  for (const auto& bound : bounds) {
+    for (int64_t width : {5, 19}) {
+      const StencilProblem problem{width, 3, 3, 1, 1, 1, bound[0], bound[1]};
+      const StencilData data = MakeData(problem, static_cast<uint32_t>(width));
+      ExpectNear(ReferenceRow(problem, data), KernelRow(kernel, problem, data), problem.Name());
+    }
+  }
+}
+
+TEST_P(HostDepthwiseKernelTest, PropagatesNaNLikeGenericKernel) {
+  const hipdnn_ep::DepthwiseKernel& kernel = GetParam();
+  const hipdnn_ep::DepthwiseKernel& generic = hipdnn_ep::GetDepthwiseKernels().back();
+
+  // A clamp on either side, and none; the widths cover the tiled loop and the remainder loop
+  const float bounds[][2] = {{0.0f, kInfinity}, {-0.5f, 0.25f}, {-kInfinity, kInfinity}};
+  for (const auto& bound : bounds) {
+    for (int64_t width : {3, 13}) {
+      for (int64_t kh : {3, 5, 2}) {
+        const StencilProblem problem{width, kh, kh, 1, 1, 1, bound[0], bound[1]};
+        StencilData data = MakeData(problem, static_cast<uint32_t>(width * kh));
+        for (size_t i = 0; i < data.x.size(); i += 37) {
+          data.x[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+
+        const std::vector<float> expected = KernelRow(generic, problem, data);
+        ASSERT_TRUE(std::any_of(expected.begin(), expected.end(), [](float v) { return std::isnan(v); }))
+            << problem.Name();
+        ExpectNear(expected, KernelRow(kernel, problem, data), problem.Name());
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SupportedIsas, HostDepthwiseKernelTest, ::testing::ValuesIn(hipdnn_ep::GetDepthwiseKernels()),
+                         [](const ::testing::TestParamInfo<hipdnn_ep::DepthwiseKernel>& info) {
+                           return std::string(info.param.isa);
+                         });
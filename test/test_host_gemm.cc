@@ -0,0 +1,149 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone host GEMM tests: every micro-kernel the CPU supports, fed A through PackGemmAPanels and B as
+// nr-wide panels, matches a scalar GEMM, also when M, N and K are not multiples of its block
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hipdnn_ep/host_gemm.h"
+
+namespace {
+
+std::vector<float> RandomValues(size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> values(count);
+  for (float& value : values) {
+    value = dist(rng);
+  }
+  return values;
+}
+
+// Row-major C [m, n] = A [m, k] * B [k, n]
+std::vector<float> ReferenceGemm(int64_t m, int64_t n, int64_t k, const std::vector<float>& a,
+                                 const std::vector<float>& b) {
+  std::vector<float> c(static_cast<size_t>(m * n));
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      double sum = 0.0;
+      for (int64_t p = 0; p < k; ++p) {
+        sum += static_cast<double>(a[i * k + p]) * b[p * n + j];
+      }
+      c[i * n + j] = static_cast<float>(sum);
+    }
+  }
+  return c;
+}
+
+// Packs row-major B [k, n] into zero padded panels of `nr` columns: panel q is `k` steps of nr values
+std::vector<float> PackBPanels(int64_t nr, int64_t n, int64_t k, const std::vector<float>& b) {
+  const int64_t panels = (n + nr - 1) / nr;
+  std::vector<float> packed(static_cast<size_t>(panels * nr * k), 0.0f);
+  for (int64_t q = 0; q < panels; ++q) {
+    for (int64_t p = 0; p < k; ++p) {
+      for (int64_t j = 0; j < nr && q * nr + j < n; ++j) {
+        packed[(q * k + p) * nr + j] = b[p * n + q * nr + j];
+      }
+    }
+  }
+  return packed;
+}
+
+// C = A * B on `kernel`, blocked like the host convolution: K in blocks of at most `kc`, the first block
+// overwriting C and the others accumulating into it
+std::vector<float> KernelGemm(const hipdnn_ep::GemmMicroKernel& kernel, int64_t m, int64_t n, int64_t k, int64_t kc,
+                              const std::vector<float>& a, const std::vector<float>& b) {
+  const int64_t mr = kernel.mr;
+  const int64_t nr = kernel.nr;
+  std::vector<float> packed_a(hipdnn_ep::PackedGemmASize(kernel, m, k));
+  hipdnn_ep::PackGemmAPanels(kernel, m, k, a.data(), k, packed_a.data());
+  const std::vector<float> packed_b = PackBPanels(nr, n, k, b);
+
+  // Whole blocks are written, so C is padded to them; NaN shows any element the first block doesn't overwrite
+  const int64_t m_panels = (m + mr - 1) / mr;
+  const int64_t n_panels = (n + nr - 1) / nr;
+  const int64_t ldc = n_panels * nr;
+  std::vector<float> c(static_cast<size_t>(m_panels * mr * ldc), std::numeric_limits<float>::quiet_NaN());
+  for (int64_t ip = 0; ip < m_panels; ++ip) {
+    for (int64_t jq = 0; jq < n_panels; ++jq) {
+      for (int64_t k0 = 0; k0 < k; k0 += kc) {
+        kernel.fn(std::min(kc, k - k0), packed_a.data() + (ip * k + k0) * mr, packed_b.data() + (jq * k + k0) * nr,
+                  c.data() + ip * mr * ldc + jq * nr, ldc, k0 > 0);
+      }
+    }
+  }
+
+  std::vector<float> result(static_cast<size_t>(m * n));
+  for (int64_t i = 0; i < m; ++i) {
+    std::copy(c.begin() + i * ldc, c.begin() + i * ldc + n, result.begin() + i * n);
+  }
+  return result;
+}
+
+void ExpectNear(const std::vector<float>& expected, const std::vector<float>& actual, float tolerance,
+                const std::string& problem) {
+  ASSERT_EQ(expected.size(), actual.size()) << problem;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_NEAR(expected[i], actual[i], tolerance) << problem << ", index " << i;
+  }
+}
+
+class HostGemmMicroKernelTest : public ::testing::TestWithParam<hipdnn_ep::GemmMicroKernel> {};
+
+}  // namespace
+
+TEST(HostGemmTest, KernelsEndWithPortableOne) {
+  const std::vector<hipdnn_ep::GemmMicroKernel>& kernels = hipdnn_ep::GetGemmMicroKernels();
+  ASSERT_FALSE(kernels.empty());
+  EXPECT_EQ(hipdnn_ep::GetGemmMicroKernel().fn, kernels.front().fn);
+  EXPECT_EQ(std::string(kernels.back().isa), "generic");
+
+  // Stack buffers hold one block, and the Winograd transforms run 8 lanes at a time
+  for (const auto& kernel : kernels) {
+    EXPECT_LE(kernel.mr, hipdnn_ep::kGemmMaxMr) << kernel.isa;
+    EXPECT_LE(kernel.nr, hipdnn_ep::kGemmMaxNr) << kernel.isa;
+    EXPECT_EQ(kernel.nr % 8, 0) << kernel.isa;
+  }
+}
+
+TEST_P(HostGemmMicroKernelTest, MatchesReferenceWithRemainders) {
+  const hipdnn_ep::GemmMicroKernel& kernel = GetParam();
+  const int64_t mr = kernel.mr;
+  const int64_t nr = kernel.nr;
+  uint32_t seed = 1;
+  for (int64_t m : {int64_t{1}, mr - 1, mr, mr + 1, 3 * mr + 2}) {
+    for (int64_t n : {int64_t{1}, nr - 1, nr, 2 * nr + 3}) {
+      for (int64_t k : {1, 5, 37}) {
+        const std::vector<float> a = RandomValues(static_cast<size_t>(m * k), seed++);
+        const std::vector<float> b = RandomValues(static_cast<size_t>(k * n), seed++);
+        ExpectNear(ReferenceGemm(m, n, k, a, b), KernelGemm(kernel, m, n, k, k, a, b), 1e-4f,
+                   "m=" + std::to_string(m) + " n=" + std::to_string(n) + " k=" + std::to_string(k));
+      }
+    }
+  }
+}
+
+TEST_P(HostGemmMicroKernelTest, AccumulatesAcrossKBlocks) {
+  const hipdnn_ep::GemmMicroKernel& kernel = GetParam();
+  const int64_t m = 2 * kernel.mr + 1;
+  const int64_t n = kernel.nr + 3;
+
+  // Two full blocks of 128 and a short one of 44
+  const int64_t k = 300;
+  const std::vector<float> a = RandomValues(static_cast<size_t>(m * k), 101);
+  const std::vector<float> b = RandomValues(static_cast<size_t>(k * n), 102);
+  ExpectNear(ReferenceGemm(m, n, k, a, b), KernelGemm(kernel, m, n, k, 128, a, b), 1e-3f, "kc=128");
+}
+
+INSTANTIATE_TEST_SUITE_P(SupportedIsas, HostGemmMicroKernelTest,
+                         ::testing::ValuesIn(hipdnn_ep::GetGemmMicroKernels()),
+                         [](const ::testing::TestParamInfo<hipdnn_ep::GemmMicroKernel>& info) {
+                           return std::string(info.param.isa);
+                         });
@@ -0,0 +1,110 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone MIOpenHandlePool tests: handles are reused per stream and rebound when another stream needs one
+
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <miopen/miopen.h>
+
+#include "hipdnn_ep/miopen_handle_pool.h"
+
+namespace {
+
+class MIOpenHandlePoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int device_count = 0;
+    if (hipGetDeviceCount(&device_count) != hipSuccess || device_count == 0) {
+      GTEST_SKIP() << "No HIP device found";
+    }
+    ASSERT_EQ(hipStreamCreateWithFlags(&stream_a_, hipStreamNonBlocking), hipSuccess);
+    ASSERT_EQ(hipStreamCreateWithFlags(&stream_b_, hipStreamNonBlocking), hipSuccess);
+  }
+
+  void TearDown() override {
+    if (stream_a_ != nullptr) {
+      hipStreamDestroy(stream_a_);
+    }
+    if (stream_b_ != nullptr) {
+      hipStreamDestroy(stream_b_);
+    }
+  }
+
+  static hipStream_t StreamOf(miopenHandle_t handle) {
+    miopenAcceleratorQueue_t stream = nullptr;
+    EXPECT_EQ(miopenGetStream(handle, &stream), miopenStatusSuccess);
+    return stream;
+  }
+
+  hipdnn_ep::MIOpenHandlePool pool_;
+  hipStream_t stream_a_{nullptr};
+  hipStream_t stream_b_{nullptr};
+};
+
+}  // namespace
+
+TEST_F(MIOpenHandlePoolTest, ReleasedHandleIsReused) {
+  miopenHandle_t first = nullptr;
+  {
+    hipdnn_ep::MIOpenHandlePool::Lease lease;
+    ASSERT_EQ(pool_.Acquire(stream_a_, lease), miopenStatusSuccess);
+    first = lease.Get();
+    EXPECT_EQ(StreamOf(first), stream_a_);
+  }
+
+  hipdnn_ep::MIOpenHandlePool::Lease lease;
+  ASSERT_EQ(pool_.Acquire(stream_a_, lease), miopenStatusSuccess);
+  EXPECT_EQ(lease.Get(), first);
+  EXPECT_EQ(pool_.Size(), 1u);
+}
+
+TEST_F(MIOpenHandlePoolTest, FreeHandleIsReboundToAnotherStream) {
+  miopenHandle_t first = nullptr;
+  {
+    hipdnn_ep::MIOpenHandlePool::Lease lease;
+    ASSERT_EQ(pool_.Acquire(stream_a_, lease), miopenStatusSuccess);
+    first = lease.Get();
+  }
+
+  // No handle is bound to stream_b_, so the free one moves over instead of a new one being created
+  hipdnn_ep::MIOpenHandlePool::Lease lease;
+  ASSERT_EQ(pool_.Acquire(stream_b_, lease), miopenStatusSuccess);
+  EXPECT_EQ(lease.Get(), first);
+  EXPECT_EQ(StreamOf(lease.Get()), stream_b_);
+  EXPECT_EQ(pool_.Size(), 1u);
+}
+
+TEST_F(MIOpenHandlePoolTest, PrefersHandleBoundToSameStream) {
+  miopenHandle_t on_a = nullptr;
+  miopenHandle_t on_b = nullptr;
+  {
+    hipdnn_ep::MIOpenHandlePool::Lease lease_a;
+    hipdnn_ep::MIOpenHandlePool::Lease lease_b;
+    ASSERT_EQ(pool_.Acquire(stream_a_, lease_a), miopenStatusSuccess);
+    ASSERT_EQ(pool_.Acquire(stream_b_, lease_b), miopenStatusSuccess);
+    on_a = lease_a.Get();
+    on_b = lease_b.Get();
+    EXPECT_NE(on_a, on_b);
+  }
+  EXPECT_EQ(pool_.Size(), 2u);
+
+  // Both are free; each stream gets its own back without a rebind
+  hipdnn_ep::MIOpenHandlePool::Lease lease_a;
+  ASSERT_EQ(pool_.Acquire(stream_a_, lease_a), miopenStatusSuccess);
+  EXPECT_EQ(lease_a.Get(), on_a);
+  hipdnn_ep::MIOpenHandlePool::Lease lease_b;
+  ASSERT_EQ(pool_.Acquire(stream_b_, lease_b), miopenStatusSuccess);
+  EXPECT_EQ(lease_b.Get(), on_b);
+  EXPECT_EQ(StreamOf(on_a), stream_a_);
+  EXPECT_EQ(StreamOf(on_b), stream_b_);
+}
+
+TEST_F(MIOpenHandlePoolTest, ConcurrentLeasesOnOneStreamGetDistinctHandles) {
+  hipdnn_ep::MIOpenHandlePool::Lease first;
+  hipdnn_ep::MIOpenHandlePool::Lease second;
+  ASSERT_EQ(pool_.Acquire(stream_a_, first), miopenStatusSuccess);
+  ASSERT_EQ(pool_.Acquire(stream_a_, second), miopenStatusSuccess);
+  EXPECT_NE(first.Get(), second.Get());
+  EXPECT_EQ(pool_.Size(), 2u);
+}
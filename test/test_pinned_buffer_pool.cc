@@ -0,0 +1,130 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone PinnedBufferPool tests: a staging buffer is reused only after the stream work that used it,
+// and the idle cache is trimmed after a burst of large copies
+
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "hipdnn_ep/pinned_buffer_pool.h"
+
+namespace {
+
+// Host function that holds up its stream until `open` is set
+struct StreamGate {
+  std::atomic<bool> reached{false};
+  std::atomic<bool> open{false};
+
+  static void Wait(void* data) {
+    auto* gate = static_cast<StreamGate*>(data);
+    gate->reached = true;
+    while (!gate->open) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+class PinnedBufferPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int device_count = 0;
+    if (hipGetDeviceCount(&device_count) != hipSuccess || device_count == 0) {
+      GTEST_SKIP() << "No HIP device found";
+    }
+    ASSERT_EQ(hipStreamCreateWithFlags(&stream_, hipStreamNonBlocking), hipSuccess);
+  }
+
+  void TearDown() override {
+    if (stream_ != nullptr) {
+      hipStreamSynchronize(stream_);
+      hipStreamDestroy(stream_);
+    }
+  }
+
+  hipdnn_ep::PinnedBufferPool pool_;
+  hipStream_t stream_{nullptr};
+};
+
+}  // namespace
+
+TEST_F(PinnedBufferPoolTest, BufferIsReusedOnlyAfterItsStreamWork) {
+  hipdnn_ep::PinnedBufferPool::Buffer first;
+  ASSERT_EQ(pool_.Acquire(4096, first), hipSuccess);
+  ASSERT_NE(first.ptr, nullptr);
+  EXPECT_TRUE(hipdnn_ep::IsPinnedHostMemory(first.ptr));
+
+  // The stream may still read the buffer, so a request in the meantime gets another one
+  StreamGate gate;
+  ASSERT_EQ(hipLaunchHostFunc(stream_, StreamGate::Wait, &gate), hipSuccess);
+  ASSERT_EQ(pool_.Release(first, stream_), hipSuccess);
+
+  hipdnn_ep::PinnedBufferPool::Buffer second;
+  ASSERT_EQ(pool_.Acquire(4096, second), hipSuccess);
+  EXPECT_NE(second.ptr, first.ptr);
+
+  gate.open = true;
+  ASSERT_EQ(hipStreamSynchronize(stream_), hipSuccess);
+
+  // Sizes are rounded up, so a slightly larger request fits the first buffer once it is idle
+  hipdnn_ep::PinnedBufferPool::Buffer third;
+  ASSERT_EQ(pool_.Acquire(8192, third), hipSuccess);
+  EXPECT_EQ(third.ptr, first.ptr);
+  EXPECT_EQ(pool_.AllocatedBytes(), first.size + second.size);
+
+  ASSERT_EQ(pool_.Release(second, stream_), hipSuccess);
+  ASSERT_EQ(pool_.Release(third, stream_), hipSuccess);
+}
+
+TEST_F(PinnedBufferPoolTest, IdleCacheIsTrimmedOldestFirst) {
+  // Three buffers together exceed the 256 MiB the pool keeps idle
+  constexpr size_t kSize = size_t{96} << 20;
+  hipdnn_ep::PinnedBufferPool::Buffer buffers[3];
+  for (auto& buffer : buffers) {
+    ASSERT_EQ(pool_.Acquire(kSize, buffer), hipSuccess);
+  }
+  EXPECT_EQ(pool_.AllocatedBytes(), 3 * kSize);
+
+  StreamGate gate;
+  ASSERT_EQ(hipLaunchHostFunc(stream_, StreamGate::Wait, &gate), hipSuccess);
+  ASSERT_EQ(pool_.Release(buffers[0], stream_), hipSuccess);
+
+  // The next release trims the oldest idle buffer, and freeing it waits for the gated stream
+  std::atomic<bool> released{false};
+  std::thread releaser([&] {
+    EXPECT_EQ(pool_.Release(buffers[1], stream_), hipSuccess);
+    released = true;
+  });
+
+  // Meanwhile the pool stays usable from other threads
+  auto trimmed = std::async(std::launch::async, [&] {
+    while (pool_.AllocatedBytes() != 2 * kSize) {
+      std::this_thread::yield();
+    }
+  });
+  EXPECT_EQ(trimmed.wait_for(std::chrono::seconds(5)), std::future_status::ready)
+      << "Pool was locked while a trimmed buffer waited for its stream";
+  EXPECT_FALSE(released);
+
+  gate.open = true;
+  releaser.join();
+  trimmed.wait();
+  ASSERT_EQ(pool_.Release(buffers[2], stream_), hipSuccess);
+  EXPECT_EQ(pool_.AllocatedBytes(), 2 * kSize);
+  ASSERT_EQ(hipStreamSynchronize(stream_), hipSuccess);
+
+  // The cached buffers are the two newest ones
+  hipdnn_ep::PinnedBufferPool::Buffer reused[2];
+  for (auto& buffer : reused) {
+    ASSERT_EQ(pool_.Acquire(kSize, buffer), hipSuccess);
+    EXPECT_NE(buffer.ptr, buffers[0].ptr);
+  }
+  EXPECT_EQ(pool_.AllocatedBytes(), 2 * kSize);
+  for (auto& buffer : reused) {
+    ASSERT_EQ(pool_.Release(buffer, stream_), hipSuccess);
+  }
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2024, hipDNN EP Authors. All rights reserved.
+// Licensed under the MIT License.
+
+// Standalone WorkspaceArena tests: buffer reuse per stream and growth when a kernel needs more
+
+#include <gtest/gtest.h>
+#include <hip/hip_runtime.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include "hipdnn_ep/workspace_arena.h"
+
+namespace {
+
+// Host function that holds up its stream until `open` is set
+struct StreamGate {
+  std::atomic<bool> reached{false};
+  std::atomic<bool> open{false};
+
+  static void Wait(void* data) {
+    auto* gate = static_cast<StreamGate*>(data);
+    gate->reached = true;
+    while (!gate->open) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+class WorkspaceArenaTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int device_count = 0;
+    if (hipGetDeviceCount(&device_count) != hipSuccess || device_count == 0) {
+      GTEST_SKIP() << "No HIP device found";
+    }
+    ASSERT_EQ(hipStreamCreateWithFlags(&stream_, hipStreamNonBlocking), hipSuccess);
+    ASSERT_EQ(hipStreamCreateWithFlags(&other_stream_, hipStreamNonBlocking), hipSuccess);
+  }
+
+  void TearDown() override {
+    arena_.reset();
+    if (stream_ != nullptr) {
+      hipStreamDestroy(stream_);
+    }
+    if (other_stream_ != nullptr) {
+      hipStreamDestroy(other_stream_);
+    }
+  }
+
+  std::unique_ptr<hipdnn_ep::WorkspaceArena> arena_ = std::make_unique<hipdnn_ep::WorkspaceArena>();
+  hipStream_t stream_{nullptr};
+  hipStream_t other_stream_{nullptr};
+};
+
+}  // namespace
+
+TEST_F(WorkspaceArenaTest, ReleasedBufferIsReusedOnSameStream) {
+  void* first = nullptr;
+  {
+    hipdnn_ep::WorkspaceArena::Lease lease;
+    ASSERT_EQ(arena_->Acquire(stream_, 4096, lease), hipSuccess);
+    first = lease.Get();
+    ASSERT_NE(first, nullptr);
+  }
+
+  // Smaller requests fit the returned buffer, so nothing new is allocated
+  hipdnn_ep::WorkspaceArena::Lease lease;
+  ASSERT_EQ(arena_->Acquire(stream_, 1024, lease), hipSuccess);
+  EXPECT_EQ(lease.Get(), first);
+  EXPECT_EQ(arena_->AllocatedBytes(), 4096u);
+}
+
+TEST_F(WorkspaceArenaTest, LeasesAreExclusive) {
+  hipdnn_ep::WorkspaceArena::Lease first;
+  hipdnn_ep::WorkspaceArena::Lease second;
+  ASSERT_EQ(arena_->Acquire(stream_, 4096, first), hipSuccess);
+  ASSERT_EQ(arena_->Acquire(stream_, 4096, second), hipSuccess);
+  EXPECT_NE(first.Get(), second.Get());
+  EXPECT_EQ(arena_->AllocatedBytes(), 8192u);
+
+  // A buffer returned on one stream is not handed to another one
+  void* first_ptr = first.Get();
+  first = hipdnn_ep::WorkspaceArena::Lease();
+  hipdnn_ep::WorkspaceArena::Lease other;
+  ASSERT_EQ(arena_->Acquire(other_stream_, 4096, other), hipSuccess);
+  EXPECT_NE(other.Get(), first_ptr);
+  EXPECT_EQ(arena_->AllocatedBytes(), 12288u);
+}
+
+TEST_F(WorkspaceArenaTest, ReserveSizesFirstAllocation) {
+  arena_->Reserve(1 << 20);
+  arena_->Reserve(4096);  // Keeps the largest requirement
+
+  hipdnn_ep::WorkspaceArena::Lease lease;
+  ASSERT_EQ(arena_->Acquire(stream_, 16, lease), hipSuccess);
+  EXPECT_EQ(arena_->AllocatedBytes(), size_t{1} << 20);
+}
+
+TEST_F(WorkspaceArenaTest, GrowsByReplacingTooSmallBuffer) {
+  {
+    hipdnn_ep::WorkspaceArena::Lease lease;
+    ASSERT_EQ(arena_->Acquire(stream_, 4096, lease), hipSuccess);
+  }
+
+  // Work enqueued before the growth may still use the small buffer
+  StreamGate gate;
+  ASSERT_EQ(hipLaunchHostFunc(stream_, StreamGate::Wait, &gate), hipSuccess);
+
+  // The free buffer is too small, so it is replaced rather than kept next to the larger one. Growing must
+  // not wait for the stream; the small buffer stays allocated until the work before it completes.
+  hipdnn_ep::WorkspaceArena::Lease lease;
+  auto grow = std::async(std::launch::async, [&] { return arena_->Acquire(stream_, 65536, lease); });
+  const bool grew_without_waiting = grow.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+  gate.open = true;
+  ASSERT_TRUE(grew_without_waiting) << "Growing the workspace waited for the stream";
+  ASSERT_EQ(grow.get(), hipSuccess);
+  EXPECT_EQ(arena_->AllocatedBytes(), 4096u + 65536u);
+  ASSERT_NE(lease.Get(), nullptr);
+
+  // Memory is writable for the requested size on the lease's stream
+  EXPECT_EQ(hipMemsetAsync(lease.Get(), 0, 65536, stream_), hipSuccess);
+  EXPECT_EQ(hipStreamSynchronize(stream_), hipSuccess);
+
+  // Once the stream passed the fence, the next acquire frees the replaced buffer
+  void* large = lease.Get();
+  lease = hipdnn_ep::WorkspaceArena::Lease();
+  ASSERT_EQ(arena_->Acquire(stream_, 1024, lease), hipSuccess);
+  EXPECT_EQ(lease.Get(), large);
+  EXPECT_EQ(arena_->AllocatedBytes(), 65536u);
+}
+
+TEST_F(WorkspaceArenaTest, ZeroSizeNeedsNoBuffer) {
+  hipdnn_ep::WorkspaceArena::Lease lease;
+  ASSERT_EQ(arena_->Acquire(stream_, 0, lease), hipSuccess);
+  EXPECT_EQ(lease.Get(), nullptr);
+  EXPECT_EQ(arena_->AllocatedBytes(), 0u);
+}